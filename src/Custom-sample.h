@@ -287,6 +287,12 @@
 // #define FEATURE_AUTO_DARK_MODE           0                // 0 = Disable auto-dark mode
 // #define FEATURE_EXTENDED_TASK_VALUE_TYPES 0               // 0 = Disable extra task value types like 64 bit ints, double, etc. in Dummy tasks
 // #define FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE 0  // 0 = switch to float as floating point type for rules/formula processing.
+// #define FEATURE_RULES_COMPILER           0                // 0 = Disable pre-parsing rules files, always process rules from text.
+// #define FEATURE_RULES_CALCULATE_CACHE    0                // 0 = Disable caching compiled expressions for Calculate.
+// #define FEATURE_CONTROLLER_QUEUE_SPILL   0                // 0 = Disable storing controller queue elements on the file system when the queue is full.
+// #define FEATURE_TASKVALUE_SEND_ON_CHANGE 0                // 0 = Disable suppressing sends of unchanged task values to controllers.
+// #define FEATURE_COMPILED_TEMPLATES       0                // 0 = Disable caching compiled controller topics/payloads and display lines.
+// #define FEATURE_SYSVAR_CACHE             0                // 0 = Disable caching computed values of system variables like %ip% and %rssi%.
 
 //#define WEBPAGE_TEMPLATE_HIDE_HELP_BUTTON
 
@@ -37,6 +37,7 @@ bool CPlugin_002(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesExtCreds = true;
       proto.defaultPort  = 1883;
       proto.usesID       = true;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
@@ -23,6 +23,7 @@ bool CPlugin_004(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesPassword = true;
       proto.defaultPort  = 80;
       proto.usesID       = true;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
@@ -35,6 +36,12 @@ bool CPlugin_004(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_c004_delay_queue(event->ControllerIndex);
+      #if FEATURE_CONTROLLER_QUEUE_SPILL
+
+      if (success) {
+        C004_DelayHandler->initSpillToFlash(event->ControllerIndex, C004_queue_element::deserialize);
+      }
+      #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
       break;
     }
 
@@ -103,7 +110,7 @@ bool do_process_c004_delay_queue(int controller_number, const Queue_element_base
 
   if (element.sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
     postDataStr += F("&status=");
-    postDataStr += element.txt[0]; // FIXME TD-er: Is this correct?
+    postDataStr += element.formatValue(0); // FIXME TD-er: Is this correct?
     // See: https://nl.mathworks.com/help/thingspeak/writedata.html
   } else {
     for (uint8_t x = 0; x < element.valueCount; x++)
@@ -111,7 +118,7 @@ bool do_process_c004_delay_queue(int controller_number, const Queue_element_base
       postDataStr += F("&field");
       postDataStr += element.idx + x;
       postDataStr += '=';
-      postDataStr += element.txt[x];
+      postDataStr += element.formatValue(x);
     }
   }
   if (!ControllerSettings.UseDNS) {
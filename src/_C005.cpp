@@ -19,6 +19,10 @@ String CPlugin_005_pubname;
 bool   CPlugin_005_mqtt_retainFlag = false;
 
 bool C005_parse_command(struct EventStruct *event);
+bool C005_publish_aggregated(struct EventStruct *event,
+                             String           && pubname,
+                             uint8_t             valueCount,
+                             bool                mqtt_retainFlag);
 
 bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String& string)
 {
@@ -36,6 +40,8 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesExtCreds = true;
       proto.defaultPort  = 1883;
       proto.usesID       = false;
+      proto.allowsAggregateValues = true;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
@@ -88,6 +94,11 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
 
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
 
+      if ((MQTTDelayHandler != nullptr) && MQTTDelayHandler->aggregate_values) {
+        success = C005_publish_aggregated(event, std::move(pubname), valueCount, mqtt_retainFlag);
+        break;
+      }
+
       for (uint8_t x = 0; x < valueCount; x++)
       {
         // MFD: skip publishing for values with empty labels (removes unnecessary publishing of unwanted values)
@@ -140,6 +151,57 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
   return success;
 }
 
+// Publish all values of the task as a single JSON object, like {"Temperature":21.5,"Humidity":48}
+// The %valname% part of the topic is left out, as the value names are part of the payload.
+bool C005_publish_aggregated(struct EventStruct *event,
+                             String           && pubname,
+                             uint8_t             valueCount,
+                             bool                mqtt_retainFlag) {
+  pubname.replace(F("/%valname%"), EMPTY_STRING);
+  pubname.replace(F("%valname%"),  EMPTY_STRING);
+
+  const bool isString = event->sensorType == Sensor_VType::SENSOR_TYPE_STRING;
+  String     payload;
+
+  payload.reserve(valueCount * 24 + 2);
+  payload += '{';
+
+  for (uint8_t x = 0; x < valueCount; x++)
+  {
+    const String valueName = getTaskValueName(event->TaskIndex, x);
+
+    if (valueName.isEmpty()) {
+      continue; // we skip values with empty labels
+    }
+
+    if (payload.length() > 1) {
+      payload += ',';
+    }
+    payload += to_json_object_value(
+      valueName,
+      isString ? event->String2 : formatUserVarNoCheck(event, x),
+      isString);
+  }
+  payload += '}';
+
+  if (payload.length() <= 2) {
+    // No value has a label
+    return false;
+  }
+# ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log = F("MQTT : ");
+    log += pubname;
+    log += ' ';
+    log += payload;
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+# endif // ifndef BUILD_NO_DEBUG
+
+  return MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(pubname), std::move(payload), mqtt_retainFlag);
+}
+
 bool C005_parse_command(struct EventStruct *event) {
   // FIXME TD-er: Command is not parsed for template arguments.
 
@@ -36,6 +36,7 @@ bool CPlugin_006(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesExtCreds = true;
       proto.defaultPort  = 1883;
       proto.usesID       = false;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
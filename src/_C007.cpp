@@ -26,6 +26,7 @@ bool CPlugin_007(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesPassword = true;
       proto.defaultPort  = 80;
       proto.usesID       = true;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
@@ -38,6 +39,12 @@ bool CPlugin_007(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_c007_delay_queue(event->ControllerIndex);
+      #if FEATURE_CONTROLLER_QUEUE_SPILL
+
+      if (success) {
+        C007_DelayHandler->initSpillToFlash(event->ControllerIndex, C007_queue_element::deserialize);
+      }
+      #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
       break;
     }
 
@@ -103,7 +110,7 @@ bool do_process_c007_delay_queue(int controller_number, const Queue_element_base
     url += F("field");
     url += element.idx + i;
     url += ':';
-    url += element.txt[i];
+    url += element.formatValue(i);
   }
   url += '}';
   url += F("&apikey=");
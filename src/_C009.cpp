@@ -52,6 +52,7 @@ bool CPlugin_009(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesExtCreds = true;
       proto.usesID       = false;
       proto.defaultPort  = 8383;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
@@ -64,6 +65,12 @@ bool CPlugin_009(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_c009_delay_queue(event->ControllerIndex);
+      #if FEATURE_CONTROLLER_QUEUE_SPILL
+
+      if (success) {
+        C009_DelayHandler->initSpillToFlash(event->ControllerIndex, C009_queue_element::deserialize);
+      }
+      #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
       break;
     }
 
@@ -185,7 +192,7 @@ bool do_process_c009_delay_queue(int controller_number, const Queue_element_base
               jsonString += ',';
               jsonString += to_json_object_value(F("type"), String(static_cast<int>(element.sensorType)));
               jsonString += ',';
-              jsonString += to_json_object_value(F("value"), element.txt[x]);
+              jsonString += to_json_object_value(F("value"), element.formatValue(x));
             }
             jsonString += '}'; // End "sensor value N"
           }
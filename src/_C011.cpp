@@ -16,6 +16,9 @@
 
 
 bool C011_sendBinary = false;
+ControllerSettingsStruct::BatchFraming_e C011_batchFraming = ControllerSettingsStruct::BatchFraming_e::None;
+uint16_t C011_batchMaxSize = CONTROLLER_BATCH_MAX_SIZE_DFLT;
+uint16_t C011_batchMaxAge  = CONTROLLER_BATCH_MAX_AGE_DFLT;
 
 struct C011_ConfigStruct
 {
@@ -36,6 +39,8 @@ struct C011_ConfigStruct
 // Forward declarations
 bool load_C011_ConfigStruct(controllerIndex_t ControllerIndex, String& HttpMethod, String& HttpUri, String& HttpHeader, String& HttpBody);
 boolean Create_schedule_HTTP_C011(struct EventStruct *event);
+boolean Create_schedule_HTTP_C011_batch(struct EventStruct *event);
+bool AppendToBatch_C011(const C011_queue_element& element);
 void DeleteNotNeededValues(String& s, uint8_t numberOfValuesWanted);
 void ReplaceTokenByValue(String& s, struct EventStruct *event, bool sendBinary);
 
@@ -72,7 +77,10 @@ bool CPlugin_011(CPlugin::Function function, struct EventStruct *event, String&
 
         if (AllocatedControllerSettings()) {
           LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
-          C011_sendBinary = ControllerSettings->sendBinary();
+          C011_sendBinary   = ControllerSettings->sendBinary();
+          C011_batchFraming = ControllerSettings->batchFraming();
+          C011_batchMaxSize = ControllerSettings->getBatchMaxSize();
+          C011_batchMaxAge  = ControllerSettings->getBatchMaxAge();
         }
       }
       success = init_c011_delay_queue(event->ControllerIndex);
@@ -131,6 +139,9 @@ bool CPlugin_011(CPlugin::Function function, struct EventStruct *event, String&
           LoadControllerSettings(event->ControllerIndex, *ControllerSettings);
           addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_SEND_BINARY);
           addFormNote(F("Do not 'percent escape' body when send binary checked"));
+          addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_BATCH_FRAMING);
+          addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_BATCH_MAX_SIZE);
+          addControllerParameterForm(*ControllerSettings, event->ControllerIndex, ControllerSettingsStruct::CONTROLLER_BATCH_MAX_AGE);
         }
       }
       break;
@@ -261,6 +272,10 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
   }
   //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
 
+  if (C011_batchFraming != ControllerSettingsStruct::BatchFraming_e::None) {
+    return Create_schedule_HTTP_C011_batch(event);
+  }
+
   // Add a new element to the queue with the minimal payload
   std::unique_ptr<C011_queue_element> element(new C011_queue_element(event));
   bool success = C011_DelayHandler->addToQueue(std::move(element));
@@ -282,7 +297,7 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
         log += element.postStr;
         addLogMove(LOG_LEVEL_ERROR, log);
       }
-      C011_DelayHandler->sendQueue.pop_back();
+      C011_DelayHandler->dropBack();
       return false;
     }
 
@@ -301,6 +316,100 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
   return success;
 }
 
+// ********************************************************************************
+// Create request, collecting the bodies of several messages in a single request
+// ********************************************************************************
+boolean Create_schedule_HTTP_C011_batch(struct EventStruct *event)
+{
+  std::unique_ptr<C011_queue_element> element(new (std::nothrow) C011_queue_element(event));
+
+  if (!element ||
+      !load_C011_ConfigStruct(event->ControllerIndex, element->HttpMethod, element->uri, element->header, element->postStr))
+  {
+    addLog(LOG_LEVEL_ERROR, F("C011  : Could not create request"));
+    return false;
+  }
+
+  ReplaceTokenByValue(element->uri,    event, false);
+  ReplaceTokenByValue(element->header, event, false);
+
+  bool success = false;
+
+  if (element->postStr.length() > 0)
+  {
+    ReplaceTokenByValue(element->postStr, event, C011_sendBinary);
+    success = AppendToBatch_C011(*element);
+
+    if (!success) {
+      // Start a new batch
+      if (C011_batchFraming == ControllerSettingsStruct::BatchFraming_e::JSONArray) {
+        String batch;
+        batch.reserve(element->postStr.length() + 2);
+        batch += '[';
+        batch += element->postStr;
+        batch += ']';
+        element->postStr = std::move(batch);
+      }
+      element->holdUntil = millis() + C011_batchMaxAge;
+
+      if (element->holdUntil == 0) { element->holdUntil = 1; }
+    }
+  }
+
+  if (!success) {
+    success = C011_DelayHandler->addToQueue(std::move(element));
+
+    if (!success) {
+      addLog(LOG_LEVEL_ERROR, F("C011  : Could not add to delay handler"));
+    }
+  }
+
+  Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C011_DELAY_QUEUE, C011_DelayHandler->getNextScheduleTime());
+  return success;
+}
+
+// Try to append the body of the element to the last queued request.
+// Return false when a new request has to be queued.
+bool AppendToBatch_C011(const C011_queue_element& element)
+{
+  if (C011_DelayHandler->sendQueue.empty()) {
+    return false;
+  }
+  C011_queue_element& last = static_cast<C011_queue_element&>(*(C011_DelayHandler->sendQueue.back()));
+
+  if (last.holdUntil == 0) {
+    // Last request is already complete
+    return false;
+  }
+
+  const size_t newLength = last.postStr.length() + 1 + element.postStr.length();
+
+  if ((newLength > C011_batchMaxSize) ||
+      !last.HttpMethod.equals(element.HttpMethod) ||
+      !last.uri.equals(element.uri) ||
+      !last.header.equals(element.header)) {
+    // Send the last request as it is.
+    last.holdUntil = 0;
+    return false;
+  }
+
+  if (C011_batchFraming == ControllerSettingsStruct::BatchFraming_e::JSONArray) {
+    // Replace the closing ']'
+    last.postStr.setCharAt(last.postStr.length() - 1, ',');
+    last.postStr += element.postStr;
+    last.postStr += ']';
+  } else {
+    last.postStr += '\n';
+    last.postStr += element.postStr;
+  }
+
+  if ((newLength + 1 + element.postStr.length()) > C011_batchMaxSize) {
+    // Another message of the same size will not fit, no need to wait any longer.
+    last.holdUntil = 0;
+  }
+  return true;
+}
+
 // parses the string and returns only the the number of name/values we want
 // according to the parameter numberOfValuesWanted
 void DeleteNotNeededValues(String& s, uint8_t numberOfValuesWanted)
@@ -9,9 +9,12 @@
 # include "src/Globals/Nodes.h"
 # include "src/DataStructs/C013_p2p_dataStructs.h"
 # include "src/ESPEasyCore/ESPEasyRules.h"
+# include "src/Helpers/CRC_functions.h"
 # include "src/Helpers/Misc.h"
 # include "src/Helpers/Network.h"
 
+# include <map>
+
 // #######################################################################################################
 // ########################### Controller Plugin 013: ESPEasy P2P network ################################
 // #######################################################################################################
@@ -22,17 +25,36 @@
 
 WiFiUDP C013_portUDP;
 
+// Task values to be sent to nodes supporting version 2 sensor data frames
+C013_SensorDataFrame C013_dataFrame;
+uint16_t C013_sequenceNr = 0;
+
+// Last received sequence number per unit
+std::map<uint8_t, uint16_t> C013_receivedSequenceNr;
+uint32_t C013_lostFrames = 0;
+
+// Checksum of the last sent task info, to only send it when changed
+std::map<taskIndex_t, uint32_t> C013_taskInfoChecksum;
+
+// Nodes change count at the last time the task info was sent to all nodes
+uint32_t C013_nodesChangeCount = 0;
+
 // Forward declarations
 void C013_SendUDPTaskInfo(uint8_t destUnit,
                           uint8_t sourceTaskIndex,
-                          uint8_t destTaskIndex);
+                          uint8_t destTaskIndex,
+                          bool    force);
+void C013_SendUDPTaskInfoOnNodesChange(controllerIndex_t ControllerIndex);
 void C013_SendUDPTaskData(struct EventStruct *event,
                           uint8_t             destUnit,
                           uint8_t             destTaskIndex);
+void C013_FlushUDPTaskData();
 void C013_sendUDP(uint8_t        unit,
                   const uint8_t *data,
-                  uint8_t        size);
+                  size_t         size);
 void C013_Receive(struct EventStruct *event);
+void C013_ReceiveDataFrame(struct EventStruct *event);
+void C013_ProcessSensorData(const C013_SensorDataStruct& dataReply);
 
 
 bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String& string)
@@ -63,7 +85,8 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
 
     case CPlugin::Function::CPLUGIN_TASK_CHANGE_NOTIFICATION:
     {
-      C013_SendUDPTaskInfo(0, event->TaskIndex, event->TaskIndex);
+      // Task settings were saved, always send the task info.
+      C013_SendUDPTaskInfo(0, event->TaskIndex, event->TaskIndex, true);
       break;
     }
 
@@ -80,6 +103,22 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
+    case CPlugin::Function::CPLUGIN_TEN_PER_SECOND:
+    {
+      // Send the values of all tasks run since the last call in a single frame
+      C013_FlushUDPTaskData();
+      C013_SendUDPTaskInfoOnNodesChange(event->ControllerIndex);
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_EXIT:
+    {
+      C013_dataFrame.clear();
+      C013_taskInfoChecksum.clear();
+      C013_receivedSequenceNr.clear();
+      break;
+    }
+
     case CPlugin::Function::CPLUGIN_WEBFORM_SHOW_HOST_CONFIG:
     {
       string = F("-");
@@ -104,7 +143,7 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
 // ********************************************************************************
 // Generic UDP message
 // ********************************************************************************
-void C013_SendUDPTaskInfo(uint8_t destUnit, uint8_t sourceTaskIndex, uint8_t destTaskIndex)
+void C013_SendUDPTaskInfo(uint8_t destUnit, uint8_t sourceTaskIndex, uint8_t destTaskIndex, bool force)
 {
   if (!NetworkConnected(10)) {
     return;
@@ -136,6 +175,21 @@ void C013_SendUDPTaskInfo(uint8_t destUnit, uint8_t sourceTaskIndex, uint8_t des
     infoReply.destUnit = destUnit;
     C013_sendUDP(destUnit, reinterpret_cast<const uint8_t *>(&infoReply), sizeof(C013_SensorInfoStruct));
   } else {
+    // Only send the task info when it has changed or nodes have been added since it was last sent.
+    std::vector<uint8_t> checksumData(reinterpret_cast<const uint8_t *>(&infoReply),
+                                      reinterpret_cast<const uint8_t *>(&infoReply) + sizeof(C013_SensorInfoStruct));
+
+    for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+      checksumData.push_back(it->first);
+    }
+    const uint32_t checksum = calc_CRC32(&checksumData[0], checksumData.size());
+    auto it_checksum        = C013_taskInfoChecksum.find(sourceTaskIndex);
+
+    if (!force && (it_checksum != C013_taskInfoChecksum.end()) && (it_checksum->second == checksum)) {
+      return;
+    }
+    C013_taskInfoChecksum[sourceTaskIndex] = checksum;
+
     for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
       if (it->first != Settings.Unit) {
         infoReply.destUnit = it->first;
@@ -145,6 +199,28 @@ void C013_SendUDPTaskInfo(uint8_t destUnit, uint8_t sourceTaskIndex, uint8_t des
   }
 }
 
+// Send the task info of all tasks using this controller when a node was added or has rebooted.
+void C013_SendUDPTaskInfoOnNodesChange(controllerIndex_t ControllerIndex)
+{
+  if ((Nodes.getNodesChangeCount() == C013_nodesChangeCount) || !NetworkConnected(10)) {
+    return;
+  }
+  C013_nodesChangeCount = Nodes.getNodesChangeCount();
+
+  // A rebooted node may not have kept the task info, so the checksums are no longer valid.
+  C013_taskInfoChecksum.clear();
+
+  // Forget the sequence numbers, so units no longer present are not kept forever.
+  // The next frame of each unit will start tracking lost frames again.
+  C013_receivedSequenceNr.clear();
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (Settings.TaskDeviceEnabled[taskIndex] && Settings.TaskDeviceSendData[ControllerIndex][taskIndex]) {
+      C013_SendUDPTaskInfo(0, taskIndex, taskIndex, false);
+    }
+  }
+}
+
 void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t destTaskIndex)
 {
   if (!NetworkConnected(10)) {
@@ -175,19 +251,62 @@ void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t d
     dataReply.destUnit = destUnit;
     C013_sendUDP(destUnit, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
   } else {
+    bool framedNodes = false;
+
     for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
       if (it->first != Settings.Unit) {
-        dataReply.destUnit = it->first;
-        C013_sendUDP(it->first, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
+        if (it->second.hasP2PFeature(NODE_P2P_FEATURE_C013_V2)) {
+          // Will be sent batched with other tasks
+          framedNodes = true;
+        } else {
+          dataReply.destUnit = it->first;
+          C013_sendUDP(it->first, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
+        }
+      }
+    }
+
+    if (framedNodes) {
+      if (!C013_dataFrame.add(dataReply.sourceTaskIndex, dataReply.deviceNumber, dataReply.sensorType, dataReply.values)) {
+        // Frame is full
+        C013_FlushUDPTaskData();
+        C013_dataFrame.add(dataReply.sourceTaskIndex, dataReply.deviceNumber, dataReply.sensorType, dataReply.values);
       }
     }
   }
 }
 
+void C013_FlushUDPTaskData()
+{
+  if (C013_dataFrame.empty()) {
+    return;
+  }
+  uint8_t destUnit   = 0;
+  uint8_t nodesCount = 0;
+
+  for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+    if ((it->first != Settings.Unit) && it->second.hasP2PFeature(NODE_P2P_FEATURE_C013_V2)) {
+      destUnit = it->first;
+      ++nodesCount;
+    }
+  }
+
+  if (nodesCount > 1) {
+    // Use a single broadcast instead of sending the same frame to each node.
+    destUnit = 255;
+  }
+
+  if (nodesCount > 0) {
+    const std::vector<uint8_t>& frame = C013_dataFrame.finalize(Settings.Unit, destUnit, C013_sequenceNr);
+    ++C013_sequenceNr;
+    C013_sendUDP(destUnit, &frame[0], frame.size());
+  }
+  C013_dataFrame.clear();
+}
+
 /*********************************************************************************************\
    Send UDP message (unit 255=broadcast)
 \*********************************************************************************************/
-void C013_sendUDP(uint8_t unit, const uint8_t *data, uint8_t size)
+void C013_sendUDP(uint8_t unit, const uint8_t *data, size_t size)
 {
   if (!NetworkConnected(10)) {
     return;
@@ -298,52 +417,113 @@ void C013_Receive(struct EventStruct *event) {
       if (event->Par2 < structSize) { structSize = event->Par2; }
       memcpy(reinterpret_cast<uint8_t *>(&dataReply), event->Data, structSize);
 
-      // FIXME TD-er: We should check for sensorType and pluginID on both sides.
-      // For example sending different sensor type data from one dummy to another is probably not going to work well
-      if (dataReply.isValid()) {
-        // only if this task has a remote feed, update values
-        const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
+      C013_ProcessSensorData(dataReply);
+      break;
+    }
 
-        if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
-        {
-          if (!dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
-            // Mismatch in plugin ID from sending node
-            if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-              String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
-              log += concat(F(" from unit "), dataReply.sourceUnit);
-              log += concat(F(" remote: "), dataReply.deviceNumber.value);
-              log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
-              addLogMove(LOG_LEVEL_ERROR, log);
-            }
-          } else {
-            struct EventStruct TempEvent(dataReply.destTaskIndex);
-            TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
-
-            const Sensor_VType sensorType = TempEvent.getSensorType();
-
-            if (dataReply.matchesSensorType(sensorType)) {
-              TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(dataReply.destTaskIndex);
-
-              if (taskValues != nullptr) {
-                for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x)
-                {
-                  taskValues->copyValue(dataReply.values, x, sensorType);
-                }
-              }
-
-              SensorSendTask(&TempEvent);
-            } else {
-              // Mismatch in sensor types
-              if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-                String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
-                log += concat(F(" from unit "), dataReply.sourceUnit);
-                addLogMove(LOG_LEVEL_ERROR, log);
-              }
+    case 6: // sensor data of several tasks
+    {
+      C013_ReceiveDataFrame(event);
+      break;
+    }
+  }
+}
+
+void C013_ReceiveDataFrame(struct EventStruct *event)
+{
+  uint8_t  sourceUnit = 0;
+  uint8_t  destUnit   = 0;
+  uint16_t sequenceNr = 0;
+  uint8_t  count      = 0;
+
+  if (!C013_SensorDataFrame::parseHeader(event->Data, event->Par2, sourceUnit, destUnit, sequenceNr, count)) {
+    return;
+  }
+
+  if ((sourceUnit == Settings.Unit) || ((destUnit != 255) && (destUnit != Settings.Unit))) {
+    return;
+  }
+
+  auto it = C013_receivedSequenceNr.find(sourceUnit);
+
+  if (it != C013_receivedSequenceNr.end()) {
+    const uint16_t lost = sequenceNr - static_cast<uint16_t>(it->second + 1);
+
+    // Large gap is most likely a reboot of the sending node, or a frame received out of order.
+    if ((lost != 0) && (lost < 0x8000)) {
+      C013_lostFrames += lost;
+# ifndef BUILD_NO_DEBUG
+
+      if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+        String log = concat(F("P2P data : Lost "), lost);
+        log += concat(F(" frames from unit "), sourceUnit);
+        log += concat(F(", total lost: "), C013_lostFrames);
+        addLogMove(LOG_LEVEL_DEBUG, log);
+      }
+# endif // ifndef BUILD_NO_DEBUG
+    }
+  }
+  C013_receivedSequenceNr[sourceUnit] = sequenceNr;
+
+  size_t pos = C013_V2_HEADER_SIZE;
+
+  for (uint8_t i = 0; i < count; ++i) {
+    struct C013_SensorDataStruct dataReply;
+    dataReply.sourceUnit = sourceUnit;
+    dataReply.destUnit   = Settings.Unit;
+
+    if (!C013_SensorDataFrame::parseRecord(event->Data, event->Par2, pos, dataReply)) {
+      return;
+    }
+    C013_ProcessSensorData(dataReply);
+  }
+}
+
+void C013_ProcessSensorData(const C013_SensorDataStruct& dataReply)
+{
+  // FIXME TD-er: We should check for sensorType and pluginID on both sides.
+  // For example sending different sensor type data from one dummy to another is probably not going to work well
+  if (dataReply.isValid()) {
+    // only if this task has a remote feed, update values
+    const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
+
+    if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
+    {
+      if (!dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
+        // Mismatch in plugin ID from sending node
+        if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+          String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
+          log += concat(F(" from unit "), dataReply.sourceUnit);
+          log += concat(F(" remote: "), dataReply.deviceNumber.value);
+          log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
+          addLogMove(LOG_LEVEL_ERROR, log);
+        }
+      } else {
+        struct EventStruct TempEvent(dataReply.destTaskIndex);
+        TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
+
+        const Sensor_VType sensorType = TempEvent.getSensorType();
+
+        if (dataReply.matchesSensorType(sensorType)) {
+          TaskValues_Data_t *taskValues = UserVar.getTaskValues_Data(dataReply.destTaskIndex);
+
+          if (taskValues != nullptr) {
+            for (taskVarIndex_t x = 0; x < VARS_PER_TASK; ++x)
+            {
+              taskValues->copyValue(dataReply.values, x, sensorType);
             }
           }
+
+          SensorSendTask(&TempEvent);
+        } else {
+          // Mismatch in sensor types
+          if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+            String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
+            log += concat(F(" from unit "), dataReply.sourceUnit);
+            addLogMove(LOG_LEVEL_ERROR, log);
+          }
         }
       }
-      break;
     }
   }
 }
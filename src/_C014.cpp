@@ -189,6 +189,7 @@ bool CPlugin_014(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesExtCreds = true;
       proto.defaultPort  = 1883;
       proto.usesID       = false;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
@@ -37,6 +37,7 @@ bool CPlugin_017(CPlugin::Function function, struct EventStruct *event, String&
       proto.usesPassword = false;
       proto.usesID       = false;
       proto.defaultPort  = 10051;
+      proto.allowsSpillToFlash = true;
       break;
     }
 
@@ -49,6 +50,12 @@ bool CPlugin_017(CPlugin::Function function, struct EventStruct *event, String&
     case CPlugin::Function::CPLUGIN_INIT:
     {
       success = init_c017_delay_queue(event->ControllerIndex);
+      #if FEATURE_CONTROLLER_QUEUE_SPILL
+
+      if (success) {
+        C017_DelayHandler->initSpillToFlash(event->ControllerIndex, C017_queue_element::deserialize);
+      }
+      #endif // if FEATURE_CONTROLLER_QUEUE_SPILL
       break;
     }
 
@@ -128,7 +135,7 @@ bool do_process_c017_delay_queue(int controller_number, const Queue_element_base
       block[F("host")] = Settings.getName();     // Zabbix hostname, Unit Name for the ESP easy
       block[F("key")]  = taskValueName;              // Zabbix item key // Value Name for the ESP easy
       float value = 0.0f;
-      validFloatFromString(element.txt[i], value);
+      validFloatFromString(element.formatValue(i), value);
       block[F("value")] = value;                     // ESPeasy supports only floats
     }
     serializeJson(root, JSON_packet_content);
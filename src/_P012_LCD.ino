@@ -222,7 +222,7 @@ boolean Plugin_012(uint8_t function, struct EventStruct *event, String& string)
 
           if (tmpString.length())
           {
-            String newString = P012_data->P012_parseTemplate(tmpString, P012_data->Plugin_012_cols);
+            String newString = P012_data->P012_parseTemplate(tmpString, P012_data->Plugin_012_cols, event->TaskIndex);
             P012_data->lcdWrite(newString, 0, x);
           }
         }
@@ -54,6 +54,8 @@
 
 bool   MQTT_unsubscribe_037(struct EventStruct *event);
 bool   MQTTSubscribe_037(struct EventStruct *event);
+void   MQTTimport_register_037(struct EventStruct     *event,
+                               const P037_data_struct *P037_data);
 
 # if P037_MAPPING_SUPPORT || P037_JSON_SUPPORT
 String P037_getMQTTLastTopicPart(const String& topic) {
@@ -282,7 +284,11 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
       P037_data_struct *P037_data = static_cast<P037_data_struct *>(getPluginTaskData(event->TaskIndex));
 
+      MQTTimport_subscriptions.remove(event->TaskIndex);
+
       if ((nullptr != P037_data) && P037_data->loadSettings()) {
+        MQTTimport_register_037(event, P037_data);
+
         // When we edit the subscription data from the webserver, the plugin is called again with init.
         // In order to resubscribe we have to disconnect and reconnect in order to get rid of any obsolete subscriptions
         if (MQTTclient_connected) {
@@ -296,6 +302,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
     case PLUGIN_EXIT:
     {
+      MQTTimport_subscriptions.remove(event->TaskIndex);
       MQTT_unsubscribe_037(event);
       break;
     }
@@ -329,8 +336,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
     case PLUGIN_MQTT_IMPORT:
     {
       // Resolved tonhuisman: TD-er: It may be useful to generate events with string values.
-      // Get the payload and check it out
-      String Payload = event->String2;
+      // The same event is handed to all matching tasks, so only refer to the payload here.
+      const String& rawPayload = event->String2;
 
       # ifdef PLUGIN_037_DEBUG
 
@@ -338,7 +345,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
         String info = F("P037 : topic: ");
         info += event->String1;
         info += F(" value: ");
-        info += Payload;
+        info += rawPayload;
         addLog(LOG_LEVEL_INFO, info);
       }
       # endif // ifdef PLUGIN_037_DEBUG
@@ -349,41 +356,21 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
         return success;
       }
 
-      String unparsedPayload; // To keep an unprocessed copy
+      String Payload;
+      String unparsedPayload; // To keep an unprocessed copy of a json attribute
 
       bool checkJson = false;
 
       String subscriptionTopicParsed;
-      # if P037_MAPPING_SUPPORT || P037_FILTER_SUPPORT || P037_JSON_SUPPORT
-      bool processData = false;  // Don't do the for loop again if we're not going to match
-      // As we can receive quite a lot of topics not intended for this plugin,
-      // first do a quick check if the topic matches here, to try and avoid a bunch of unneeded mapping, filtering and logging
-      bool matchedTopic = false; // Ignore by default
       subscriptionTopicParsed.reserve(80);
 
-      for (uint8_t x = 0; x < VARS_PER_TASK; x++)
-      {
-        if (P037_data->mqttTopics[x].length() == 0) {
-          continue; // skip blank subscriptions
-        }
-
-        // Now check if the incoming topic matches one of our subscriptions
-        subscriptionTopicParsed = P037_data->getFullMQTTTopic(x);
-        parseSystemVariables(subscriptionTopicParsed, false);
-
-        if (MQTTCheckSubscription_037(event->String1, subscriptionTopicParsed)) {
-          matchedTopic = true; // Yes we should process it here
-          processData  = true; // Allow going into second for loop
-        }
-      }
-      # else // if P037_MAPPING_SUPPORT || P037_FILTER_SUPPORT || P037_JSON_SUPPORT
+      // PLUGIN_MQTT_IMPORT is only dispatched to tasks with a subscription matching the topic,
+      // see MQTTimport_subscriptions, so there is no need to check the topic again here.
       bool processData = true;
-      # endif // if P037_MAPPING_SUPPORT || P037_FILTER_SUPPORT || P037_JSON_SUPPORT
       # if P037_JSON_SUPPORT
 
-      if (matchedTopic &&
-          P037_PARSE_JSON &&
-          Payload.startsWith(F("{"))) { // With JSON enabled and rudimentary check for JSon content
+      if (P037_PARSE_JSON &&
+          rawPayload.startsWith(F("{"))) { // With JSON enabled and rudimentary check for JSon content
         #  ifdef PLUGIN_037_DEBUG
         addLog(LOG_LEVEL_INFO, F("IMPT : MQTT JSON data detected."));
         #  endif // ifdef PLUGIN_037_DEBUG
@@ -392,7 +379,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
       # endif           // if P037_JSON_SUPPORT
 
       if (!checkJson) { // Avoid storing any json in an extra copy in memory
-        unparsedPayload = event->String2;
+        Payload = rawPayload;
       }
 
       bool   continueProcessing = false;
@@ -400,7 +387,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
       # if P037_MAPPING_SUPPORT
 
-      if (matchedTopic && !checkJson && P037_APPLY_MAPPINGS) { // Apply mappings?
+      if (!checkJson && P037_APPLY_MAPPINGS) { // Apply mappings?
         key     = P037_getMQTTLastTopicPart(event->String1);
         Payload = P037_data->mapValue(Payload, key);
       }
@@ -409,21 +396,21 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
       # if P037_JSON_SUPPORT
 
       if (checkJson) {
-        continueProcessing = P037_data->parseJSONMessage(event->String2);
+        continueProcessing = P037_data->parseJSONMessage(rawPayload);
       }
       # endif // if P037_JSON_SUPPORT
 
       # if P037_FILTER_SUPPORT
       #  ifdef P037_FILTER_PER_TOPIC
 
-      for (uint8_t x = 0; x < VARS_PER_TASK && matchedTopic; x++) {
+      for (uint8_t x = 0; x < VARS_PER_TASK; x++) {
         if (P037_data->mqttTopics[x].length() == 0) {
           continue; // skip blank subscriptions
         }
       #  else // ifdef P037_FILTER_PER_TOPIC
       int8_t x = -1;
 
-      if (matchedTopic) {
+      {
       #  endif // P037_FILTER_PER_TOPIC
 
         // non-json filter check
@@ -443,9 +430,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
         // json filter check
         if (checkJson && P037_data->hasFilters()) { // See if we pass the filters for all json attributes
-          do {
-            key     = P037_data->iter->key().c_str();
-            Payload = P037_data->iter->value().as<String>();
+          while (processData && P037_data->nextJSONAttribute(key, Payload)) {
             #    if P037_MAPPING_SUPPORT
 
             if (P037_APPLY_MAPPINGS) {
@@ -453,16 +438,16 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
             }
             #    endif // if P037_MAPPING_SUPPORT
             processData = P037_data->checkFilters(key, Payload, x + 1); // Will return true unless key matches *and* Payload doesn't
-            ++P037_data->iter;
-          } while (processData && P037_data->iter != P037_data->doc.end());
+          }
+          P037_data->rewindJSON();
         }
         #   endif // P037_FILTER_PER_TOPIC
         #  endif  // if P037_JSON_SUPPORT
       }
       #  ifndef BUILD_NO_DEBUG
 
-      if (matchedTopic && P037_data->hasFilters() && // Single log statement
-          loglevelActiveFor(LOG_LEVEL_DEBUG)) {      // Reduce standard logging
+      if (P037_data->hasFilters() &&            // Single log statement
+          loglevelActiveFor(LOG_LEVEL_DEBUG)) { // Reduce standard logging
         String log = F("IMPT : MQTT filter result: ");
         log += processData ? F("true") : F("false");
         addLogMove(LOG_LEVEL_DEBUG, log);
@@ -472,7 +457,6 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
 
       if (!processData) { // Nothing to do? then clean up
         Payload.clear();
-        unparsedPayload.clear();
       }
 
       // Get the Topic and see if it matches any of the subscriptions
@@ -494,11 +478,9 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
           bool passFilter = true;
 
           if (checkJson && P037_data->hasFilters()) { // See if we pass the filters for all json attributes
-            P037_data->iter = P037_data->doc.begin();
+            P037_data->rewindJSON();
 
-            do {
-              key     = P037_data->iter->key().c_str();
-              Payload = P037_data->iter->value().as<String>();
+            while (passFilter && P037_data->nextJSONAttribute(key, Payload)) {
               #   if P037_MAPPING_SUPPORT
 
               if (P037_APPLY_MAPPINGS) {
@@ -506,10 +488,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
               }
               #   endif // if P037_MAPPING_SUPPORT
               passFilter = P037_data->checkFilters(key, Payload, x + 1); // Will return true unless key matches *and* Payload doesn't
-
-              ++P037_data->iter;
-            } while (passFilter && P037_data->iter != P037_data->doc.end());
-            P037_data->iter = P037_data->doc.begin();
+            }
+            P037_data->rewindJSON();
           }
 
           if (passFilter) // Watch it!
@@ -519,7 +499,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
             do {
               # if P037_JSON_SUPPORT
 
-              if (checkJson && (P037_data->iter != P037_data->doc.end())) {
+              if (checkJson && !P037_data->jsonAtEnd()) {
                 String jsonIndex     = parseString(P037_data->jsonAttributes[x], 2, ';');
                 String jsonAttribute = parseStringKeepCase(P037_data->jsonAttributes[x], 1, ';');
                 jsonAttribute.trim();
@@ -527,13 +507,8 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                 if (!jsonAttribute.isEmpty()) {
                   key = jsonAttribute;
 
-                  if (key.indexOf('.') > -1) {
-                    String part1 = parseStringKeepCase(key, 1, '.');
-                    String part2 = parseStringKeepCase(key, 2, '.');
-                    Payload = P037_data->doc[part1][part2].as<String>();
-                  } else {
-                    Payload = P037_data->doc[key].as<String>();
-                  }
+                  // Value was already extracted when reading the message, also for "object.member" attributes.
+                  Payload         = P037_data->getJSONAttributeValue(x);
                   unparsedPayload = Payload;
                   int8_t jIndex = jsonIndex.toInt();
 
@@ -558,10 +533,10 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                   }
                   #  endif // if !defined(P037_LIMIT_BUILD_SIZE) || defined(P037_OVERRIDE)
                   continueProcessing = false; // no need to loop over all attributes, the configured one is found
-                } else {
-                  key             = P037_data->iter->key().c_str();
-                  Payload         = P037_data->iter->value().as<String>();
+                } else if (P037_data->nextJSONAttribute(key, Payload)) {
                   unparsedPayload = Payload;
+                } else {
+                  key.clear();
                 }
                 #  ifdef PLUGIN_037_DEBUG
 
@@ -578,7 +553,6 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                   addLogMove(LOG_LEVEL_INFO, log);
                 }
                 #  endif // ifdef PLUGIN_037_DEBUG
-                ++P037_data->iter;
               }
               #  if P037_MAPPING_SUPPORT
 
@@ -624,7 +598,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                   RuleEvent += '#';
                   RuleEvent += event->String1;
                   RuleEvent += '=';
-                  RuleEvent += wrapWithQuotesIfContainsParameterSeparatorChar(unparsedPayload);
+                  RuleEvent += wrapWithQuotesIfContainsParameterSeparatorChar(rawPayload);
                   P037_addEventToQueue(event, RuleEvent);
                 }
 
@@ -692,7 +666,7 @@ boolean Plugin_037(uint8_t function, struct EventStruct *event, String& string)
                 }
                 # if P037_JSON_SUPPORT
 
-                if (checkJson && (P037_data->iter == P037_data->doc.end())) {
+                if (checkJson && P037_data->jsonAtEnd()) {
                   continueProcessing = false;
                 }
                 # endif // if P037_JSON_SUPPORT
@@ -825,6 +799,19 @@ bool MQTTSubscribe_037(struct EventStruct *event)
   return true;
 }
 
+// Add the subscriptions of this task to the index used to dispatch incoming MQTT messages
+void MQTTimport_register_037(struct EventStruct *event, const P037_data_struct *P037_data)
+{
+  for (uint8_t x = 0; x < VARS_PER_TASK; x++) {
+    String subscription = P037_data->getFullMQTTTopic(x);
+
+    if (!subscription.isEmpty()) {
+      parseSystemVariables(subscription, false);
+      MQTTimport_subscriptions.add(subscription, event->TaskIndex);
+    }
+  }
+}
+
 //
 // Check to see if Topic matches the MQTT subscription
 //
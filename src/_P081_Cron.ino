@@ -43,6 +43,7 @@ boolean Plugin_081(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional    = false;
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].DecimalsOnly     = true;
+      Device[deviceCount].FormatUserVar    = true;
       break;
     }
 
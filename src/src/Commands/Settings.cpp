@@ -18,6 +18,7 @@
 #include "../Helpers/MDNS_Helper.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/StringConverter.h"
+#include "../Helpers/SystemVariables.h"
 #include "../Helpers/StringGenerator_System.h"
 
 
@@ -35,6 +36,7 @@ String Command_Settings_Unit(struct EventStruct *event, const char* Line)
 {
 	if (HasArgv(Line, 2)) {
 	  Settings.Unit = event->Par1;
+	  SystemVariables::clearCache(); // %unit% and %sysname%
 	  update_mDNS();
 	} else {
       return return_result(event, concat(F("Unit:"), static_cast<int>(Settings.Unit)));
@@ -44,11 +46,13 @@ String Command_Settings_Unit(struct EventStruct *event, const char* Line)
 
 String Command_Settings_Name(struct EventStruct *event, const char* Line)
 {
-	return Command_GetORSetString(event, F("Name:"),
+	String result = Command_GetORSetString(event, F("Name:"),
 							Line,
 							Settings.Name,
 							sizeof(Settings.Name),
 							1);
+	SystemVariables::clearCache(); // %sysname%
+	return result;
 }
 
 String Command_Settings_Password(struct EventStruct *event, const char* Line)
@@ -45,12 +45,19 @@ public:
 
   size_t getSize() const;
 
+  unsigned long getHoldUntil() const {
+    return holdUntil;
+  }
+
   String uri;
   String HttpMethod;
   String header;
   String postStr;
   int idx                 = 0;
   Sensor_VType sensorType = Sensor_VType::SENSOR_TYPE_NONE;
+
+  // Set while more messages may be appended to postStr, see "Batch Framing" controller setting.
+  unsigned long holdUntil = 0;
 };
 
 #endif // USES_C011
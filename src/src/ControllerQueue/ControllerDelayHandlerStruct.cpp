@@ -11,7 +11,24 @@ ControllerDelayHandlerStruct::ControllerDelayHandlerStruct() :
   delete_oldest(false),
   must_check_reply(false),
   deduplicate(false),
-  useLocalSystemTime(false) {}
+  useLocalSystemTime(false),
+  max_batch_size(1),
+  aggregate_values(false),
+  max_queue_bytes(CONTROLLER_DELAY_QUEUE_MAX_BYTES),
+  adaptive_interval(false),
+  adaptiveTimeBetweenMessages(0),
+  smoothedRTT(0) {}
+
+ControllerDelayHandlerStruct::~ControllerDelayHandlerStruct() {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Spill files are kept, to be read back when the controller is started again.
+  if (spill != nullptr) {
+    delete spill;
+    spill = nullptr;
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+}
 
 bool ControllerDelayHandlerStruct::cacheControllerSettings(controllerIndex_t ControllerIndex)
 {
@@ -33,6 +50,19 @@ void ControllerDelayHandlerStruct::cacheControllerSettings(const ControllerSetti
   must_check_reply       = settings.MustCheckReply;
   deduplicate            = settings.deduplicate();
   useLocalSystemTime     = settings.useLocalSystemTime();
+  max_batch_size         = settings.mqtt_batchPublish() ? CONTROLLER_DELAY_QUEUE_BATCH_SIZE : 1;
+  aggregate_values       = settings.mqtt_aggregateValues();
+  max_queue_bytes        = settings.getMaxQueueSize();
+  adaptive_interval      = settings.adaptiveSendInterval();
+
+  if (!adaptive_interval) {
+    adaptiveTimeBetweenMessages = 0;
+    smoothedRTT                 = 0;
+  }
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  spill_enabled          = settings.spillToFlash();
+  updateSpill();
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
   if (settings.allowExpire()) {
     expire_timeout = max_queue_depth * max_retries * (minTimeBetweenMessages + settings.ClientTimeout);
@@ -62,6 +92,13 @@ bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& elem
     return false;
   }
 
+  const unsigned long holdUntil = element.getHoldUntil();
+
+  if ((holdUntil != 0) && (timePassedSince(holdUntil) < 0)) {
+    // Element is still collecting data
+    return false;
+  }
+
   if (getProtocolStruct(protocolIndex).needsNetwork) {
     return NetworkConnected(10);
   }
@@ -69,8 +106,77 @@ bool ControllerDelayHandlerStruct::readyToProcess(const Queue_element_base& elem
 }
 
 bool ControllerDelayHandlerStruct::queueFull(controllerIndex_t controller_idx) const {
+  if (!ramQueueFull(controller_idx)) {
+    return false;
+  }
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  if (spill != nullptr) {
+    // New elements can still be stored in the spill file,
+    // unless it has reached its max. size and old elements may not be deleted.
+    return !delete_oldest && (spill->getSize() >= CONTROLLER_QUEUE_SPILL_MAX_SIZE);
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+  return true;
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+void ControllerDelayHandlerStruct::initSpillToFlash(controllerIndex_t ControllerIndex, spill_deserialize_function deserialize) {
+  if (!spill_enabled && (spill == nullptr)) {
+    // Remove spill files which may be left from when the spill file was enabled.
+    ControllerQueueSpillStruct(ControllerIndex, deserialize).clear();
+  }
+  spill_controller_idx = ControllerIndex;
+  spill_deserialize    = deserialize;
+  updateSpill();
+}
+
+size_t ControllerDelayHandlerStruct::getSpillSize() const {
+  if (spill == nullptr) {
+    return 0;
+  }
+  return spill->getSize();
+}
+
+bool ControllerDelayHandlerStruct::spillIsEmpty() const {
+  return (spill == nullptr) || spill->isEmpty();
+}
+
+void ControllerDelayHandlerStruct::readFromSpill() {
+  if (spill == nullptr) {
+    return;
+  }
+
+  while (!spill->isEmpty() && !ramQueueFull(spill_controller_idx)) {
+    std::unique_ptr<Queue_element_base> element = spill->read();
+
+    if (!element) {
+      return;
+    }
+    pushBack(std::move(element));
+  }
+}
+
+void ControllerDelayHandlerStruct::updateSpill() {
+  if (spill_enabled && (spill_deserialize != nullptr) && validControllerIndex(spill_controller_idx)) {
+    if (spill == nullptr) {
+      spill = new (std::nothrow) ControllerQueueSpillStruct(spill_controller_idx, spill_deserialize);
+    }
+  } else if (spill != nullptr) {
+    // Disabled in the settings
+    spill->clear();
+    delete spill;
+    spill = nullptr;
+  }
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+bool ControllerDelayHandlerStruct::ramQueueFull(controllerIndex_t controller_idx) const {
   if (sendQueue.size() >= max_queue_depth) { return true; }
 
+  if ((max_queue_bytes != 0) && (getQueueMemorySize() >= max_queue_bytes)) { return true; }
+
   // Number of elements is not exceeding the limit, check memory
   int freeHeap = FreeMem();
   {
@@ -109,6 +215,57 @@ bool ControllerDelayHandlerStruct::queueFull(controllerIndex_t controller_idx) c
   return true;
 }
 
+void ControllerDelayHandlerStruct::dropFront() {
+  if (sendQueue.empty()) { return; }
+#if FEATURE_TIMING_STATS
+
+  if (sendQueue.front()) {
+    ControllerSendTimingStats *stats = getControllerSendTimingStats(sendQueue.front()->_controller_idx);
+
+    if (stats != nullptr) {
+      ++stats->drops;
+    }
+  }
+#endif // if FEATURE_TIMING_STATS
+  popFront();
+  attempt = 0;
+}
+
+void ControllerDelayHandlerStruct::dropBack() {
+  if (sendQueue.empty()) { return; }
+
+  if (sendQueue.size() > 1) {
+    // The element before the last one becomes the last one.
+    const Queue_element_base *newBack = std::prev(sendQueue.end(), 2)->get();
+
+    if (newBack != nullptr) {
+      queueMemorySize -= std::min(queueMemorySize, newBack->getSize());
+    }
+  }
+  sendQueue.pop_back();
+}
+
+void ControllerDelayHandlerStruct::pushBack(std::unique_ptr<Queue_element_base>element) {
+  if (!sendQueue.empty() && (sendQueue.back().get() != nullptr)) {
+    // The current last element will no longer change.
+    queueMemorySize += sendQueue.back()->getSize();
+  }
+  sendQueue.push_back(std::move(element));
+}
+
+void ControllerDelayHandlerStruct::popFront() {
+  if (sendQueue.empty()) { return; }
+
+  if (sendQueue.size() > 1) {
+    if (sendQueue.front().get() != nullptr) {
+      queueMemorySize -= std::min(queueMemorySize, sendQueue.front()->getSize());
+    }
+  } else {
+    queueMemorySize = 0;
+  }
+  sendQueue.pop_front();
+}
+
 // Return true if message is already present in the queue
 bool ControllerDelayHandlerStruct::isDuplicate(const Queue_element_base& element) const {
   // Some controllers may receive duplicate messages, due to lost acknowledgement
@@ -153,21 +310,38 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
   if (isDuplicate(*element)) {
     return true;
   }
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Once elements are spilled, new elements must be spilled too, to keep them in order.
+  if ((spill != nullptr) && (!spill->isEmpty() || ramQueueFull(element->_controller_idx))) {
+    if (spill->write(*element, delete_oldest)) {
+      return true;
+    }
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
   if (delete_oldest) {
     // Force add to the queue.
     // If max buffer is reached, the oldest in the queue (first to be served) will be removed.
-    while (queueFull(element->_controller_idx)) {
-      sendQueue.pop_front();
-      attempt = 0;
+    while (ramQueueFull(element->_controller_idx) && !sendQueue.empty()) {
+      dropFront();
     }
   }
 
-  if (!queueFull(element->_controller_idx)) {
-    sendQueue.push_back(std::move(element));
+  if (!ramQueueFull(element->_controller_idx)) {
+    pushBack(std::move(element));
 
     return true;
   }
+#if FEATURE_TIMING_STATS
+  {
+    ControllerSendTimingStats *stats = getControllerSendTimingStats(element->_controller_idx);
+
+    if (stats != nullptr) {
+      ++stats->drops;
+    }
+  }
+#endif // if FEATURE_TIMING_STATS
 #ifndef BUILD_NO_DEBUG
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -183,11 +357,14 @@ bool ControllerDelayHandlerStruct::addToQueue(std::unique_ptr<Queue_element_base
 // Get the next element.
 // Remove front element when max_retries is reached.
 Queue_element_base * ControllerDelayHandlerStruct::getNext() {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  readFromSpill();
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   if (sendQueue.empty()) { return nullptr; }
 
   if (attempt > max_retries) {
-    sendQueue.pop_front();
-    attempt = 0;
+    dropFront();
   }
 
   if (expire_timeout != 0) {
@@ -197,8 +374,7 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
       if ((sendQueue.front().get() != nullptr) && (timePassedSince(sendQueue.front()->_timestamp) < static_cast<long>(expire_timeout))) {
         done = true;
       } else {
-        sendQueue.pop_front();
-        attempt = 0;
+        dropFront();
       }
     }
   }
@@ -212,9 +388,26 @@ Queue_element_base * ControllerDelayHandlerStruct::getNext() {
 // @param remove_from_queue indicates whether the elements should be removed from the queue.
 unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue) {
   if (sendQueue.empty()) { return 0; }
+#if FEATURE_TIMING_STATS
+  {
+    const Queue_element_base  *element = sendQueue.front().get();
+    ControllerSendTimingStats *stats   = (element == nullptr)
+      ? nullptr
+      : getControllerSendTimingStats(element->_controller_idx);
+
+    if (stats != nullptr) {
+      if (remove_from_queue) {
+        stats->queueWait.add(timePassedSince(element->_timestamp));
+      } else {
+        ++stats->retries;
+      }
+      stats->interval = getTimeBetweenMessages();
+    }
+  }
+#endif // if FEATURE_TIMING_STATS
 
   if (remove_from_queue) {
-    sendQueue.pop_front();
+    popFront();
     attempt  = 0;
     lastSend = millis();
   } else {
@@ -224,18 +417,71 @@ unsigned long ControllerDelayHandlerStruct::markProcessed(bool remove_from_queue
 }
 
 unsigned long ControllerDelayHandlerStruct::getNextScheduleTime() const {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  if (sendQueue.empty() && spillIsEmpty()) { return 0; }
+#else // if FEATURE_CONTROLLER_QUEUE_SPILL
   if (sendQueue.empty()) { return 0; }
-  unsigned long nextTime = lastSend + minTimeBetweenMessages;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+  unsigned long nextTime = lastSend + getTimeBetweenMessages();
 
   if (timePassedSince(nextTime) > 0) {
     nextTime = millis();
   }
 
+  if (!sendQueue.empty()) {
+    const unsigned long holdUntil = sendQueue.front()->getHoldUntil();
+
+    if ((holdUntil != 0) && (timeDiff(nextTime, holdUntil) > 0)) {
+      nextTime = holdUntil;
+    }
+  }
+
   if (nextTime == 0) { nextTime = 1; // Just to make sure it will be executed
   }
   return nextTime;
 }
 
+unsigned int ControllerDelayHandlerStruct::getTimeBetweenMessages() const {
+  if (adaptive_interval && (adaptiveTimeBetweenMessages != 0)) {
+    return adaptiveTimeBetweenMessages;
+  }
+  return minTimeBetweenMessages;
+}
+
+void ControllerDelayHandlerStruct::updateAdaptiveInterval(bool success, unsigned long duration) {
+  if (adaptiveTimeBetweenMessages == 0) {
+    // Start from the configured interval
+    adaptiveTimeBetweenMessages = minTimeBetweenMessages;
+  }
+
+  // Sending takes considerably longer than usual, the receiving end may be getting overloaded.
+  const unsigned long averageRTT = smoothedRTT / 8;
+  const bool slowResponse        = (averageRTT != 0) && (duration > (2 * averageRTT));
+
+  // Exponential moving average, like TCP: srtt = 7/8 srtt + 1/8 rtt
+  if (smoothedRTT == 0) {
+    smoothedRTT = duration * 8;
+  } else {
+    smoothedRTT = smoothedRTT - (smoothedRTT / 8) + duration;
+  }
+
+  if (!success) {
+    adaptiveTimeBetweenMessages *= 2;
+
+    if (adaptiveTimeBetweenMessages > CONTROLLER_DELAY_QUEUE_ADAPTIVE_MAX) {
+      adaptiveTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_ADAPTIVE_MAX;
+    }
+  } else if (!slowResponse) {
+    // The configured minimal send interval is only the starting point,
+    // the interval may become shorter when the controller keeps up.
+    if (adaptiveTimeBetweenMessages > (CONTROLLER_DELAY_QUEUE_ADAPTIVE_MIN + CONTROLLER_DELAY_QUEUE_ADAPTIVE_STEP)) {
+      adaptiveTimeBetweenMessages -= CONTROLLER_DELAY_QUEUE_ADAPTIVE_STEP;
+    } else {
+      adaptiveTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_ADAPTIVE_MIN;
+    }
+  }
+}
+
 // Set the "lastSend" to "now" + some additional delay.
 // This will cause the next schedule time to be delayed to
 // msecFromNow + minTimeBetweenMessages
@@ -244,14 +490,10 @@ void ControllerDelayHandlerStruct::setAdditionalDelay(unsigned long msecFromNow)
 }
 
 size_t ControllerDelayHandlerStruct::getQueueMemorySize() const {
-  size_t totalSize = 0;
-
-  for (auto it = sendQueue.begin(); it != sendQueue.end(); ++it) {
-    if (it->get() != nullptr) {
-      totalSize += it->get()->getSize();
-    }
+  if (sendQueue.empty() || (sendQueue.back().get() == nullptr)) {
+    return queueMemorySize;
   }
-  return totalSize;
+  return queueMemorySize + sendQueue.back()->getSize();
 }
 
 void ControllerDelayHandlerStruct::process(
@@ -260,6 +502,13 @@ void ControllerDelayHandlerStruct::process(
   TimingStatsElements                timerstats_id,
   SchedulerIntervalTimer_e timerID) 
 {
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  if (spill != nullptr) {
+    // Flush the elements spilled since the last run at once.
+    spill->flush();
+  }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   Queue_element_base *element(static_cast<Queue_element_base *>(getNext()));
 
   if (element == nullptr) { return; }
@@ -271,7 +520,17 @@ void ControllerDelayHandlerStruct::process(
       LoadControllerSettings(element->_controller_idx, *ControllerSettings);
       cacheControllerSettings(*ControllerSettings);
       START_TIMER;
-      markProcessed(func(controller_number, *element, *ControllerSettings));
+      const unsigned long send_start_time = millis();
+      const bool success                  = func(controller_number, *element, *ControllerSettings);
+      const long duration                 = timePassedSince(send_start_time);
+
+      if (adaptive_interval) {
+        updateAdaptiveInterval(success, duration);
+      }
+      #if FEATURE_TIMING_STATS
+      addControllerSendTimingStat(element->_controller_idx, success, duration);
+      #endif
+      markProcessed(success);
       #if FEATURE_TIMING_STATS
       STOP_TIMER_VAR(timerstats_id);
       #endif
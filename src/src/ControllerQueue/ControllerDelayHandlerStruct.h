@@ -4,6 +4,9 @@
 #include "../../ESPEasy_common.h"
 
 #include "../ControllerQueue/Queue_element_base.h"
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include "../ControllerQueue/ControllerQueueSpillStruct.h"
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/TimingStats.h"
@@ -38,13 +41,27 @@ typedef bool (*do_process_function)(int,
 struct ControllerDelayHandlerStruct {
   ControllerDelayHandlerStruct();
 
+  ~ControllerDelayHandlerStruct();
+
   bool cacheControllerSettings(controllerIndex_t ControllerIndex);
   void cacheControllerSettings(const ControllerSettingsStruct& settings);
 
   bool readyToProcess(const Queue_element_base& element) const;
 
+  // Return true when no element can be added, not even to the spill file.
   bool queueFull(controllerIndex_t controller_idx) const;
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Allow to store elements on the file system when the queue in RAM is full,
+  // if enabled in the controller settings.
+  // The controller must provide a function to create its queue elements from the stored data.
+  void initSpillToFlash(controllerIndex_t          ControllerIndex,
+                        spill_deserialize_function deserialize);
+
+  size_t getSpillSize() const;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   // Return true if message is already present in the queue
   bool isDuplicate(const Queue_element_base& element) const;
 
@@ -52,6 +69,10 @@ struct ControllerDelayHandlerStruct {
   // Return true when item was added, or skipped as it was considered a duplicate
   bool addToQueue(std::unique_ptr<Queue_element_base>element);
 
+  // Remove the last element of the queue.
+  // To be used when a controller fails to complete an element it just added.
+  void dropBack();
+
   // Get the next element.
   // Remove front element when max_retries is reached.
   Queue_element_base* getNext();
@@ -63,6 +84,15 @@ struct ControllerDelayHandlerStruct {
 
   unsigned long getNextScheduleTime() const;
 
+  // Time to wait after sending a message, before sending the next one.
+  // Either the configured minTimeBetweenMessages or the adaptive send interval.
+  unsigned int  getTimeBetweenMessages() const;
+
+  // Adjust the adaptive send interval to the result and duration (msec) of sending a message.
+  // Additive decrease of the interval on success, multiplicative increase on failure. (AIMD)
+  void          updateAdaptiveInterval(bool          success,
+                                       unsigned long duration);
+
   // Set the "lastSend" to "now" + some additional delay.
   // This will cause the next schedule time to be delayed to
   // msecFromNow + minTimeBetweenMessages
@@ -88,6 +118,60 @@ struct ControllerDelayHandlerStruct {
   bool                                           must_check_reply       = false;
   bool                                           deduplicate            = false;
   bool                                           useLocalSystemTime     = false;
+
+  // Max. number of elements processed per run of the queue.
+  // Only used for MQTT, set to CONTROLLER_DELAY_QUEUE_BATCH_SIZE when "Batch Publish" is enabled.
+  uint8_t                                        max_batch_size         = 1;
+
+  // Publish all values of a task as a single JSON payload.
+  bool                                           aggregate_values       = false;
+
+  // Max. memory used by the queued elements, 0 = no limit.
+  size_t                                         max_queue_bytes        = CONTROLLER_DELAY_QUEUE_MAX_BYTES;
+
+  // Adapt the time between messages to how fast the controller can handle them.
+  bool                                           adaptive_interval      = false;
+
+  // Current adaptive send interval in msec, 0 = not yet started.
+  unsigned int                                   adaptiveTimeBetweenMessages = 0;
+
+  // Smoothed duration of sending a message in msec, scaled by 8.
+  unsigned long                                  smoothedRTT            = 0;
+
+private:
+
+  // Return true when the queue in RAM cannot take more elements.
+  bool ramQueueFull(controllerIndex_t controller_idx) const;
+
+  // Remove the front element without it being sent.
+  void dropFront();
+
+  // Add to or remove from the queue, keeping track of the memory used by the queued elements.
+  // Must be used instead of modifying sendQueue directly.
+  void pushBack(std::unique_ptr<Queue_element_base>element);
+
+  void popFront();
+
+  // Memory used by all queued elements except the last one.
+  // The last element may still be extended by the controller after it was added,
+  // so its size is only determined when needed.
+  size_t queueMemorySize = 0;
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  bool spillIsEmpty() const;
+
+  // Move spilled elements back into the queue in RAM, as long as there is room.
+  void readFromSpill();
+
+  // Create or delete the spill file handler, depending on the settings.
+  void updateSpill();
+
+  ControllerQueueSpillStruct *spill                = nullptr;
+  spill_deserialize_function  spill_deserialize    = nullptr;
+  controllerIndex_t           spill_controller_idx = INVALID_CONTROLLER_INDEX;
+  bool                        spill_enabled        = false;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
 };
 
 
@@ -0,0 +1,348 @@
+#include "../ControllerQueue/ControllerQueueSpillStruct.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/StringConverter.h"
+
+
+ControllerQueueSpillStruct::ControllerQueueSpillStruct(controllerIndex_t          ControllerIndex,
+                                                       spill_deserialize_function deserialize)
+  : _deserialize(deserialize), _controllerIndex(ControllerIndex)
+{
+  scanSegments();
+}
+
+ControllerQueueSpillStruct::~ControllerQueueSpillStruct()
+{
+  closeFiles();
+}
+
+bool ControllerQueueSpillStruct::isEmpty() const
+{
+  return (_readSegment >= _writeSegment) && (_readPos >= _writeSize);
+}
+
+uint16_t ControllerQueueSpillStruct::getNrSegments() const
+{
+  return _writeSegment - _readSegment + ((_writeSize > 0) ? 1 : 0);
+}
+
+bool ControllerQueueSpillStruct::write(const Queue_element_base& element, bool delete_oldest)
+{
+  std::vector<uint8_t> data;
+
+  if (!element.serialize(data) || data.empty() || (data.size() > 0xFFFF)) {
+    return false;
+  }
+
+  // Each record starts with its length as 16 bit value.
+  const size_t recordSize = data.size() + 2;
+
+  while ((_totalSize + recordSize) > CONTROLLER_QUEUE_SPILL_MAX_SIZE) {
+    if (!delete_oldest || !deleteOldestSegment()) {
+      return false;
+    }
+  }
+
+  if (!prepareFileForWrite(recordSize)) {
+    return false;
+  }
+  const uint8_t header[2] = {
+    static_cast<uint8_t>(data.size() & 0xFF),
+    static_cast<uint8_t>((data.size() >> 8) & 0xFF)
+  };
+  size_t bytesWritten = _fw.write(header, sizeof(header));
+
+  bytesWritten += _fw.write(&data[0], data.size());
+  _mustFlush    = true;
+
+  _writeSize += bytesWritten;
+  _totalSize += bytesWritten;
+
+  if (bytesWritten != recordSize) {
+    // Do not append to a segment with a partial record, as its end can no longer be found.
+    _fw.close();
+    ++_writeSegment;
+    _writeSize = 0;
+    # ifndef BUILD_NO_DEBUG
+
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLogMove(LOG_LEVEL_ERROR, concat(F("Queue: Error writing spill file "), getFileName(_writeSegment - 1)));
+    }
+    # endif // ifndef BUILD_NO_DEBUG
+    return false;
+  }
+  return true;
+}
+
+void ControllerQueueSpillStruct::flush()
+{
+  if (_mustFlush && _fw) {
+    _fw.flush();
+  }
+  _mustFlush = false;
+}
+
+std::unique_ptr<Queue_element_base> ControllerQueueSpillStruct::read()
+{
+  while (!isEmpty()) {
+    if (_readSegment == _writeSegment) {
+      // Never read from the segment still being written, continue writing in a new segment.
+      _fw.close();
+      ++_writeSegment;
+      _writeSize = 0;
+    }
+
+    if (!_fr) {
+      _fr = tryOpenFile(getFileName(_readSegment), F("r"), FileDestination_e::FLASH);
+
+      if (_fr && (_readPos > 0)) {
+        _fr.seek(_readPos);
+      }
+    }
+
+    if (_fr) {
+      uint8_t header[2]{};
+
+      if (_fr.read(header, sizeof(header)) == sizeof(header)) {
+        const size_t length = header[0] | (header[1] << 8);
+        std::vector<uint8_t> data;
+
+        if (length > 0) {
+          data.resize(length);
+
+          if (_fr.read(&data[0], length) == length) {
+            _readPos += sizeof(header) + length;
+
+            std::unique_ptr<Queue_element_base> element = _deserialize(data);
+
+            if (element) {
+              return element;
+            }
+            continue;
+          }
+        }
+      }
+    }
+
+    // End of the segment, or the segment could not be read
+    deleteOldestSegment();
+  }
+
+  if ((_readSegment != 1) && (_writeSize == 0)) {
+    // All segments have been read, start numbering again
+    closeFiles();
+    _readSegment  = 1;
+    _writeSegment = 1;
+    _readPos      = 0;
+    _totalSize    = 0;
+  }
+  return nullptr;
+}
+
+void ControllerQueueSpillStruct::clear()
+{
+  closeFiles();
+
+  for (uint16_t segment = _readSegment; segment <= _writeSegment; ++segment) {
+    const String fname = getFileName(segment);
+
+    if (fileExists(fname)) {
+      tryDeleteFile(fname, FileDestination_e::FLASH);
+    }
+  }
+  _readSegment  = 1;
+  _writeSegment = 1;
+  _readPos      = 0;
+  _writeSize    = 0;
+  _totalSize    = 0;
+}
+
+void ControllerQueueSpillStruct::appendString(std::vector<uint8_t>& data, const String& str)
+{
+  const size_t length = (str.length() > 0xFFFF) ? 0xFFFF : str.length();
+
+  data.push_back(length & 0xFF);
+  data.push_back((length >> 8) & 0xFF);
+  data.insert(data.end(), str.c_str(), str.c_str() + length);
+}
+
+bool ControllerQueueSpillStruct::readString(const std::vector<uint8_t>& data, size_t& pos, String& str)
+{
+  if ((pos + 2) > data.size()) {
+    return false;
+  }
+  const size_t length = data[pos] | (data[pos + 1] << 8);
+
+  pos += 2;
+
+  if ((pos + length) > data.size()) {
+    return false;
+  }
+  str.clear();
+
+  if (!str.reserve(length)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < length; ++i) {
+    str += static_cast<char>(data[pos + i]);
+  }
+  pos += length;
+  return true;
+}
+
+String ControllerQueueSpillStruct::getFileName(uint16_t segment) const
+{
+  String fname;
+
+  fname.reserve(20);
+  # ifdef ESP32
+  fname = '/';
+  # endif // ifdef ESP32
+  fname += F("ctrlq");
+  fname += _controllerIndex + 1;
+  fname += '_';
+  fname += segment;
+  fname += F(".bin");
+  return fname;
+}
+
+void ControllerQueueSpillStruct::scanSegments()
+{
+  String prefix = F("ctrlq");
+
+  prefix += _controllerIndex + 1;
+  prefix += '_';
+
+  uint16_t lowest    = 65535;
+  uint16_t highest   = 0;
+  size_t   totalSize = 0;
+
+  auto checkFile = [&](String fname, size_t fileSize) {
+    if (fname.startsWith(F("/"))) {
+      fname = fname.substring(1);
+    }
+
+    if (fname.startsWith(prefix) && fname.endsWith(F(".bin"))) {
+      int segment = 0;
+
+      if (validIntFromString(fname.substring(prefix.length(), fname.length() - 4), segment) &&
+          (segment > 0) && (segment < 65535)) {
+        if (lowest > segment) { lowest = segment; }
+
+        if (highest < segment) { highest = segment; }
+        totalSize += fileSize;
+      }
+    }
+  };
+
+  # ifdef ESP8266
+  fs::Dir dir = ESPEASY_FS.openDir("");
+
+  while (dir.next()) {
+    checkFile(dir.fileName(), dir.fileSize());
+  }
+  # endif // ifdef ESP8266
+  # ifdef ESP32
+  fs::File root = ESPEASY_FS.open(F("/"));
+  fs::File file = root.openNextFile();
+
+  while (file) {
+    if (!file.isDirectory()) {
+      checkFile(file.name(), file.size());
+    }
+    file = root.openNextFile();
+  }
+  # endif // ifdef ESP32
+
+  if (lowest <= highest) {
+    // Continue writing in a new segment, as the last one may end with a partial record.
+    _readSegment  = lowest;
+    _writeSegment = highest + 1;
+    _writeSize    = 0;
+    _totalSize    = totalSize;
+    _readPos      = 0;
+
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      String log = F("Queue: Controller ");
+      log += _controllerIndex + 1;
+      log += F(" found ");
+      log += totalSize;
+      log += F(" bytes of spilled queue elements");
+      addLogMove(LOG_LEVEL_INFO, log);
+    }
+  }
+}
+
+bool ControllerQueueSpillStruct::prepareFileForWrite(size_t recordSize)
+{
+  if ((_writeSize > 0) && ((_writeSize + recordSize) > CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE)) {
+    // Start a new segment
+    _fw.close();
+    ++_writeSegment;
+    _writeSize = 0;
+  }
+
+  if (SpiffsFreeSpace() < (recordSize + SpiffsBlocksize())) {
+    return false;
+  }
+
+  if (!_fw) {
+    _fw = tryOpenFile(getFileName(_writeSegment), F("a"), FileDestination_e::FLASH);
+  }
+  return _fw ? true : false;
+}
+
+bool ControllerQueueSpillStruct::deleteOldestSegment()
+{
+  if (_readSegment >= _writeSegment) {
+    if (_writeSize == 0) {
+      // Nothing left to delete
+      return false;
+    }
+
+    // The oldest segment is the one being written
+    _fw.close();
+    ++_writeSegment;
+    _writeSize = 0;
+  }
+
+  if (_fr) {
+    _fr.close();
+  }
+  const String fname = getFileName(_readSegment);
+  size_t fileSize    = 0;
+  {
+    fs::File f = tryOpenFile(fname, F("r"), FileDestination_e::FLASH);
+
+    if (f) {
+      fileSize = f.size();
+      f.close();
+    }
+  }
+
+  if (fileSize > 0) {
+    tryDeleteFile(fname, FileDestination_e::FLASH);
+  }
+  _totalSize = (_totalSize > fileSize) ? (_totalSize - fileSize) : 0;
+  ++_readSegment;
+  _readPos = 0;
+  return true;
+}
+
+void ControllerQueueSpillStruct::closeFiles()
+{
+  if (_fw) {
+    _fw.close();
+  }
+  _mustFlush = false;
+
+  if (_fr) {
+    _fr.close();
+  }
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
@@ -0,0 +1,119 @@
+#ifndef CONTROLLERQUEUE_CONTROLLERQUEUESPILLSTRUCT_H
+#define CONTROLLERQUEUE_CONTROLLERQUEUESPILLSTRUCT_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+# include "../ControllerQueue/Queue_element_base.h"
+# include "../DataTypes/ControllerIndex.h"
+
+# include <FS.h>
+# include <memory>
+# include <vector>
+
+// Max. total size of the spill files of a single controller queue.
+# ifndef CONTROLLER_QUEUE_SPILL_MAX_SIZE
+#  ifdef ESP8266
+#   define CONTROLLER_QUEUE_SPILL_MAX_SIZE      65536
+#  else // ifdef ESP8266
+#   define CONTROLLER_QUEUE_SPILL_MAX_SIZE      262144
+#  endif // ifdef ESP8266
+# endif // ifndef CONTROLLER_QUEUE_SPILL_MAX_SIZE
+
+// Size at which a new segment file is started.
+// A segment is only deleted as a whole, once all of its elements have been read back.
+# ifndef CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE
+#  ifdef ESP8266
+#   define CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE  8192
+#  else // ifdef ESP8266
+#   define CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE  32768
+#  endif // ifdef ESP8266
+# endif // ifndef CONTROLLER_QUEUE_SPILL_SEGMENT_SIZE
+
+
+// Create a queue element from the data written by Queue_element_base::serialize()
+typedef std::unique_ptr<Queue_element_base> (*spill_deserialize_function)(const std::vector<uint8_t>&);
+
+
+/*********************************************************************************************\
+* ControllerQueueSpillStruct
+*
+* Overflow of a controller delay queue to the file system, used while the controller cannot
+* send its data and the queue in RAM is full.
+* Elements are appended to segment files "ctrlqN_M.bin" (N = controller nr, M = segment nr)
+* and read back in the same order.
+* Files are never rewritten, a segment is only deleted once it has been read completely
+* or when the oldest data has to make room for new data.
+* Spilled elements left on the file system after a reboot will be read back too.
+\*********************************************************************************************/
+struct ControllerQueueSpillStruct {
+  ControllerQueueSpillStruct(controllerIndex_t          ControllerIndex,
+                             spill_deserialize_function deserialize);
+
+  ~ControllerQueueSpillStruct();
+
+  // Return true when all spilled elements have been read back.
+  bool   isEmpty() const;
+
+  // Total size of the segment files
+  size_t getSize() const {
+    return _totalSize;
+  }
+
+  uint16_t getNrSegments() const;
+
+  // Append an element.
+  // When there is not enough room left, the oldest segment is deleted if delete_oldest is set.
+  // Return false when the element could not be stored.
+  // The data is not flushed to the file system per element, see flush().
+  bool write(const Queue_element_base& element,
+             bool                      delete_oldest);
+
+  // Flush the elements written since the last flush to the file system.
+  // Called once per run of the controller queue, so a burst of elements is flushed at once.
+  void flush();
+
+  // Read the next element, in the order they were written.
+  // Return nullptr when there are no more elements.
+  std::unique_ptr<Queue_element_base> read();
+
+  // Delete all segment files.
+  void clear();
+
+  // Helpers to (de)serialize strings of queue elements, stored with their length as 16 bit value.
+  static void appendString(std::vector<uint8_t>& data,
+                           const String        & str);
+
+  static bool readString(const std::vector<uint8_t>& data,
+                         size_t                    & pos,
+                         String                    & str);
+
+private:
+
+  String getFileName(uint16_t segment) const;
+
+  // Look for segment files left from before a reboot.
+  void   scanSegments();
+
+  bool   prepareFileForWrite(size_t recordSize);
+
+  bool   deleteOldestSegment();
+
+  void   closeFiles();
+
+  fs::File                   _fw; // File handler Write
+  fs::File                   _fr; // File handler Read
+  spill_deserialize_function _deserialize    = nullptr;
+  size_t                     _totalSize      = 0;
+  size_t                     _writeSize      = 0; // Size of the segment being written
+  size_t                     _readPos        = 0; // Position in the segment being read
+  bool                       _mustFlush      = false;
+  uint16_t                   _readSegment    = 1;
+  uint16_t                   _writeSegment   = 1;
+  controllerIndex_t          _controllerIndex = INVALID_CONTROLLER_INDEX;
+};
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+#endif // ifndef CONTROLLERQUEUE_CONTROLLERQUEUESPILLSTRUCT_H
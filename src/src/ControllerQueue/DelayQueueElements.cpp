@@ -28,6 +28,9 @@ bool init_mqtt_delay_queue(controllerIndex_t ControllerIndex, String& pubname, b
     return false;
   }
   MQTTDelayHandler->cacheControllerSettings(*ControllerSettings);
+  # if FEATURE_CONTROLLER_QUEUE_SPILL
+  MQTTDelayHandler->initSpillToFlash(ControllerIndex, MQTT_queue_element::deserialize);
+  # endif // if FEATURE_CONTROLLER_QUEUE_SPILL
   pubname    = ControllerSettings->Publish;
   retainFlag = ControllerSettings->mqtt_retainFlag();
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon
@@ -118,14 +118,14 @@ DEFINE_Cxxx_DELAY_QUEUE_MACRO(00, 3)
 #endif // ifdef USES_C003
 
 #ifdef USES_C004
-# include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
-typedef SimpleQueueElement_formatted_Strings C004_queue_element;
+# include "../ControllerQueue/SimpleQueueElement_TaskValues.h"
+typedef SimpleQueueElement_TaskValues C004_queue_element;
 DEFINE_Cxxx_DELAY_QUEUE_MACRO(00, 4)
 #endif // ifdef USES_C004
 
 #ifdef USES_C007
-# include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
-typedef SimpleQueueElement_formatted_Strings C007_queue_element;
+# include "../ControllerQueue/SimpleQueueElement_TaskValues.h"
+typedef SimpleQueueElement_TaskValues C007_queue_element;
 DEFINE_Cxxx_DELAY_QUEUE_MACRO(00, 7)
 #endif // ifdef USES_C007
 
@@ -141,8 +141,8 @@ DEFINE_Cxxx_DELAY_QUEUE_MACRO(00, 8)
 #endif // ifdef USES_C008
 
 #ifdef USES_C009
-# include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
-typedef SimpleQueueElement_formatted_Strings C009_queue_element;
+# include "../ControllerQueue/SimpleQueueElement_TaskValues.h"
+typedef SimpleQueueElement_TaskValues C009_queue_element;
 DEFINE_Cxxx_DELAY_QUEUE_MACRO(00, 9)
 #endif // ifdef USES_C009
 
@@ -203,8 +203,8 @@ DEFINE_Cxxx_DELAY_QUEUE_MACRO(0, 16)
 
 
 #ifdef USES_C017
-# include "../ControllerQueue/SimpleQueueElement_formatted_Strings.h"
-typedef SimpleQueueElement_formatted_Strings C017_queue_element;
+# include "../ControllerQueue/SimpleQueueElement_TaskValues.h"
+typedef SimpleQueueElement_TaskValues C017_queue_element;
 DEFINE_Cxxx_DELAY_QUEUE_MACRO(0, 17)
 #endif // ifdef USES_C017
 
@@ -2,6 +2,10 @@
 
 #if FEATURE_MQTT
 
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+#  include "../ControllerQueue/ControllerQueueSpillStruct.h"
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 MQTT_queue_element::MQTT_queue_element(int ctrl_idx,
                                        taskIndex_t TaskIndex,
                                        const String& topic, const String& payload,
@@ -87,4 +91,43 @@ void MQTT_queue_element::removeEmptyTopics() {
   }
 }
 
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+bool MQTT_queue_element::serialize(std::vector<uint8_t>& data) const {
+  if (_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
+    // Needs the task to still hold the data when processed.
+    return false;
+  }
+  data.reserve(data.size() + 7 + _topic.length() + _payload.length());
+  data.push_back(_controller_idx);
+  data.push_back(_taskIndex);
+  data.push_back(_retained ? 1 : 0);
+  ControllerQueueSpillStruct::appendString(data, _topic);
+  ControllerQueueSpillStruct::appendString(data, _payload);
+  return true;
+}
+
+std::unique_ptr<Queue_element_base>MQTT_queue_element::deserialize(const std::vector<uint8_t>& data) {
+  if (data.size() < 3) {
+    return nullptr;
+  }
+  std::unique_ptr<MQTT_queue_element> element(new (std::nothrow) MQTT_queue_element());
+
+  if (!element) {
+    return nullptr;
+  }
+  element->_controller_idx = data[0];
+  element->_taskIndex      = data[1];
+  element->_retained       = data[2] != 0;
+
+  size_t pos = 3;
+
+  if (!ControllerQueueSpillStruct::readString(data, pos, element->_topic) ||
+      !ControllerQueueSpillStruct::readString(data, pos, element->_payload)) {
+    return nullptr;
+  }
+  return std::unique_ptr<Queue_element_base>(element.release());
+}
+
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 #endif // if FEATURE_MQTT
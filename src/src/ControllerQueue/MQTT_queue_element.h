@@ -9,6 +9,11 @@
 # include "../DataStructs/UnitMessageCount.h"
 # include "../Globals/CPlugins.h"
 
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+#  include <memory>
+#  include <vector>
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 /*********************************************************************************************\
 * MQTT_queue_element for all MQTT base controllers
 \*********************************************************************************************/
@@ -53,6 +58,12 @@ public:
 
   void removeEmptyTopics();
 
+# if FEATURE_CONTROLLER_QUEUE_SPILL
+  bool                                      serialize(std::vector<uint8_t>& data) const;
+
+  static std::unique_ptr<Queue_element_base>deserialize(const std::vector<uint8_t>& data);
+# endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   String _topic{};
   String _payload{};
   UnitMessageCount_t UnitMessageCount{};
@@ -10,3 +10,14 @@ Queue_element_base::Queue_element_base() :
 }
 
 Queue_element_base::~Queue_element_base() {}
+
+unsigned long Queue_element_base::getHoldUntil() const {
+  return 0;
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+bool Queue_element_base::serialize(std::vector<uint8_t>& data) const {
+  return false;
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
@@ -7,6 +7,10 @@
 #include "../DataStructs/UnitMessageCount.h"
 #include "../Globals/CPlugins.h"
 
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include <vector>
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
 /*********************************************************************************************\
 * Base class for all controller queue elements
 \*********************************************************************************************/
@@ -23,6 +27,17 @@ public:
   virtual const UnitMessageCount_t* getUnitMessageCount() const = 0;
   virtual UnitMessageCount_t      * getUnitMessageCount()       = 0;
 
+  // Moment (millis) until which the element must be kept in the queue, 0 = can be sent right away.
+  // Used by controllers collecting several messages in a single element.
+  virtual unsigned long             getHoldUntil() const;
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  // Append the content of the element to data, to be stored in a controller queue spill file.
+  // Return false when the element cannot be stored.
+  virtual bool serialize(std::vector<uint8_t>& data) const;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
   unsigned long _timestamp;
   controllerIndex_t _controller_idx;
   taskIndex_t _taskIndex;
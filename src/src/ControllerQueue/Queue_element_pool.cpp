@@ -0,0 +1,78 @@
+#include "../ControllerQueue/Queue_element_pool.h"
+
+#include <new>
+
+Queue_element_pool::Queue_element_pool(size_t slotSize)
+{
+  // Keep all slots aligned like a heap allocation would be.
+  constexpr size_t alignment = 8;
+
+  _slotSize = (slotSize + alignment - 1) & ~(alignment - 1);
+}
+
+Queue_element_pool::~Queue_element_pool()
+{
+  delete[] _slots;
+}
+
+void * Queue_element_pool::allocate(size_t size)
+{
+  if ((CONTROLLER_QUEUE_POOL_SLOTS == 0) || (size > _slotSize)) {
+    return nullptr;
+  }
+
+  if (_slots == nullptr) {
+    #ifdef USE_SECOND_HEAP
+    HeapSelectIram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+
+    _slots = new (std::nothrow) uint8_t[_slotSize * CONTROLLER_QUEUE_POOL_SLOTS];
+
+    if (_slots == nullptr) {
+      return nullptr;
+    }
+  }
+
+  for (uint8_t i = 0; i < CONTROLLER_QUEUE_POOL_SLOTS; ++i) {
+    const uint64_t mask = static_cast<uint64_t>(1) << i;
+
+    if ((_used & mask) == 0) {
+      _used |= mask;
+      return _slots + (i * _slotSize);
+    }
+  }
+  return nullptr;
+}
+
+bool Queue_element_pool::release(void *ptr)
+{
+  if ((_slots == nullptr) || (ptr == nullptr)) {
+    return false;
+  }
+  const uint8_t *p = static_cast<const uint8_t *>(ptr);
+
+  if ((p < _slots) || (p >= (_slots + (_slotSize * CONTROLLER_QUEUE_POOL_SLOTS)))) {
+    return false;
+  }
+  const size_t slot = (p - _slots) / _slotSize;
+
+  _used &= ~(static_cast<uint64_t>(1) << slot);
+  return true;
+}
+
+uint8_t Queue_element_pool::slotsUsed() const
+{
+  uint8_t  count = 0;
+  uint64_t used  = _used;
+
+  while (used != 0) {
+    used &= used - 1;
+    ++count;
+  }
+  return count;
+}
+
+uint8_t Queue_element_pool::slotsFree() const
+{
+  return CONTROLLER_QUEUE_POOL_SLOTS - slotsUsed();
+}
@@ -0,0 +1,54 @@
+#ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
+#define CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
+
+#include "../../ESPEasy_common.h"
+
+// Max. number of fixed size queue elements kept in a preallocated pool, shared by all controllers.
+// When all slots are in use, elements are allocated on the heap.
+// Set to 0 to disable the pool.
+#ifndef CONTROLLER_QUEUE_POOL_SLOTS
+# ifdef ESP8266
+#  define CONTROLLER_QUEUE_POOL_SLOTS  16
+# else // ifdef ESP8266
+#  define CONTROLLER_QUEUE_POOL_SLOTS  64
+# endif // ifdef ESP8266
+#endif // ifndef CONTROLLER_QUEUE_POOL_SLOTS
+
+#if CONTROLLER_QUEUE_POOL_SLOTS > 64
+# error "CONTROLLER_QUEUE_POOL_SLOTS: max. 64 slots"
+#endif // if CONTROLLER_QUEUE_POOL_SLOTS > 64
+
+
+/*********************************************************************************************\
+* Pool of fixed size memory blocks for controller queue elements.
+* The memory for all slots is allocated in a single block on first use and kept,
+* so queueing and sending messages does not fragment the heap,
+* even when lots of messages get queued during a network outage.
+\*********************************************************************************************/
+class Queue_element_pool {
+public:
+
+  explicit Queue_element_pool(size_t slotSize);
+
+  ~Queue_element_pool();
+
+  // Return nullptr when size does not fit in a slot or all slots are in use.
+  void  * allocate(size_t size);
+
+  // Return false when ptr was not allocated from this pool.
+  bool    release(void *ptr);
+
+  uint8_t slotsUsed() const;
+
+  uint8_t slotsFree() const;
+
+private:
+
+  uint8_t *_slots    = nullptr;
+  size_t   _slotSize = 0;
+
+  // Bit set for each slot in use
+  uint64_t _used = 0;
+};
+
+#endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_POOL_H
@@ -0,0 +1,286 @@
+#include "../ControllerQueue/SimpleQueueElement_TaskValues.h"
+
+#include "../ControllerQueue/Queue_element_pool.h"
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include "../ControllerQueue/ControllerQueueSpillStruct.h"
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+#include "../DataStructs/ESPEasy_EventStruct.h"
+#include "../Globals/Cache.h"
+#include "../Globals/Device.h"
+#include "../Globals/RuntimeData.h"
+
+#include "../../_Plugin_Helper.h"
+
+
+static Queue_element_pool& getTaskValuesElementPool() {
+  static Queue_element_pool pool(sizeof(SimpleQueueElement_TaskValues));
+
+  return pool;
+}
+
+SimpleQueueElement_TaskValues::SimpleQueueElement_TaskValues(struct EventStruct *event) :
+  idx(event->idx),
+  sensorType(event->getSensorType()),
+  valuesSent(0)
+{
+  _controller_idx = event->ControllerIndex;
+  _taskIndex      = event->TaskIndex;
+
+  valueCount = getValueCountForTask(_taskIndex);
+
+  if (valueCount > VARS_PER_TASK) {
+    valueCount = VARS_PER_TASK;
+  }
+  values.clear();
+  const TaskValues_Data_t *data = UserVar.getTaskValues_Data(_taskIndex);
+
+  if (data != nullptr) {
+    for (uint8_t i = 0; i < valueCount; ++i) {
+      values.copyValue(*data, i, sensorType);
+    }
+  }
+
+  // Only call PLUGIN_FORMAT_USERVAR for plugins implementing it, as it needs a copy of the event.
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(_taskIndex);
+  const bool formatUserVar        = validDeviceIndex(DeviceIndex) && Device[DeviceIndex].FormatUserVar;
+
+  if (!formatUserVar && (sensorType != Sensor_VType::SENSOR_TYPE_STRING)) {
+    // Nothing to format when queued.
+    return;
+  }
+
+  for (uint8_t i = 0; i < valueCount; ++i) {
+    // Same order as doFormatUserVar(): first try the plugin specific formatting.
+    String formatted;
+
+    if (formatUserVar) {
+      EventStruct tempEvent;
+      tempEvent.deep_copy(event);
+      tempEvent.idx = i;
+      PluginCall(PLUGIN_FORMAT_USERVAR, &tempEvent, formatted);
+    }
+
+    if (formatted.isEmpty() && (sensorType == Sensor_VType::SENSOR_TYPE_STRING)) {
+      formatted = event->String2;
+    }
+
+    appendFormatted(i, formatted);
+  }
+}
+
+SimpleQueueElement_TaskValues::~SimpleQueueElement_TaskValues() {
+  delete[] _formattedHeap;
+}
+
+void * SimpleQueueElement_TaskValues::operator new(size_t size) {
+  void *ptr = getTaskValuesElementPool().allocate(size);
+
+  if (ptr == nullptr) {
+    ptr = ::operator new(size);
+  }
+  return ptr;
+}
+
+void * SimpleQueueElement_TaskValues::operator new(size_t size, const std::nothrow_t&) noexcept {
+  void *ptr = getTaskValuesElementPool().allocate(size);
+
+  if (ptr == nullptr) {
+    ptr = ::operator new(size, std::nothrow);
+  }
+  return ptr;
+}
+
+void SimpleQueueElement_TaskValues::operator delete(void *ptr) {
+  if (!getTaskValuesElementPool().release(ptr)) {
+    ::operator delete(ptr);
+  }
+}
+
+String SimpleQueueElement_TaskValues::formatValue(uint8_t varNr) const {
+  if (varNr >= valueCount) {
+    return EMPTY_STRING;
+  }
+
+  const char *formatted = getFormatted(varNr);
+
+  if (formatted != nullptr) {
+    return formatted;
+  }
+
+  if (sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
+    return EMPTY_STRING;
+  }
+
+  uint8_t nrDecimals              = 0;
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(_taskIndex);
+
+  if (validDeviceIndex(DeviceIndex) && Device[DeviceIndex].configurableDecimals()) {
+    nrDecimals = Cache.getTaskDeviceValueDecimals(_taskIndex, varNr);
+  }
+  return values.getAsString(varNr, sensorType, nrDecimals);
+}
+
+bool SimpleQueueElement_TaskValues::checkDone(bool succesfull) const {
+  if (succesfull) { ++valuesSent; }
+  return valuesSent >= valueCount || valuesSent >= VARS_PER_TASK;
+}
+
+size_t SimpleQueueElement_TaskValues::getSize() const {
+  size_t size = sizeof(*this);
+
+  if (_formattedHeap != nullptr) {
+    for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+      size += sizeof(String) + _formattedHeap[i].length();
+    }
+  }
+  return size;
+}
+
+bool SimpleQueueElement_TaskValues::isDuplicate(const Queue_element_base& rval) const {
+  const SimpleQueueElement_TaskValues& oth = static_cast<const SimpleQueueElement_TaskValues&>(rval);
+
+  if ((oth._controller_idx != _controller_idx) ||
+      (oth._taskIndex != _taskIndex) ||
+      (oth.sensorType != sensorType) ||
+      (oth.valueCount != valueCount) ||
+      (oth.idx != idx)) {
+    return false;
+  }
+
+  if (memcmp(oth.values.binary, values.binary, sizeof(values.binary)) != 0) {
+    return false;
+  }
+
+  if ((oth._formattedMask != _formattedMask) ||
+      (oth._formattedUsed != _formattedUsed) ||
+      (memcmp(oth._formatted, _formatted, _formattedUsed) != 0)) {
+    return false;
+  }
+
+  if ((oth._formattedHeap == nullptr) && (_formattedHeap == nullptr)) {
+    return true;
+  }
+
+  for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+    const String& othValue = (oth._formattedHeap == nullptr) ? EMPTY_STRING : oth._formattedHeap[i];
+    const String& value    = (_formattedHeap == nullptr) ? EMPTY_STRING : _formattedHeap[i];
+
+    if (!othValue.equals(value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SimpleQueueElement_TaskValues::appendFormatted(uint8_t varNr, const String& formatted) {
+  if (formatted.isEmpty() || (varNr >= VARS_PER_TASK)) {
+    return;
+  }
+  const size_t length = formatted.length();
+
+  if ((length + 1) <= (sizeof(_formatted) - _formattedUsed)) {
+    memcpy(&_formatted[_formattedUsed], formatted.c_str(), length);
+    _formatted[_formattedUsed + length] = '\0';
+    _formattedUsed += length + 1;
+    _formattedMask |= (1 << varNr);
+    return;
+  }
+
+  // Does not fit, keep it in a String instead of truncating the value.
+  if (_formattedHeap == nullptr) {
+    _formattedHeap = new (std::nothrow) String[VARS_PER_TASK];
+
+    if (_formattedHeap == nullptr) {
+      addLog(LOG_LEVEL_ERROR, F("Controller: Not enough memory to queue formatted value"));
+      return;
+    }
+  }
+  _formattedHeap[varNr] = formatted;
+}
+
+const char * SimpleQueueElement_TaskValues::getFormatted(uint8_t varNr) const {
+  if (varNr >= VARS_PER_TASK) {
+    return nullptr;
+  }
+
+  if (!(_formattedMask & (1 << varNr))) {
+    if ((_formattedHeap != nullptr) && !_formattedHeap[varNr].isEmpty()) {
+      return _formattedHeap[varNr].c_str();
+    }
+    return nullptr;
+  }
+  const char *formatted = _formatted;
+
+  // Skip the formatted values of the preceding variables.
+  for (uint8_t i = 0; i < varNr; ++i) {
+    if (_formattedMask & (1 << i)) {
+      formatted += strlen(formatted) + 1;
+    }
+  }
+  return formatted;
+}
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+bool SimpleQueueElement_TaskValues::serialize(std::vector<uint8_t>& data) const {
+  data.reserve(data.size() + 9 + sizeof(values.binary));
+  data.push_back(_controller_idx);
+  data.push_back(_taskIndex);
+  data.push_back(static_cast<uint8_t>(sensorType));
+  data.push_back(valueCount);
+
+  for (uint8_t i = 0; i < 4; ++i) {
+    data.push_back((static_cast<uint32_t>(idx) >> (8 * i)) & 0xFF);
+  }
+  data.insert(data.end(), values.binary, values.binary + sizeof(values.binary));
+  data.push_back(hasFormatted() ? 1 : 0);
+
+  if (hasFormatted()) {
+    // A string per value, empty when not formatted when queued.
+    for (uint8_t i = 0; i < valueCount; ++i) {
+      const char *formatted = getFormatted(i);
+      ControllerQueueSpillStruct::appendString(data, formatted == nullptr ? EMPTY_STRING : String(formatted));
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<Queue_element_base>SimpleQueueElement_TaskValues::deserialize(const std::vector<uint8_t>& data) {
+  const size_t headerSize = 8 + sizeof(TaskValues_Data_t::binary) + 1;
+
+  if ((data.size() < headerSize) || (data[3] > VARS_PER_TASK)) {
+    return nullptr;
+  }
+  std::unique_ptr<SimpleQueueElement_TaskValues> element(new (std::nothrow) SimpleQueueElement_TaskValues());
+
+  if (!element) {
+    return nullptr;
+  }
+  element->_controller_idx = data[0];
+  element->_taskIndex      = data[1];
+  element->sensorType      = static_cast<Sensor_VType>(data[2]);
+  element->valueCount      = data[3];
+
+  uint32_t idx = 0;
+
+  for (uint8_t i = 0; i < 4; ++i) {
+    idx |= static_cast<uint32_t>(data[4 + i]) << (8 * i);
+  }
+  element->idx = static_cast<int>(idx);
+  memcpy(element->values.binary, &data[8], sizeof(element->values.binary));
+
+  if (data[headerSize - 1] != 0) {
+    size_t pos = headerSize;
+
+    for (uint8_t i = 0; i < element->valueCount; ++i) {
+      String formatted;
+
+      if (!ControllerQueueSpillStruct::readString(data, pos, formatted)) {
+        return nullptr;
+      }
+      element->appendFormatted(i, formatted);
+    }
+  }
+  return std::unique_ptr<Queue_element_base>(element.release());
+}
+
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
@@ -0,0 +1,114 @@
+#ifndef CONTROLLERQUEUE_SIMPLEQUEUEELEMENT_TASKVALUES_H
+#define CONTROLLERQUEUE_SIMPLEQUEUEELEMENT_TASKVALUES_H
+
+
+#include "../../ESPEasy_common.h"
+#include "../ControllerQueue/Queue_element_base.h"
+#include "../CustomBuild/ESPEasyLimits.h"
+#include "../DataStructs/DeviceStruct.h"
+#include "../DataStructs/UnitMessageCount.h"
+#include "../DataTypes/TaskValues_Data.h"
+#include "../Globals/Plugins.h"
+
+#include <memory>
+#include <new>
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+# include <vector>
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+// Max. number of bytes per queue element to keep the values which are formatted when queued,
+// including a terminating zero per value. Values not fitting are kept in Strings on the heap.
+#ifndef CONTROLLER_QUEUE_ELEMENT_FORMATTED_SIZE
+# ifdef ESP8266
+#  define CONTROLLER_QUEUE_ELEMENT_FORMATTED_SIZE  64
+# else // ifdef ESP8266
+#  define CONTROLLER_QUEUE_ELEMENT_FORMATTED_SIZE  128
+# endif // ifdef ESP8266
+#endif // ifndef CONTROLLER_QUEUE_ELEMENT_FORMATTED_SIZE
+
+struct EventStruct;
+
+/*********************************************************************************************\
+* Queue element keeping the raw task values instead of formatted strings.
+* Values are formatted using the task's number of decimals when the element is being sent.
+* The element has a fixed size and is allocated from a preallocated pool (see Queue_element_pool)
+* as long as there are free slots.
+*
+* Only values of sensor type STRING and values of plugins doing their own formatting
+* (PLUGIN_FORMAT_USERVAR) are formatted when queued, as these cannot be formatted later.
+* These are kept in a fixed size buffer in the element, so usually no extra heap allocation is needed.
+* Values which do not fit in the buffer are kept in Strings allocated when needed.
+\*********************************************************************************************/
+class SimpleQueueElement_TaskValues : public Queue_element_base {
+public:
+
+  SimpleQueueElement_TaskValues() = default;
+
+  SimpleQueueElement_TaskValues(struct EventStruct *event);
+
+  SimpleQueueElement_TaskValues(const SimpleQueueElement_TaskValues& other) = delete;
+
+  virtual ~SimpleQueueElement_TaskValues();
+
+  static void* operator new(size_t size);
+  static void* operator new(size_t size,
+                            const std::nothrow_t&) noexcept;
+  static void  operator delete(void *ptr);
+
+  // Formatted value, like formatUserVarNoCheck() would have returned when the element was queued.
+  String                    formatValue(uint8_t varNr) const;
+
+  // For controllers that only send a single value per request and thus need to keep track of the number of values already sent.
+  bool                      checkDone(bool succesfull) const;
+
+  size_t                    getSize() const;
+
+  bool                      isDuplicate(const Queue_element_base& other) const;
+
+  const UnitMessageCount_t* getUnitMessageCount() const {
+    return nullptr;
+  }
+
+  UnitMessageCount_t* getUnitMessageCount() {
+    return nullptr;
+  }
+
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+  bool                                      serialize(std::vector<uint8_t>& data) const;
+
+  static std::unique_ptr<Queue_element_base>deserialize(const std::vector<uint8_t>& data);
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
+
+  TaskValues_Data_t values{};
+  int idx                    = 0;
+  Sensor_VType sensorType    = Sensor_VType::SENSOR_TYPE_NONE;
+  mutable uint8_t valuesSent = 0; // Value must be set by const function checkDone()
+  uint8_t valueCount         = 0;
+
+private:
+
+  // Append the formatted value of varNr to _formatted, must be called in order of varNr.
+  void appendFormatted(uint8_t       varNr,
+                       const String& formatted);
+
+  // Return nullptr when varNr has no formatted value.
+  const char* getFormatted(uint8_t varNr) const;
+
+  bool        hasFormatted() const {
+    return (_formattedMask != 0) || (_formattedHeap != nullptr);
+  }
+
+  // Zero terminated formatted values, stored in order of varNr.
+  char    _formatted[CONTROLLER_QUEUE_ELEMENT_FORMATTED_SIZE]{};
+  uint8_t _formattedMask = 0; // Bit per varNr with a formatted value in _formatted
+  uint8_t _formattedUsed = 0; // Nr of bytes used in _formatted
+
+  // Formatted values not fitting in _formatted, VARS_PER_TASK Strings allocated when needed.
+  String *_formattedHeap = nullptr;
+};
+
+static_assert(VARS_PER_TASK <= 8, "_formattedMask has a single bit per task value");
+static_assert(CONTROLLER_QUEUE_ELEMENT_FORMATTED_SIZE <= 255, "_formattedUsed is an uint8_t");
+
+#endif // CONTROLLERQUEUE_SIMPLEQUEUEELEMENT_TASKVALUES_H
@@ -3102,6 +3102,64 @@ To create/register a plugin, you have to :
   #endif
 #endif
 
+// Pre-parse rules files into a compact image of line types and jump indices.
+// Takes a few bytes of RAM per rules line.
+#ifndef FEATURE_RULES_COMPILER
+  #if defined(ESP8266) && defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_RULES_COMPILER 0
+  #else
+    #define FEATURE_RULES_COMPILER 1
+  #endif
+#endif
+
+// Keep a small cache of compiled (RPN) expressions used in Calculate.
+// Takes a few hundred bytes of RAM when in use.
+#ifndef FEATURE_RULES_CALCULATE_CACHE
+  #if defined(ESP8266) && defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_RULES_CALCULATE_CACHE 0
+  #else
+    #define FEATURE_RULES_CALCULATE_CACHE 1
+  #endif
+#endif
+
+// Store controller queue elements on the file system when the queue in RAM is full.
+// Must be enabled per controller.
+#ifndef FEATURE_CONTROLLER_QUEUE_SPILL
+  #if defined(ESP8266) && defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_CONTROLLER_QUEUE_SPILL 0
+  #else
+    #define FEATURE_CONTROLLER_QUEUE_SPILL 1
+  #endif
+#endif
+
+// Only send task values to controllers when they have changed more than a set deadband.
+// Must be enabled per task value.
+#ifndef FEATURE_TASKVALUE_SEND_ON_CHANGE
+  #if defined(ESP8266) && defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_TASKVALUE_SEND_ON_CHANGE 0
+  #else
+    #define FEATURE_TASKVALUE_SEND_ON_CHANGE 1
+  #endif
+#endif
+
+// Keep compiled versions of controller topics/payloads and display lines,
+// so they do not have to be parsed again every time they are used.
+#ifndef FEATURE_COMPILED_TEMPLATES
+  #if defined(ESP8266) && defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_COMPILED_TEMPLATES 0
+  #else
+    #define FEATURE_COMPILED_TEMPLATES 1
+  #endif
+#endif
+
+#ifndef FEATURE_SYSVAR_CACHE
+  #if defined(ESP8266) && defined(LIMIT_BUILD_SIZE)
+    #define FEATURE_SYSVAR_CACHE 0
+  #else
+    #define FEATURE_SYSVAR_CACHE 1
+  #endif
+#endif
+
 // ESPEASY_RULES_FLOAT_TYPE should be either double (default) or float.
 // It is solely based on FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
 #ifdef ESPEASY_RULES_FLOAT_TYPE
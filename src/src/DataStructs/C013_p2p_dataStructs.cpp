@@ -4,6 +4,30 @@
 
 # include "../Globals/Plugins.h"
 
+// Unsigned LEB128 encoding, 7 bits per byte, MSB set when more bytes follow.
+static void C013_appendVarint(std::vector<uint8_t>& data, uint32_t value)
+{
+  while (value > 0x7F) {
+    data.push_back(static_cast<uint8_t>(value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  data.push_back(static_cast<uint8_t>(value));
+}
+
+static bool C013_readVarint(const uint8_t *data, size_t size, size_t& pos, uint32_t& value)
+{
+  value = 0;
+
+  for (uint8_t shift = 0; shift < 32; shift += 7) {
+    if (pos >= size) { return false; }
+    const uint8_t c = data[pos++];
+    value |= static_cast<uint32_t>(c & 0x7F) << shift;
+
+    if ((c & 0x80) == 0) { return true; }
+  }
+  return false;
+}
+
 
 
 bool C013_SensorInfoStruct::isValid() const
@@ -41,4 +65,94 @@ bool C013_SensorDataStruct::matchesSensorType(Sensor_VType sensor_type) const
   return sensorType == sensor_type;
 }
 
+bool C013_SensorDataFrame::add(taskIndex_t              taskIndex,
+                               pluginID_t               deviceNumber,
+                               Sensor_VType             sensorType,
+                               const TaskValues_Data_t& values)
+{
+  if (_count == 255) { return false; }
+
+  if (_frame.empty()) {
+    _frame.reserve(C013_V2_MAX_FRAME_SIZE);
+    _frame.resize(C013_V2_HEADER_SIZE);
+  }
+
+  const size_t oldSize = _frame.size();
+
+  C013_appendVarint(_frame, taskIndex);
+  C013_appendVarint(_frame, deviceNumber.value);
+  _frame.push_back(static_cast<uint8_t>(sensorType));
+  _frame.insert(_frame.end(), values.binary, values.binary + sizeof(values.binary));
+
+  if (_frame.size() > C013_V2_MAX_FRAME_SIZE) {
+    _frame.resize(oldSize);
+    return false;
+  }
+  ++_count;
+  return true;
+}
+
+const std::vector<uint8_t>& C013_SensorDataFrame::finalize(uint8_t sourceUnit, uint8_t destUnit, uint16_t sequenceNr)
+{
+  if (_frame.size() >= C013_V2_HEADER_SIZE) {
+    _frame[0] = 255;
+    _frame[1] = 6;
+    _frame[2] = sourceUnit;
+    _frame[3] = destUnit;
+    _frame[4] = sequenceNr & 0xFF;
+    _frame[5] = (sequenceNr >> 8) & 0xFF;
+    _frame[6] = _count;
+  }
+  return _frame;
+}
+
+void C013_SensorDataFrame::clear()
+{
+  _frame.clear();
+  _count = 0;
+}
+
+bool C013_SensorDataFrame::parseHeader(const uint8_t *data,
+                                       size_t         size,
+                                       uint8_t      & sourceUnit,
+                                       uint8_t      & destUnit,
+                                       uint16_t     & sequenceNr,
+                                       uint8_t      & count)
+{
+  if ((data == nullptr) || (size < C013_V2_HEADER_SIZE) || (data[0] != 255) || (data[1] != 6)) {
+    return false;
+  }
+  sourceUnit = data[2];
+  destUnit   = data[3];
+  sequenceNr = data[4] | (data[5] << 8);
+  count      = data[6];
+  return true;
+}
+
+bool C013_SensorDataFrame::parseRecord(const uint8_t         *data,
+                                       size_t                 size,
+                                       size_t               & pos,
+                                       C013_SensorDataStruct& record)
+{
+  uint32_t taskIndex = 0;
+  uint32_t pluginID  = 0;
+
+  if (!C013_readVarint(data, size, pos, taskIndex) ||
+      !C013_readVarint(data, size, pos, pluginID) ||
+      ((pos + 1 + sizeof(record.values.binary)) > size)) {
+    return false;
+  }
+
+  if (taskIndex >= INVALID_TASK_INDEX) {
+    return false;
+  }
+  record.sourceTaskIndex = taskIndex;
+  record.destTaskIndex   = taskIndex;
+  record.deviceNumber    = pluginID_t::toPluginID(pluginID);
+  record.sensorType      = static_cast<Sensor_VType>(data[pos++]);
+  memcpy(record.values.binary, &data[pos], sizeof(record.values.binary));
+  pos += sizeof(record.values.binary);
+  return true;
+}
+
 #endif // ifdef USES_C013
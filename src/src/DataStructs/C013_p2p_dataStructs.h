@@ -12,6 +12,8 @@
 # include "../DataTypes/TaskValues_Data.h"
 # include "../DataTypes/PluginID.h"
 
+# include <vector>
+
 // These structs are sent to other nodes, so make sure not to change order or offset in struct.
 
 struct C013_SensorInfoStruct
@@ -53,6 +55,69 @@ struct C013_SensorDataStruct
   TaskValues_Data_t values{};
 };
 
+// Version 2 of the sensor data message, holding the values of several tasks.
+// Only sent to nodes announcing support for it (NODE_P2P_FEATURE_C013_V2).
+//
+// 1 byte  header 255
+// 1 byte  ID 6
+// 1 byte  source unit
+// 1 byte  destination unit (255 = all nodes)
+// 2 bytes sequence number, LSB first. Incremented per frame sent, to detect lost frames
+// 1 byte  number of records
+// Per record:
+//   varint  task index (same task index on the receiving node)
+//   varint  plugin ID
+//   1 byte  sensor type
+//   TaskValues_Data_t
+# define C013_V2_HEADER_SIZE      7
+
+// Must be less than UDP_PACKETSIZE_MAX, as larger packets are ignored by the receiving node.
+# ifndef C013_V2_MAX_FRAME_SIZE
+#  define C013_V2_MAX_FRAME_SIZE  (UDP_PACKETSIZE_MAX - 1)
+# endif // ifndef C013_V2_MAX_FRAME_SIZE
+
+struct C013_SensorDataFrame
+{
+  C013_SensorDataFrame() = default;
+
+  // Append the values of a task.
+  // Return false when the frame is full.
+  bool add(taskIndex_t              taskIndex,
+           pluginID_t               deviceNumber,
+           Sensor_VType             sensorType,
+           const TaskValues_Data_t& values);
+
+  bool empty() const {
+    return _count == 0;
+  }
+
+  // Set the header and return the data to send.
+  const std::vector<uint8_t>& finalize(uint8_t  sourceUnit,
+                                       uint8_t  destUnit,
+                                       uint16_t sequenceNr);
+
+  void clear();
+
+  static bool parseHeader(const uint8_t *data,
+                          size_t         size,
+                          uint8_t      & sourceUnit,
+                          uint8_t      & destUnit,
+                          uint16_t     & sequenceNr,
+                          uint8_t      & count);
+
+  // Read the record at pos and convert it into a version 1 sensor data message.
+  // pos is moved to the next record.
+  static bool parseRecord(const uint8_t         *data,
+                          size_t                 size,
+                          size_t               & pos,
+                          C013_SensorDataStruct& record);
+
+private:
+
+  std::vector<uint8_t> _frame;
+  uint8_t              _count = 0;
+};
+
 #endif // ifdef USES_C013
 
 #endif // DATASTRUCTS_C013_P2P_DATASTRUCTS_H
@@ -1,11 +1,13 @@
 #include "../DataStructs/Caches.h"
 
+#include "../DataStructs/ControllerSettingsStruct.h"
 #include "../Globals/Device.h"
 #include "../Globals/ExtraTaskSettings.h"
 #include "../Globals/Settings.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 
 #include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/SystemVariables.h"
 
 
 #ifdef PLUGIN_USES_SERIAL
@@ -19,19 +21,32 @@ void Caches::clearAllCaches()
 }
 
 void Caches::clearAllButTaskCaches() {
+  ++settingsVersion;
   clearFileCaches();
+  #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+  controllerIgnoreSendOnChange_known = 0;
+  #endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
+  #if FEATURE_COMPILED_TEMPLATES
+  controllerTemplates_cache.clear();
+  #endif // if FEATURE_COMPILED_TEMPLATES
   WiFi_AP_Candidates.clearCache();
+  SystemVariables::clearCache();
   rulesHelper.closeAllFiles();
 }
 
 void Caches::clearAllTaskCaches() {
+  ++settingsVersion;
   taskIndexName.clear();
   taskIndexValueName.clear();
   extraTaskSettings_cache.clear();
+  #if FEATURE_COMPILED_TEMPLATES
+  taskTemplates_cache.clear();
+  #endif // if FEATURE_COMPILED_TEMPLATES
   updateActiveTaskUseSerial0();
 }
 
 void Caches::clearTaskCache(taskIndex_t TaskIndex) {
+  ++settingsVersion;
   clearTaskIndexFromMaps(TaskIndex);
 
   auto it = extraTaskSettings_cache.find(TaskIndex);
@@ -39,12 +54,16 @@ void Caches::clearTaskCache(taskIndex_t TaskIndex) {
   if (it != extraTaskSettings_cache.end()) {
     extraTaskSettings_cache.erase(it);
   }
+  #if FEATURE_COMPILED_TEMPLATES
+  taskTemplates_cache.erase(TaskIndex);
+  #endif // if FEATURE_COMPILED_TEMPLATES
   updateActiveTaskUseSerial0();
 }
 
 void Caches::clearFileCaches()
 {
   fileExistsMap.clear();
+  fileContentChecksums.clear();
   fileCacheClearMoment = 0;
 }
 
@@ -243,6 +262,106 @@ bool Caches::enabledPluginStats(taskIndex_t TaskIndex, uint8_t rel_index)
 
 #endif // if FEATURE_PLUGIN_STATS
 
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+uint8_t Caches::getTaskSendOnChange(taskIndex_t TaskIndex)
+{
+  if (validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.sendOnChange;
+    }
+  }
+  return 0;
+}
+
+float Caches::getTaskDeviceDeadband(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.deadband[rel_index];
+    }
+  }
+  return 0.0f;
+}
+
+uint16_t Caches::getTaskSendOnChangeMaxInterval(taskIndex_t TaskIndex)
+{
+  if (validTaskIndex(TaskIndex)) {
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.sendOnChangeMaxInterval;
+    }
+  }
+  return 0;
+}
+
+bool Caches::getControllerIgnoreSendOnChange(controllerIndex_t index)
+{
+  if (!validControllerIndex(index)) { return false; }
+
+  if (!bitRead(controllerIgnoreSendOnChange_known, index)) {
+    MakeControllerSettings(ControllerSettings); //-V522
+
+    if (!AllocatedControllerSettings()) {
+      return false;
+    }
+
+    // Will also update the cached value
+    LoadControllerSettings(index, *ControllerSettings);
+  }
+  return bitRead(controllerIgnoreSendOnChange, index);
+}
+
+void Caches::setControllerIgnoreSendOnChange(controllerIndex_t index, bool value)
+{
+  if (validControllerIndex(index)) {
+    bitWrite(controllerIgnoreSendOnChange, index, value);
+    bitSet(controllerIgnoreSendOnChange_known, index);
+  }
+}
+
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+#if FEATURE_COMPILED_TEMPLATES
+
+// Find the compiled template, or compile and add it.
+static const CompiledTemplateStruct& getCompiledTemplate(CompiledTemplateMap& templates, const String& tmpl)
+{
+  auto it = templates.find(tmpl);
+
+  if (it != templates.end()) {
+    return it->second;
+  }
+
+  if (templates.size() >= COMPILED_TEMPLATES_MAX_PER_INDEX) {
+    // Probably templates which are changed all the time, so do not keep collecting them.
+    templates.clear();
+  }
+  return templates.emplace(tmpl, CompiledTemplateStruct(tmpl)).first->second;
+}
+
+const CompiledTemplateStruct& Caches::getControllerTemplate(controllerIndex_t index, const String& tmpl)
+{
+  ControllerTemplates_cache_t& cache = controllerTemplates_cache[index];
+
+  if (!(cache.checksum == controllerSettings_checksums[index])) {
+    cache.templates.clear();
+    cache.checksum = controllerSettings_checksums[index];
+  }
+  return getCompiledTemplate(cache.templates, tmpl);
+}
+
+const CompiledTemplateStruct& Caches::getTaskTemplate(taskIndex_t index, const String& tmpl)
+{
+  return getCompiledTemplate(taskTemplates_cache[index], tmpl);
+}
+
+#endif // if FEATURE_COMPILED_TEMPLATES
+
 
 void Caches::updateExtraTaskSettingsCache()
 {
@@ -284,7 +403,17 @@ void Caches::updateExtraTaskSettingsCache()
         bitSet(tmp.enabledPluginStats, i);
       }
       #endif // if FEATURE_PLUGIN_STATS
+      #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+      if (ExtraTaskSettings.sendOnChange(i)) {
+        bitSet(tmp.sendOnChange, i);
+      }
+      tmp.deadband[i] = ExtraTaskSettings.TaskDeviceDeadband[i];
+      #endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
     }
+    #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+    tmp.sendOnChangeMaxInterval = ExtraTaskSettings.SendOnChangeMaxInterval;
+    #endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
     #ifdef ESP32
     tmp.TaskDevicePluginConfigLong_index_used = 0;
     tmp.TaskDevicePluginConfig_index_used     = 0;
@@ -5,10 +5,13 @@
 #include "../../ESPEasy_common.h"
 #include "../CustomBuild/ESPEasyLimits.h"
 #include "../DataStructs/ChecksumType.h"
+#if FEATURE_COMPILED_TEMPLATES
+# include "../DataStructs/CompiledTemplateStruct.h"
+#endif // if FEATURE_COMPILED_TEMPLATES
 #ifdef ESP32
 # include "../DataStructs/ControllerSettingsStruct.h"
-# include "../DataTypes/ControllerIndex.h"
 #endif // ifdef ESP32
+#include "../DataTypes/ControllerIndex.h"
 #include "../Globals/Plugins.h"
 
 #include "../Helpers/RulesHelper.h"
@@ -45,18 +48,45 @@ struct ExtraTaskSettings_cache_t {
   #if FEATURE_PLUGIN_STATS
   uint8_t enabledPluginStats = 0;
   #endif // if FEATURE_PLUGIN_STATS
+  #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+  float    deadband[VARS_PER_TASK] = { 0 };
+  uint16_t sendOnChangeMaxInterval = 0;
+  uint8_t  sendOnChange            = 0;
+  #endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
   bool hasFormula = false;
 };
 
 typedef std::map<String, taskIndex_t>                    TaskIndexNameMap;
 typedef std::map<String, uint8_t>                        TaskIndexValueNameMap;
 typedef std::map<String, uint8_t>                        FilePresenceMap;
+
+// Checksum of the content of a file served by the web server, used as ETag.
+struct FileContentChecksum_t {
+  size_t   size = 0;
+  uint32_t crc  = 0;
+};
+typedef std::map<String, FileContentChecksum_t>          FileContentChecksumMap;
 typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
 
 #ifdef ESP32
 typedef std::map<controllerIndex_t, ControllerSettingsStruct> ControllerSettingsMap;
 #endif // ifdef ESP32
 
+#if FEATURE_COMPILED_TEMPLATES
+
+// Key is the template text
+typedef std::map<String, CompiledTemplateStruct> CompiledTemplateMap;
+
+struct ControllerTemplates_cache_t {
+  // Checksum of the controller settings when the templates were compiled
+  ChecksumType        checksum;
+  CompiledTemplateMap templates;
+};
+
+typedef std::map<controllerIndex_t, ControllerTemplates_cache_t> ControllerTemplatesMap;
+typedef std::map<taskIndex_t, CompiledTemplateMap>               TaskTemplatesMap;
+#endif // if FEATURE_COMPILED_TEMPLATES
+
 struct Caches {
   void    clearAllCaches();
   void    clearAllButTaskCaches();
@@ -97,6 +127,23 @@ struct Caches {
                           uint8_t     rel_index);
   #endif // if FEATURE_PLUGIN_STATS
 
+  #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+  // Bitmap of the task values with "Send On Change" checked
+  uint8_t  getTaskSendOnChange(taskIndex_t TaskIndex);
+
+  float    getTaskDeviceDeadband(taskIndex_t TaskIndex,
+                                 uint8_t     rel_index);
+
+  uint16_t getTaskSendOnChangeMaxInterval(taskIndex_t TaskIndex);
+
+  // Controller setting "Ignore Send On Change", which is needed for every call to sendData()
+  bool     getControllerIgnoreSendOnChange(controllerIndex_t index);
+
+  void     setControllerIgnoreSendOnChange(controllerIndex_t index,
+                                           bool              value);
+  #endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
 
   // Update all cached values, except the checksum.
   void updateExtraTaskSettingsCache();
@@ -106,6 +153,19 @@ struct Caches {
   // since only those functions know the checksum of what has been stored.
   void updateExtraTaskSettingsCache_afterLoad_Save();
 
+  #if FEATURE_COMPILED_TEMPLATES
+
+  // Compiled version of a template used by a controller, compiled on first use.
+  // All templates of the controller are discarded when its settings checksum changes.
+  const CompiledTemplateStruct& getControllerTemplate(controllerIndex_t index,
+                                                      const String    & tmpl);
+
+  // Compiled version of a template used by a task, like a display line.
+  // All templates of the task are discarded when the task cache is cleared.
+  const CompiledTemplateStruct& getTaskTemplate(taskIndex_t   index,
+                                                const String& tmpl);
+  #endif // if FEATURE_COMPILED_TEMPLATES
+
   #ifdef ESP32
   bool getControllerSettings(controllerIndex_t         index,
                              ControllerSettingsStruct& ControllerSettings) const;
@@ -124,10 +184,11 @@ private:
 
 public:
 
-  TaskIndexNameMap      taskIndexName;
-  TaskIndexValueNameMap taskIndexValueName;
-  FilePresenceMap       fileExistsMap;
-  RulesHelperClass      rulesHelper;
+  TaskIndexNameMap       taskIndexName;
+  TaskIndexValueNameMap  taskIndexValueName;
+  FilePresenceMap        fileExistsMap;
+  FileContentChecksumMap fileContentChecksums;
+  RulesHelperClass       rulesHelper;
 
 private:
 
@@ -139,11 +200,23 @@ private:
   ControllerSettingsMap controllerSetings_cache;
   #endif // ifdef ESP32
 
+  #if FEATURE_COMPILED_TEMPLATES
+  ControllerTemplatesMap controllerTemplates_cache;
+  TaskTemplatesMap       taskTemplates_cache;
+  #endif // if FEATURE_COMPILED_TEMPLATES
+
 public:
 
   ChecksumType controllerSettings_checksums[CONTROLLER_MAX] = {};
+  #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+  uint32_t controllerIgnoreSendOnChange_known = 0; // Bitmap of controllers with cached value
+  uint32_t controllerIgnoreSendOnChange       = 0;
+  #endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
   uint32_t     fileCacheClearMoment                         = 0;
 
+  // Incremented each time cached settings are cleared, used in the ETag of JSON replies.
+  uint32_t     settingsVersion                              = 0;
+
 
   bool activeTaskUseSerial0 = false;
 };
@@ -0,0 +1,297 @@
+#include "../DataStructs/CompiledTemplateStruct.h"
+
+#if FEATURE_COMPILED_TEMPLATES
+
+# include "../../_Plugin_Helper.h"
+
+# include "../DataStructs/ESPEasy_EventStruct.h"
+# include "../DataStructs/TimingStats.h"
+# include "../ESPEasyCore/ESPEasyRules.h"
+# include "../Globals/ExtraTaskSettings.h"
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/Misc.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/StringParser.h"
+
+
+CompiledTemplateStruct::CompiledTemplateStruct(const String& tmpl)
+{
+  _compiled = compile(tmpl);
+
+  if (!_compiled) {
+    _segments.clear();
+    _markers.clear();
+  }
+}
+
+String CompiledTemplateStruct::render(struct EventStruct *event, uint8_t minimal_lineSize, bool useURLencode) const
+{
+  START_TIMER;
+
+  // Keep current loaded taskSettings to restore at the end.
+  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
+  String newString;
+
+  newString.reserve(std::max(static_cast<size_t>(minimal_lineSize), _expectedSize));
+
+  // Position in newString and index in _segments of the event variables.
+  // These are filled in after the standard conversions, like parseEventVariables() is called after parseTemplate().
+  std::vector<std::pair<size_t, size_t> > eventSegments;
+
+  for (size_t i = 0; i < _segments.size(); ++i) {
+    const Segment& segment = _segments[i];
+
+    switch (segment.type) {
+      case SegmentType::Literal:
+        newString += segment.text;
+        break;
+      case SegmentType::SystemVariable:
+        appendValue(newString, SystemVariables::getTokenValue(segment.token), useURLencode);
+        break;
+      case SegmentType::TaskValueMarker:
+      {
+        const Marker& marker = _markers[segment.index];
+        String format        = marker.format;
+
+        // Markers with right justification are not compiled, so no need for the parsed template here.
+        parseTemplate_appendMarker(newString, minimal_lineSize, marker.deviceName, marker.valueName, format, EMPTY_STRING);
+
+        // This may have taken some time, so call delay()
+        delay(0);
+        break;
+      }
+      case SegmentType::EventId:
+      case SegmentType::EventTaskName:
+      case SegmentType::EventValue:
+      case SegmentType::EventValueName:
+
+        if (event != nullptr) {
+          eventSegments.emplace_back(newString.length(), i);
+        }
+        newString += segment.text;
+        break;
+    }
+  }
+
+  // Restore previous loaded taskSettings
+  if (!_markers.empty() && validTaskIndex(currentTaskIndex)) {
+    LoadTaskSettings(currentTaskIndex);
+  }
+
+  if ((newString.indexOf(F("%c_")) != -1) || (newString.indexOf('{') != -1)) {
+    // Same as parseTemplate_padded(), which also applies these to the values that were filled in.
+    parseStandardConversions(newString, useURLencode);
+    parse_string_commands(newString);
+
+    if (!eventSegments.empty()) {
+      // The event variables may have been moved, so replace them the slow way.
+      parseEventVariables(newString, event, useURLencode);
+    }
+  } else if (!eventSegments.empty()) {
+    String result;
+    result.reserve(newString.length() + 16 * eventSegments.size());
+    size_t copiedUpTo = 0;
+
+    for (const auto& eventSegment : eventSegments) {
+      const Segment& segment = _segments[eventSegment.second];
+      appendSubstring(result, newString, copiedUpTo, eventSegment.first);
+      appendEventVariable(result, segment, event, useURLencode);
+      copiedUpTo = eventSegment.first + segment.text.length();
+    }
+    appendSubstring(result, newString, copiedUpTo, newString.length());
+    newString = std::move(result);
+  }
+
+  // padding spaces
+  while (newString.length() < minimal_lineSize) {
+    newString += ' ';
+  }
+
+  STOP_TIMER(PARSE_TEMPLATE_COMPILED);
+  return newString;
+}
+
+void CompiledTemplateStruct::appendValue(String& dest, const String& value, bool useURLencode)
+{
+  if (useURLencode) {
+    dest += URLEncode(value);
+  } else {
+    dest += value;
+  }
+}
+
+void CompiledTemplateStruct::appendEventVariable(String             & dest,
+                                                 const Segment      & segment,
+                                                 struct EventStruct *event,
+                                                 bool                 useURLencode)
+{
+  switch (segment.type) {
+    case SegmentType::EventId:
+      appendValue(dest, String(event->idx), useURLencode);
+      return;
+    case SegmentType::EventTaskName:
+      appendValue(dest, getTaskDeviceName(event->TaskIndex), useURLencode);
+      return;
+    case SegmentType::EventValueName:
+      appendValue(dest, getTaskValueName(event->TaskIndex, segment.index), useURLencode);
+      return;
+    case SegmentType::EventValue:
+    {
+      const uint8_t valueCount = !validTaskIndex(event->TaskIndex)
+                                 ? 0
+                                 : (event->getSensorType() == Sensor_VType::SENSOR_TYPE_ULONG)
+                                 ? 1 : getValueCountForTask(event->TaskIndex);
+
+      if (segment.index < valueCount) {
+        appendValue(dest, formatUserVarNoCheck(event, segment.index), useURLencode);
+        return;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  // Not replaced by parseEventVariables() either.
+  dest += segment.text;
+}
+
+bool CompiledTemplateStruct::compile(const String& tmpl)
+{
+  // These are applied to the whole template by parseTemplate() and cannot be split in segments.
+  if (((tmpl.indexOf('{') != -1) && (tmpl.indexOf('}') != -1)) ||
+      ((tmpl.indexOf('&') != -1) && (tmpl.indexOf(';') != -1)) ||
+      (tmpl.indexOf(F("%c_")) != -1)) {
+    return false;
+  }
+
+  // Find all [...#...] markers, the same way parseTemplate_padded() does.
+  struct MarkerPos {
+    int start;
+    int end;
+  };
+  std::vector<MarkerPos> markerPositions;
+
+  if (tmpl.indexOf('[') != -1) {
+    int    startpos = 0;
+    int    endpos   = 0;
+    Marker marker;
+
+    while (findNextDevValNameInString(tmpl, startpos, endpos, marker.deviceName, marker.valueName, marker.format)) {
+      const int hashIndex = marker.format.indexOf('#');
+
+      if (marker.format.substring(0, hashIndex == -1 ? marker.format.length() : hashIndex).indexOf('R') != -1) {
+        // Right justification depends on the length of the parsed template.
+        return false;
+      }
+
+      if (_markers.size() >= 255) {
+        return false;
+      }
+      markerPositions.push_back({ startpos, endpos });
+      _markers.push_back(std::move(marker));
+      startpos = endpos + 1;
+    }
+  }
+
+  // Walk the template from '%' to '%', like SystemVariables::parseSystemVariables() does.
+  size_t nextMarker = 0;
+  int    copiedUpTo = 0;
+  int    startpos   = tmpl.indexOf('%');
+
+  auto addMarkersBefore = [&](int pos) {
+                            while (nextMarker < markerPositions.size() && markerPositions[nextMarker].end < pos) {
+                              addLiteral(tmpl, copiedUpTo, markerPositions[nextMarker].start);
+                              Segment segment;
+                              segment.type  = SegmentType::TaskValueMarker;
+                              segment.index = nextMarker;
+                              _segments.push_back(std::move(segment));
+                              copiedUpTo = markerPositions[nextMarker].end + 1;
+                              ++nextMarker;
+                            }
+                          };
+
+  while (startpos != -1) {
+    const int endpos = tmpl.indexOf('%', startpos + 1);
+
+    if (endpos == -1) {
+      break;
+    }
+    const char  *name   = tmpl.c_str() + startpos + 1;
+    const size_t length = endpos - startpos - 1;
+    Segment segment;
+
+    if (SystemVariables::parseToken(name, length, segment.token)) {
+      segment.type = SegmentType::SystemVariable;
+    } else if (parseEventVariable(name, length, segment.type, segment.index)) {
+      segment.text = tmpl.substring(startpos, endpos + 1);
+    } else {
+      // The closing '%' may be the start of the next token
+      startpos = endpos;
+      continue;
+    }
+
+    addMarkersBefore(startpos);
+
+    if ((nextMarker < markerPositions.size()) && (markerPositions[nextMarker].start <= endpos)) {
+      // Variable used inside a marker, which parseTemplate() replaces before looking for markers.
+      return false;
+    }
+    addLiteral(tmpl, copiedUpTo, startpos);
+    _segments.push_back(std::move(segment));
+    copiedUpTo = endpos + 1;
+    startpos   = tmpl.indexOf('%', copiedUpTo);
+  }
+  addMarkersBefore(tmpl.length());
+  addLiteral(tmpl, copiedUpTo, tmpl.length());
+
+  _expectedSize = tmpl.length() + 16;
+  return true;
+}
+
+void CompiledTemplateStruct::addLiteral(const String& tmpl, int start, int end)
+{
+  if (start >= end) {
+    return;
+  }
+  Segment segment;
+
+  segment.text = tmpl.substring(start, end);
+  _segments.push_back(std::move(segment));
+}
+
+bool CompiledTemplateStruct::parseEventVariable(const char *name, size_t length, SegmentType& type, uint8_t& index)
+{
+  // Parse a number 1 ... VARS_PER_TASK, without leading zeroes, starting at 'offset'
+  auto parseValueNr = [&](size_t offset, uint8_t maxValue) -> bool {
+                        if ((length != (offset + 1)) || (name[offset] < '1') || (name[offset] > ('0' + maxValue))) {
+                          return false;
+                        }
+                        index = name[offset] - '1';
+                        return true;
+                      };
+
+  if ((length == 2) && (strncmp_P(name, PSTR("id"), 2) == 0)) {
+    type = SegmentType::EventId;
+    return true;
+  }
+
+  if ((length == 7) && (strncmp_P(name, PSTR("tskname"), 7) == 0)) {
+    type = SegmentType::EventTaskName;
+    return true;
+  }
+
+  if ((length > 3) && (strncmp_P(name, PSTR("val"), 3) == 0) && parseValueNr(3, VARS_PER_TASK)) {
+    type = SegmentType::EventValue;
+    return true;
+  }
+
+  // parseEventVariables() only replaces %vname1% ... %vname4%
+  if ((length > 5) && (strncmp_P(name, PSTR("vname"), 5) == 0) && parseValueNr(5, 4)) {
+    type = SegmentType::EventValueName;
+    return true;
+  }
+  return false;
+}
+
+#endif // if FEATURE_COMPILED_TEMPLATES
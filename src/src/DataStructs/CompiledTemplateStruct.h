@@ -0,0 +1,110 @@
+#ifndef DATASTRUCTS_COMPILEDTEMPLATESTRUCT_H
+#define DATASTRUCTS_COMPILEDTEMPLATESTRUCT_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_COMPILED_TEMPLATES
+
+# include "../Helpers/SystemVariables.h"
+
+# include <vector>
+
+struct EventStruct;
+
+// Max. number of compiled templates kept per task or per controller.
+// When exceeded, all compiled templates of that task or controller are discarded.
+# ifndef COMPILED_TEMPLATES_MAX_PER_INDEX
+#  ifdef ESP8266
+#   define COMPILED_TEMPLATES_MAX_PER_INDEX  16
+#  else // ifdef ESP8266
+#   define COMPILED_TEMPLATES_MAX_PER_INDEX  32
+#  endif // ifdef ESP8266
+# endif // ifndef COMPILED_TEMPLATES_MAX_PER_INDEX
+
+
+/*********************************************************************************************\
+* CompiledTemplateStruct
+*
+* A template string like "%sysname%/%tskname%/%valname%" or "Temp: [bme#temp#D.1]",
+* split once into a list of literal texts and variables.
+* Rendering only has to look up the variables, instead of searching the whole template
+* for every system variable known to the firmware.
+*
+* Supported are system variables, %vN%, [task#value#format] markers and
+* the controller event variables %id%, %tskname%, %valN% and %vnameN%.
+* %valname% is kept as-is, as it is replaced per task value by the controllers.
+* Templates using other features (special characters, standard conversions, string commands,
+* right justified markers) are not compiled and must be handled by parseTemplate().
+\*********************************************************************************************/
+struct CompiledTemplateStruct {
+  CompiledTemplateStruct() = default;
+
+  explicit CompiledTemplateStruct(const String& tmpl);
+
+  // Return false when the template must be handled by parseTemplate()
+  bool isCompiled() const {
+    return _compiled;
+  }
+
+  // Equivalent of parseTemplate_padded(), followed by parseEventVariables() when event is not nullptr.
+  String render(struct EventStruct *event,
+                uint8_t             minimal_lineSize,
+                bool                useURLencode) const;
+
+private:
+
+  enum class SegmentType : uint8_t {
+    Literal,
+    SystemVariable,
+    TaskValueMarker,
+    EventId,
+    EventTaskName,
+    EventValue,
+    EventValueName
+  };
+
+  struct Segment {
+    // Literal text, or the original text of an event variable, used when there is no event.
+    String                 text;
+    SystemVariables::Token token;
+    SegmentType            type  = SegmentType::Literal;
+    uint8_t                index = 0; // Index in _markers or task value index
+  };
+
+  struct Marker {
+    String deviceName;
+    String valueName;
+    String format;
+  };
+
+  bool compile(const String& tmpl);
+
+  void addLiteral(const String& tmpl,
+                  int           start,
+                  int           end);
+
+  // Parse %id%, %tskname%, %valN% and %vnameN%
+  static bool parseEventVariable(const char *name,
+                                 size_t      length,
+                                 SegmentType& type,
+                                 uint8_t    & index);
+
+  static void appendValue(String      & dest,
+                          const String& value,
+                          bool          useURLencode);
+
+  // Append the value of an event variable, or its original text when parseEventVariables() would not replace it.
+  static void appendEventVariable(String             & dest,
+                                  const Segment      & segment,
+                                  struct EventStruct *event,
+                                  bool                 useURLencode);
+
+  std::vector<Segment> _segments;
+  std::vector<Marker>  _markers;
+  size_t               _expectedSize = 0;
+  bool                 _compiled     = false;
+};
+
+#endif // if FEATURE_COMPILED_TEMPLATES
+
+#endif // ifndef DATASTRUCTS_COMPILEDTEMPLATESTRUCT_H
@@ -64,6 +64,12 @@ void ControllerSettingsStruct::validate() {
   if ((ClientTimeout < 10) || (ClientTimeout > CONTROLLER_CLIENTTIMEOUT_MAX)) {
     ClientTimeout = CONTROLLER_CLIENTTIMEOUT_DFLT;
   }
+  if (BatchMaxSize > CONTROLLER_BATCH_MAX_SIZE_MAX) { BatchMaxSize = 0; }
+
+  if (BatchMaxAge > CONTROLLER_BATCH_MAX_AGE_MAX) { BatchMaxAge = 0; }
+
+  if (MaxQueueSize > CONTROLLER_DELAY_QUEUE_MAX_BYTES_MAX) { MaxQueueSize = 0; }
+
   ZERO_TERMINATE(HostName);
   ZERO_TERMINATE(Publish);
   ZERO_TERMINATE(Subscribe);
@@ -73,6 +79,27 @@ void ControllerSettingsStruct::validate() {
 }
 
 
+uint16_t ControllerSettingsStruct::getBatchMaxSize() const {
+  if ((BatchMaxSize == 0) || (BatchMaxSize > CONTROLLER_BATCH_MAX_SIZE_MAX)) {
+    return CONTROLLER_BATCH_MAX_SIZE_DFLT;
+  }
+  return BatchMaxSize;
+}
+
+uint16_t ControllerSettingsStruct::getBatchMaxAge() const {
+  if ((BatchMaxAge == 0) || (BatchMaxAge > CONTROLLER_BATCH_MAX_AGE_MAX)) {
+    return CONTROLLER_BATCH_MAX_AGE_DFLT;
+  }
+  return BatchMaxAge;
+}
+
+uint32_t ControllerSettingsStruct::getMaxQueueSize() const {
+  if ((MaxQueueSize == 0) || (MaxQueueSize > CONTROLLER_DELAY_QUEUE_MAX_BYTES_MAX)) {
+    return CONTROLLER_DELAY_QUEUE_MAX_BYTES;
+  }
+  return MaxQueueSize;
+}
+
 String ControllerSettingsStruct::getHost() const {
   if (UseDNS) {
     return HostName;
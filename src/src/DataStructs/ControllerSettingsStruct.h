@@ -41,6 +41,64 @@
 # define CONTROLLER_DELAY_QUEUE_RETRY_DFLT  10
 #endif // ifndef CONTROLLER_DELAY_QUEUE_RETRY_DFLT
 
+// Max. number of MQTT messages published in one run of the MQTT delay queue, when "Batch Publish" is enabled
+#ifndef CONTROLLER_DELAY_QUEUE_BATCH_SIZE
+# define CONTROLLER_DELAY_QUEUE_BATCH_SIZE   10
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BATCH_SIZE
+
+// Max. number of bytes (topic + payload) published in one run of the MQTT delay queue, when "Batch Publish" is enabled
+#ifndef CONTROLLER_DELAY_QUEUE_BATCH_BYTES
+# define CONTROLLER_DELAY_QUEUE_BATCH_BYTES  2048
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BATCH_BYTES
+
+// Max. memory in bytes used by the elements of a single controller queue, on top of the "Max Queue Depth" element count.
+// Used when "Max Queue Size" is not set for the controller.
+// Set to 0 to only limit the number of elements.
+#ifndef CONTROLLER_DELAY_QUEUE_MAX_BYTES
+# define CONTROLLER_DELAY_QUEUE_MAX_BYTES   0
+#endif // ifndef CONTROLLER_DELAY_QUEUE_MAX_BYTES
+#ifndef CONTROLLER_DELAY_QUEUE_MAX_BYTES_MAX
+# ifdef ESP8266
+#  define CONTROLLER_DELAY_QUEUE_MAX_BYTES_MAX  16384
+# else // ifdef ESP8266
+#  define CONTROLLER_DELAY_QUEUE_MAX_BYTES_MAX  131072
+# endif // ifdef ESP8266
+#endif // ifndef CONTROLLER_DELAY_QUEUE_MAX_BYTES_MAX
+
+// Limits of the time between messages in msec, when "Adaptive Send Interval" is enabled.
+// The interval is decreased by CONTROLLER_DELAY_QUEUE_ADAPTIVE_STEP after each successful send
+// and doubled after a failed send.
+// The interval starts at the controller's "Minimum Send Interval".
+#ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_MIN
+# define CONTROLLER_DELAY_QUEUE_ADAPTIVE_MIN   10
+#endif // ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_MIN
+#ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_MAX
+# define CONTROLLER_DELAY_QUEUE_ADAPTIVE_MAX   30000
+#endif // ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_MAX
+#ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_STEP
+# define CONTROLLER_DELAY_QUEUE_ADAPTIVE_STEP  10
+#endif // ifndef CONTROLLER_DELAY_QUEUE_ADAPTIVE_STEP
+
+// Max. size in bytes of a request body collecting several messages, when "Batch Framing" is set.
+#ifndef CONTROLLER_BATCH_MAX_SIZE_DFLT
+# define CONTROLLER_BATCH_MAX_SIZE_DFLT        1024
+#endif // ifndef CONTROLLER_BATCH_MAX_SIZE_DFLT
+#ifndef CONTROLLER_BATCH_MAX_SIZE_MAX
+# ifdef ESP8266
+#  define CONTROLLER_BATCH_MAX_SIZE_MAX        4096
+# else // ifdef ESP8266
+#  define CONTROLLER_BATCH_MAX_SIZE_MAX        16384
+# endif // ifdef ESP8266
+#endif // ifndef CONTROLLER_BATCH_MAX_SIZE_MAX
+
+// Max. time in msec to collect messages in a single request body, before it is sent.
+#ifndef CONTROLLER_BATCH_MAX_AGE_DFLT
+# define CONTROLLER_BATCH_MAX_AGE_DFLT         5000
+#endif // ifndef CONTROLLER_BATCH_MAX_AGE_DFLT
+#ifndef CONTROLLER_BATCH_MAX_AGE_MAX
+# define CONTROLLER_BATCH_MAX_AGE_MAX          60000
+#endif // ifndef CONTROLLER_BATCH_MAX_AGE_MAX
+
 // Timeout of the client in msec.
 #ifndef CONTROLLER_CLIENTTIMEOUT_MAX
 # define CONTROLLER_CLIENTTIMEOUT_MAX     4000 // Not sure if this may trigger SW watchdog.
@@ -88,6 +146,15 @@ struct ControllerSettingsStruct
     CONTROLLER_TIMEOUT,
     CONTROLLER_SAMPLE_SET_INITIATOR,
     CONTROLLER_SEND_BINARY,
+    CONTROLLER_BATCH_PUBLISH,
+    CONTROLLER_AGGREGATE_VALUES,
+    CONTROLLER_SPILL_TO_FLASH,
+    CONTROLLER_ADAPTIVE_SEND_INTERVAL,
+    CONTROLLER_BATCH_FRAMING,
+    CONTROLLER_BATCH_MAX_SIZE,
+    CONTROLLER_BATCH_MAX_AGE,
+    CONTROLLER_IGNORE_SEND_ON_CHANGE,
+    CONTROLLER_MAX_QUEUE_SIZE,
 
     // Keep this as last, is used to loop over all parameters
     CONTROLLER_ENABLED
@@ -155,6 +222,41 @@ struct ControllerSettingsStruct
   bool         useLocalSystemTime() const { return VariousBits1.useLocalSystemTime; }
   void         useLocalSystemTime(bool value) { VariousBits1.useLocalSystemTime = value; }
 
+  bool         mqtt_batchPublish() const { return VariousBits1.mqtt_batchPublish; }
+  void         mqtt_batchPublish(bool value) { VariousBits1.mqtt_batchPublish = value; }
+
+  bool         mqtt_aggregateValues() const { return VariousBits1.mqtt_aggregateValues; }
+  void         mqtt_aggregateValues(bool value) { VariousBits1.mqtt_aggregateValues = value; }
+
+  bool         spillToFlash() const { return VariousBits1.spillToFlash; }
+  void         spillToFlash(bool value) { VariousBits1.spillToFlash = value; }
+
+  bool         adaptiveSendInterval() const { return VariousBits1.adaptiveSendInterval; }
+  void         adaptiveSendInterval(bool value) { VariousBits1.adaptiveSendInterval = value; }
+
+  // Receive all task values, regardless of the "Send On Change" settings of the task values.
+  bool         ignoreSendOnChange() const { return VariousBits1.ignoreSendOnChange; }
+  void         ignoreSendOnChange(bool value) { VariousBits1.ignoreSendOnChange = value; }
+
+  // How to combine several messages in a single request body.
+  enum class BatchFraming_e : uint8_t {
+    None      = 0, // Send each message in its own request
+    Lines     = 1, // One message per line, like InfluxDB line protocol
+    JSONArray = 2  // Messages as elements of a JSON array
+  };
+
+  BatchFraming_e batchFraming() const { return static_cast<BatchFraming_e>(VariousBits1.batchFraming); }
+  void           batchFraming(BatchFraming_e value) { VariousBits1.batchFraming = static_cast<uint32_t>(value); }
+
+  // Max. size of the batched request body in bytes, default value when not set.
+  uint16_t       getBatchMaxSize() const;
+
+  // Max. time in msec to collect messages in a request body, default value when not set.
+  uint16_t       getBatchMaxAge() const;
+
+  // Max. memory in bytes used by the queued elements, 0 = no limit.
+  uint32_t       getMaxQueueSize() const;
+
   bool         UseDNS;
   uint8_t      IP[4];
   unsigned int Port;
@@ -186,13 +288,12 @@ struct ControllerSettingsStruct
       uint32_t allowExpire                      : 1; // Bit 09
       uint32_t deduplicate                      : 1; // Bit 10
       uint32_t useLocalSystemTime               : 1; // Bit 11
-      uint32_t unused_12                        : 1; // Bit 12
-      uint32_t unused_13                        : 1; // Bit 13
-      uint32_t unused_14                        : 1; // Bit 14
-      uint32_t unused_15                        : 1; // Bit 15
-      uint32_t unused_16                        : 1; // Bit 16
-      uint32_t unused_17                        : 1; // Bit 17
-      uint32_t unused_18                        : 1; // Bit 18
+      uint32_t mqtt_batchPublish                : 1; // Bit 12
+      uint32_t mqtt_aggregateValues             : 1; // Bit 13
+      uint32_t spillToFlash                     : 1; // Bit 14
+      uint32_t adaptiveSendInterval             : 1; // Bit 15
+      uint32_t batchFraming                     : 2; // Bit 16 & 17
+      uint32_t ignoreSendOnChange               : 1; // Bit 18
       uint32_t unused_19                        : 1; // Bit 19
       uint32_t unused_20                        : 1; // Bit 20
       uint32_t unused_21                        : 1; // Bit 21
@@ -210,6 +311,9 @@ struct ControllerSettingsStruct
     uint32_t VariousFlags;                           // Various flags
   };
   char ClientID[65];                                 // Used to define the Client ID used by the controller
+  uint16_t BatchMaxSize;                             // Max. size of a batched request body, 0 = default
+  uint16_t BatchMaxAge;                              // Max. time in msec to collect messages in a batched request body, 0 = default
+  uint32_t MaxQueueSize;                             // Max. memory in bytes used by the queued elements, 0 = default
 
 private:
 
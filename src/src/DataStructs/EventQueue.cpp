@@ -12,9 +12,7 @@ void EventQueueStruct::add(const String& event, bool deduplicate)
   HeapSelectIram ephemeral;
   #endif // ifdef USE_SECOND_HEAP
 
-  if (!deduplicate || !isDuplicate(event)) {
-    _eventQueue.push_back(event);
-  }
+  pushText(String(event), deduplicate);
 }
 
 void EventQueueStruct::add(const __FlashStringHelper *event, bool deduplicate)
@@ -24,9 +22,7 @@ void EventQueueStruct::add(const __FlashStringHelper *event, bool deduplicate)
   #endif // ifdef USE_SECOND_HEAP
 
   // Wrap in String() constructor to make sure it is using the 2nd heap allocator if present.
-  if (!deduplicate || !isDuplicate(event)) {
-    _eventQueue.push_back(String(event));
-  }
+  pushText(String(event), deduplicate);
 }
 
 void EventQueueStruct::addMove(String&& event, bool deduplicate)
@@ -37,31 +33,54 @@ void EventQueueStruct::addMove(String&& event, bool deduplicate)
 
   if (!mmu_is_iram(&(event[0]))) {
     // Wrap in String constructor to make sure it is stored in the 2nd heap.
-    if (!deduplicate || !isDuplicate(event)) {
-      _eventQueue.push_back(String(event));
-    }
+    pushText(String(event), deduplicate);
     return;
   }
   #endif // ifdef USE_SECOND_HEAP
 
-  if (!deduplicate || !isDuplicate(event)) {
-    _eventQueue.emplace_back(std::move(event));
-  }
+  pushText(std::move(event), deduplicate);
 }
 
 void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const String& eventValue)
 {
   if (Settings.UseRules) {
-    String eventCommand = getTaskDeviceName(TaskIndex);
-    eventCommand.reserve(eventCommand.length() + 2 + varName.length() + eventValue.length());
-    eventCommand += '#';
-    eventCommand += varName;
-
-    if (!eventValue.isEmpty()) {
-      eventCommand += '='; // Add arguments
-      eventCommand += eventValue;
+    #ifdef USE_SECOND_HEAP
+    HeapSelectIram ephemeral;
+    #endif // ifdef USE_SECOND_HEAP
+
+    String taskName = getTaskDeviceName(TaskIndex);
+    const int taskNameId = validTaskIndex(TaskIndex) ? getNameId(taskName) : -1;
+    const int nameId     = (taskNameId < 0) ? -1 : getNameId(varName);
+
+    if (nameId < 0) {
+      // Cannot store as task event, store the full event string.
+      String eventCommand = std::move(taskName);
+      eventCommand.reserve(eventCommand.length() + 2 + varName.length() + eventValue.length());
+      eventCommand += '#';
+      eventCommand += varName;
+
+      if (!eventValue.isEmpty()) {
+        eventCommand += '='; // Add arguments
+        eventCommand += eventValue;
+      }
+      pushText(std::move(eventCommand), false);
+      return;
     }
-    addMove(std::move(eventCommand));
+
+    EventQueueElement *element = allocateElement();
+
+    if (element == nullptr) {
+      if (!coalesce(TaskIndex, taskNameId, nameId, eventValue)) {
+        ++_nrDropped;
+      }
+      return;
+    }
+    element->_value      = eventValue;
+    element->_hash       = computeHash(taskNameId, nameId, eventValue);
+    element->_taskIndex  = TaskIndex;
+    element->_taskNameId = taskNameId;
+    element->_nameId     = nameId;
+    addPendingHash(element->_hash);
   }
 }
 
@@ -88,33 +107,279 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *var
 
 bool EventQueueStruct::getNext(String& event)
 {
-  if (_eventQueue.empty()) {
+  if (_count == 0) {
     return false;
   }
+  EventQueueElement& element = _elements[_head];
+
   #ifdef USE_SECOND_HEAP
   {
     // Fetch the event and make sure it is allocated on the DRAM heap, not the 2nd heap
     // Otherwise checks like strnlen_P may crash on it.
     HeapSelectDram ephemeral;
-    event = std::move(String(_eventQueue.front()));
+
+    if (element.isTaskEvent()) {
+      event = toString(element);
+    } else {
+      event = std::move(String(element._value));
+    }
   }
   #else // ifdef USE_SECOND_HEAP
-  event = std::move(_eventQueue.front());
+
+  if (element.isTaskEvent()) {
+    event = toString(element);
+  } else {
+    event = std::move(element._value);
+  }
   #endif // ifdef USE_SECOND_HEAP
-  _eventQueue.pop_front();
+
+  removePendingHash(element._hash);
+
+  // Clear the element, so its memory is freed.
+  element = EventQueueElement();
+
+  ++_head;
+
+  if (_head >= _elements.size()) {
+    _head = 0;
+  }
+  --_count;
+
+  if ((_count == 0) &&
+      ((_elements.size() > EVENT_QUEUE_INITIAL_SIZE) || (_eventNames.size() >= EVENT_QUEUE_MAX_NAMES))) {
+    // A burst of events has been processed, release the memory.
+    clear();
+  }
   return true;
 }
 
 void EventQueueStruct::clear()
 {
-  _eventQueue.clear();
+  _elements.clear();
+  _elements.shrink_to_fit();
+  _head  = 0;
+  _count = 0;
+  _pendingHashes.clear();
+
+  if (_eventNames.size() >= EVENT_QUEUE_MAX_NAMES) {
+    // No event refers to the names anymore, so start over.
+    _eventNames.clear();
+  }
 }
 
 bool EventQueueStruct::isEmpty() const
 {
-  return _eventQueue.empty();
+  return _count == 0;
 }
 
-bool EventQueueStruct::isDuplicate(const String& event) {
-  return std::find(_eventQueue.begin(), _eventQueue.end(), event) != _eventQueue.end();
+void EventQueueStruct::resetStats()
+{
+  _nrDropped   = 0;
+  _nrCoalesced = 0;
+}
+
+uint32_t EventQueueStruct::updateHash(uint32_t hash, char c)
+{
+  // FNV-1a hash
+  hash ^= static_cast<uint8_t>(c);
+  hash *= 16777619u;
+  return hash;
+}
+
+uint32_t EventQueueStruct::updateHash(uint32_t hash, const String& str)
+{
+  for (std::size_t i = 0; i < str.length(); ++i) {
+    hash = updateHash(hash, str[i]);
+  }
+  return hash;
+}
+
+uint32_t EventQueueStruct::computeHash(const String& event)
+{
+  return updateHash(2166136261u, event);
+}
+
+uint32_t EventQueueStruct::computeHash(uint8_t taskNameId, uint8_t nameId, const String& eventValue) const
+{
+  // Same as computeHash() of the string composed by toString()
+  uint32_t hash = updateHash(2166136261u, _eventNames[taskNameId]);
+
+  hash = updateHash(hash, '#');
+  hash = updateHash(hash, _eventNames[nameId]);
+
+  if (!eventValue.isEmpty()) {
+    hash = updateHash(hash, '=');
+    hash = updateHash(hash, eventValue);
+  }
+  return hash;
+}
+
+bool EventQueueStruct::isDuplicate(const String& event, uint32_t hash) const {
+  if (_pendingHashes.find(hash) != _pendingHashes.end()) {
+    // Make sure it is not a hash collision.
+    for (std::size_t i = 0; i < _count; ++i) {
+      const EventQueueElement& element = at(i);
+
+      if ((element._hash == hash) && matches(element, event)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool EventQueueStruct::coalesce(taskIndex_t TaskIndex, uint8_t taskNameId, uint8_t nameId, const String& eventValue)
+{
+  #if EVENT_QUEUE_COALESCE_WHEN_FULL
+
+  for (std::size_t i = _count; i > 0; --i) {
+    EventQueueElement& element = at(i - 1);
+
+    if ((element._taskIndex == TaskIndex) &&
+        (element._taskNameId == taskNameId) &&
+        (element._nameId == nameId)) {
+      removePendingHash(element._hash);
+      element._value = eventValue;
+      element._hash  = computeHash(taskNameId, nameId, eventValue);
+      addPendingHash(element._hash);
+      ++_nrCoalesced;
+      return true;
+    }
+  }
+  #endif // if EVENT_QUEUE_COALESCE_WHEN_FULL
+  return false;
+}
+
+void EventQueueStruct::addPendingHash(uint32_t hash)
+{
+  ++_pendingHashes[hash];
+}
+
+void EventQueueStruct::removePendingHash(uint32_t hash)
+{
+  auto it = _pendingHashes.find(hash);
+
+  if (it != _pendingHashes.end()) {
+    if (it->second <= 1) {
+      _pendingHashes.erase(it);
+    } else {
+      --(it->second);
+    }
+  }
+}
+
+bool EventQueueStruct::matches(const EventQueueElement& element, const String& event) const
+{
+  if (!element.isTaskEvent()) {
+    return element._value.equals(event);
+  }
+
+  // Compare the "#varName=eventvalue" part first, as it is most likely to differ.
+  const String& varName = _eventNames[element._nameId];
+  std::size_t   suffixLength = 1 + varName.length();
+
+  if (!element._value.isEmpty()) {
+    suffixLength += 1 + element._value.length();
+  }
+
+  if (event.length() < suffixLength) {
+    return false;
+  }
+  const std::size_t taskNameLength = event.length() - suffixLength;
+
+  if ((event[taskNameLength] != '#') ||
+      (strncmp(event.c_str() + taskNameLength + 1, varName.c_str(), varName.length()) != 0)) {
+    return false;
+  }
+
+  if (!element._value.isEmpty()) {
+    const std::size_t valuePos = taskNameLength + 1 + varName.length();
+
+    if ((event[valuePos] != '=') ||
+        (strcmp(event.c_str() + valuePos + 1, element._value.c_str()) != 0)) {
+      return false;
+    }
+  }
+  const String& taskName = _eventNames[element._taskNameId];
+
+  return (taskName.length() == taskNameLength) &&
+         (strncmp(event.c_str(), taskName.c_str(), taskNameLength) == 0);
+}
+
+String EventQueueStruct::toString(const EventQueueElement& element) const
+{
+  const String& varName = _eventNames[element._nameId];
+  String eventCommand   = _eventNames[element._taskNameId];
+
+  eventCommand.reserve(eventCommand.length() + 2 + varName.length() + element._value.length());
+  eventCommand += '#';
+  eventCommand += varName;
+
+  if (!element._value.isEmpty()) {
+    eventCommand += '='; // Add arguments
+    eventCommand += element._value;
+  }
+  return eventCommand;
+}
+
+int EventQueueStruct::getNameId(const String& name)
+{
+  for (std::size_t i = 0; i < _eventNames.size(); ++i) {
+    if (_eventNames[i].equals(name)) {
+      return i;
+    }
+  }
+
+  if (_eventNames.size() >= EVENT_QUEUE_MAX_NAMES) {
+    return -1;
+  }
+  _eventNames.push_back(name);
+  return _eventNames.size() - 1;
+}
+
+EventQueueElement * EventQueueStruct::allocateElement()
+{
+  if (_count >= _elements.size()) {
+    if (_elements.size() >= EVENT_QUEUE_MAX_SIZE) {
+      return nullptr;
+    }
+
+    // Grow the ring buffer and move the elements to keep them in order.
+    std::size_t newSize = _elements.empty() ? EVENT_QUEUE_INITIAL_SIZE : 2 * _elements.size();
+
+    if (newSize > EVENT_QUEUE_MAX_SIZE) {
+      newSize = EVENT_QUEUE_MAX_SIZE;
+    }
+    std::vector<EventQueueElement> newElements;
+    newElements.resize(newSize);
+
+    for (std::size_t i = 0; i < _count; ++i) {
+      newElements[i] = std::move(at(i));
+    }
+    _elements.swap(newElements);
+    _head = 0;
+  }
+  EventQueueElement& element = at(_count);
+
+  ++_count;
+  return &element;
+}
+
+void EventQueueStruct::pushText(String&& event, bool deduplicate)
+{
+  const uint32_t hash = computeHash(event);
+
+  if (deduplicate && isDuplicate(event, hash)) {
+    return;
+  }
+  EventQueueElement *element = allocateElement();
+
+  if (element == nullptr) {
+    // Do not overwrite another pending event, as it may have a different meaning.
+    ++_nrDropped;
+    return;
+  }
+  element->_value = std::move(event);
+  element->_hash  = hash;
+  addPendingHash(hash);
 }
@@ -2,11 +2,60 @@
 #define DATASTRUCTS_EVENTQUEUE_H
 
 
-#include <list>
+#include <map>
+#include <vector>
 
 
 #include "../Globals/Plugins.h"
 
+// Max. number of events kept in the queue.
+// Memory for the queue is allocated when needed, up to this number of events.
+#ifndef EVENT_QUEUE_MAX_SIZE
+# ifdef ESP8266
+#  define EVENT_QUEUE_MAX_SIZE  128
+# else // ifdef ESP8266
+#  define EVENT_QUEUE_MAX_SIZE  256
+# endif // ifdef ESP8266
+#endif // ifndef EVENT_QUEUE_MAX_SIZE
+
+#define EVENT_QUEUE_INITIAL_SIZE 8
+
+// When the queue is full, replace the value of a pending task event with the same
+// task and value name instead of dropping the new event.
+// Other events are dropped when the queue is full, as only their full text is known.
+#ifndef EVENT_QUEUE_COALESCE_WHEN_FULL
+# define EVENT_QUEUE_COALESCE_WHEN_FULL 1
+#endif // ifndef EVENT_QUEUE_COALESCE_WHEN_FULL
+
+// Max. number of distinct task and value names kept for task events.
+#define EVENT_QUEUE_MAX_NAMES    64
+
+
+// Event as stored in the queue.
+// Task events (Taskname#varName=eventvalue) are stored as task index,
+// indices in the table of names for the task name and varName and the event value(s).
+// The task name is looked up when the event is added, so renaming or deleting
+// the task does not affect pending events.
+// The event string is only composed when the event is taken from the queue.
+// Other events are stored as-is.
+struct EventQueueElement {
+  EventQueueElement() = default;
+
+  bool isTaskEvent() const {
+    return _taskIndex != INVALID_TASK_INDEX;
+  }
+
+  // Task event: eventvalue(s), may be empty
+  // Other events: the full event
+  String      _value;
+
+  // Hash of the full event, for task events as if the event string was composed.
+  uint32_t    _hash       = 0;
+  taskIndex_t _taskIndex  = INVALID_TASK_INDEX;
+  uint8_t     _taskNameId = 0;
+  uint8_t     _nameId     = 0;
+};
+
 
 struct EventQueueStruct {
   EventQueueStruct() = default;
@@ -33,14 +82,86 @@ struct EventQueueStruct {
   bool        isEmpty() const;
 
   std::size_t size() {
-    return _eventQueue.size();
+    return _count;
+  }
+
+  // Number of events dropped or coalesced since the last call to resetStats()
+  uint32_t getNrDropped() const {
+    return _nrDropped;
   }
 
+  uint32_t getNrCoalesced() const {
+    return _nrCoalesced;
+  }
+
+  void     resetStats();
+
 private:
 
-  bool isDuplicate(const String& event);
+  static uint32_t computeHash(const String& event);
+
+  // Continue an FNV-1a hash with the characters of str.
+  static uint32_t updateHash(uint32_t      hash,
+                             const String& str);
+
+  static uint32_t updateHash(uint32_t hash,
+                             char     c);
+
+  // Hash of the event string the task event will result in.
+  uint32_t computeHash(uint8_t       taskNameId,
+                       uint8_t       nameId,
+                       const String& eventValue) const;
+
+  bool   isDuplicate(const String& event,
+                     uint32_t      hash) const;
+
+  // Try to replace the value of the most recent pending task event with the same name.
+  bool   coalesce(taskIndex_t TaskIndex,
+                  uint8_t     taskNameId,
+                  uint8_t     nameId,
+                  const String& eventValue);
+
+  void   addPendingHash(uint32_t hash);
+
+  void   removePendingHash(uint32_t hash);
+
+  // Check whether the element would result in the given event string.
+  bool   matches(const EventQueueElement& element,
+                 const String           & event) const;
+
+  String toString(const EventQueueElement& element) const;
+
+  // Return the id of the task or value name, or -1 when the table is full.
+  int    getNameId(const String& name);
+
+  // Return a free element at the end of the queue, or nullptr when the queue is full.
+  EventQueueElement* allocateElement();
+
+  EventQueueElement& at(std::size_t index) {
+    return _elements[(_head + index) % _elements.size()];
+  }
+
+  const EventQueueElement& at(std::size_t index) const {
+    return _elements[(_head + index) % _elements.size()];
+  }
+
+  void   pushText(String&& event,
+                  bool     deduplicate);
+
+  // Ring buffer, the first element is at _head
+  std::vector<EventQueueElement>_elements;
+  std::size_t                   _head  = 0;
+  std::size_t                   _count = 0;
+
+  // Interned task and value names of task events
+  std::vector<String>_eventNames;
+
+  // Hashes of all pending events, with the number of pending events per hash.
+  // Used to quickly check for duplicates.
+  std::map<uint32_t, uint16_t>_pendingHashes;
 
-  std::list<String>_eventQueue;
+  uint32_t    _nrDropped    = 0;
+  uint32_t    _nrCoalesced  = 0;
 };
 
 
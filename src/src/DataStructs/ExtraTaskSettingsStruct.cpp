@@ -5,7 +5,7 @@
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_Plugin.h"
 
-#define EXTRA_TASK_SETTINGS_VERSION 1
+#define EXTRA_TASK_SETTINGS_VERSION 2
 
 
 void ExtraTaskSettingsStruct::clear() {
@@ -26,6 +26,11 @@ void ExtraTaskSettingsStruct::validate() {
   for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
     ZERO_TERMINATE(TaskDeviceFormula[i]);
     ZERO_TERMINATE(TaskDeviceValueNames[i]);
+
+    if (!(TaskDeviceDeadband[i] >= 0.0f)) {
+      // Negative or NaN
+      TaskDeviceDeadband[i] = 0.0f;
+    }
   }
 
   if (dummy1 != 0) {
@@ -44,6 +49,13 @@ void ExtraTaskSettingsStruct::validate() {
         VariousBits[i]          = 0u;
       }
     }
+
+    if (version < 2) {
+      for (uint8_t i = 0; i < VARS_PER_TASK; ++i) {
+        TaskDeviceDeadband[i] = 0.0f;
+      }
+      SendOnChangeMaxInterval = 0;
+    }
     version = EXTRA_TASK_SETTINGS_VERSION;
   }
 }
@@ -73,6 +85,7 @@ void ExtraTaskSettingsStruct::clearUnusedValueNames(uint8_t usedVars) {
     setIgnoreRangeCheck(i);
     TaskDeviceErrorValue[i] = 0.0f;
     VariousBits[i]          = 0;
+    TaskDeviceDeadband[i]   = 0.0f;
   }
 }
 
@@ -216,6 +229,19 @@ bool ExtraTaskSettingsStruct::anyEnabledPluginStats() const
 
 #endif // if FEATURE_PLUGIN_STATS
 
+bool ExtraTaskSettingsStruct::sendOnChange(taskVarIndex_t taskVarIndex) const
+{
+  if (!validTaskVarIndex(taskVarIndex)) { return false; }
+  return bitRead(VariousBits[taskVarIndex], 2);
+}
+
+void ExtraTaskSettingsStruct::sendOnChange(taskVarIndex_t taskVarIndex, bool enabled)
+{
+  if (validTaskVarIndex(taskVarIndex)) {
+    bitWrite(VariousBits[taskVarIndex], 2, enabled);
+  }
+}
+
 bool ExtraTaskSettingsStruct::isDefaultTaskVarName(taskVarIndex_t taskVarIndex) const
 {
   if (!validTaskVarIndex(taskVarIndex)) { return false; }
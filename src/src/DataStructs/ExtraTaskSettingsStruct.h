@@ -61,6 +61,11 @@ struct ExtraTaskSettingsStruct
   bool          anyEnabledPluginStats() const;
 #endif // if FEATURE_PLUGIN_STATS
 
+  // Only send the task to controllers when this value changed more than TaskDeviceDeadband.
+  bool          sendOnChange(taskVarIndex_t taskVarIndex) const;
+  void          sendOnChange(taskVarIndex_t taskVarIndex,
+                             bool           enabled);
+
   bool          isDefaultTaskVarName(taskVarIndex_t taskVarIndex) const;
   void          isDefaultTaskVarName(taskVarIndex_t taskVarIndex,
                                      bool           isDefault);
@@ -84,6 +89,8 @@ struct ExtraTaskSettingsStruct
   float       TaskDeviceMaxValue[VARS_PER_TASK]{};
   float       TaskDeviceErrorValue[VARS_PER_TASK]{};
   uint32_t    VariousBits[VARS_PER_TASK]{};
+  float       TaskDeviceDeadband[VARS_PER_TASK]{};
+  uint16_t    SendOnChangeMaxInterval = 0; // Max. time in sec between sends when values did not change, 0 = no limit
 };
 
 
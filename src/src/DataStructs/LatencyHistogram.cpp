@@ -0,0 +1,75 @@
+#include "../DataStructs/LatencyHistogram.h"
+
+#if FEATURE_TIMING_STATS
+
+LatencyHistogram::LatencyHistogram() {
+  reset();
+}
+
+void LatencyHistogram::add(uint32_t value) {
+  const uint8_t bucket = getBucket(value);
+
+  if (_buckets[bucket] == 0xFFFF) {
+    for (uint8_t i = 0; i < LATENCY_HISTOGRAM_NR_BUCKETS; ++i) {
+      _buckets[i] /= 2;
+    }
+  }
+  ++_buckets[bucket];
+  ++_count;
+
+  if (value > _maxVal) { _maxVal = value; }
+}
+
+void LatencyHistogram::reset() {
+  for (uint8_t i = 0; i < LATENCY_HISTOGRAM_NR_BUCKETS; ++i) {
+    _buckets[i] = 0;
+  }
+  _count  = 0;
+  _maxVal = 0;
+}
+
+uint32_t LatencyHistogram::getPercentile(uint8_t percentile) const {
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < LATENCY_HISTOGRAM_NR_BUCKETS; ++i) {
+    total += _buckets[i];
+  }
+
+  if (total == 0) { return 0; }
+
+  if (percentile > 100) { percentile = 100; }
+
+  // Rank of the value we're looking for, rounded up.
+  const uint32_t rank = (total * percentile + 99) / 100;
+  uint32_t cumulative = 0;
+
+  for (uint8_t i = 0; i < LATENCY_HISTOGRAM_NR_BUCKETS; ++i) {
+    if (_buckets[i] == 0) { continue; }
+
+    if ((cumulative + _buckets[i]) >= rank) {
+      if (i == 0) { return 0; }
+
+      // Linear interpolation within the bucket
+      const uint32_t lower = 1ul << (i - 1);
+      const uint32_t upper = (i == (LATENCY_HISTOGRAM_NR_BUCKETS - 1)) ? _maxVal : (1ul << i);
+      const uint64_t value = lower +
+                             (static_cast<uint64_t>(upper - lower) * (rank - cumulative)) / _buckets[i];
+
+      return (value > _maxVal) ? _maxVal : static_cast<uint32_t>(value);
+    }
+    cumulative += _buckets[i];
+  }
+  return _maxVal;
+}
+
+uint8_t LatencyHistogram::getBucket(uint32_t value) {
+  uint8_t bucket = 0;
+
+  while (value != 0 && bucket < (LATENCY_HISTOGRAM_NR_BUCKETS - 1)) {
+    value >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+#endif // if FEATURE_TIMING_STATS
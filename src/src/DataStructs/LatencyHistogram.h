@@ -0,0 +1,52 @@
+#ifndef DATASTRUCTS_LATENCYHISTOGRAM_H
+#define DATASTRUCTS_LATENCYHISTOGRAM_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_TIMING_STATS
+
+// Bucket 0 holds value 0, bucket N holds values in [2^(N-1), 2^N)
+// The last bucket also holds all larger values.
+# define LATENCY_HISTOGRAM_NR_BUCKETS  32
+
+/*********************************************************************************************\
+* Histogram with exponential sized buckets, to estimate percentiles using fixed memory.
+* Unit of the values is up to the caller.
+\*********************************************************************************************/
+class LatencyHistogram {
+public:
+
+  LatencyHistogram();
+
+  void     add(uint32_t value);
+
+  void     reset();
+
+  bool     isEmpty() const {
+    return _count == 0;
+  }
+
+  uint32_t getCount() const {
+    return _count;
+  }
+
+  uint32_t getMax() const {
+    return _maxVal;
+  }
+
+  // Estimate of the value below which the given percentage of the values fall.
+  uint32_t getPercentile(uint8_t percentile) const;
+
+private:
+
+  static uint8_t getBucket(uint32_t value);
+
+  // Counts per bucket, halved when one would overflow to keep the distribution.
+  uint16_t _buckets[LATENCY_HISTOGRAM_NR_BUCKETS];
+  uint32_t _count;
+  uint32_t _maxVal;
+};
+
+#endif // if FEATURE_TIMING_STATS
+
+#endif // ifndef DATASTRUCTS_LATENCYHISTOGRAM_H
@@ -0,0 +1,159 @@
+#include "../DataStructs/MQTT_SubscriptionIndex.h"
+
+#if FEATURE_MQTT
+
+# include "../Helpers/StringConverter.h"
+
+# include <algorithm>
+
+void MQTT_SubscriptionIndex::add(const String& subscription, taskIndex_t taskIndex)
+{
+  const char *subBegin = subscription.c_str();
+  const char *subEnd   = subBegin + subscription.length();
+
+  normalize(subBegin, subEnd);
+
+  if (subBegin == subEnd) {
+    return;
+  }
+  const String normalized(subscription.substring(subBegin - subscription.c_str(), subEnd - subscription.c_str()));
+  MQTT_SubscriptionNode *node = &_root;
+  int start                   = 0;
+
+  while (start >= 0) {
+    const int    end   = normalized.indexOf('/', start);
+    const String level = (end < 0) ? normalized.substring(start) : normalized.substring(start, end);
+
+    auto it = std::find_if(
+      node->_children.begin(), node->_children.end(),
+      [&level](const MQTT_SubscriptionNode& child) { return child._level.equals(level); });
+
+    if (it == node->_children.end()) {
+      node->_children.emplace_back(level);
+      node = &(node->_children.back());
+    } else {
+      node = &(*it);
+    }
+    start = (end < 0) ? -1 : end + 1;
+  }
+
+  if (std::find(node->_tasks.begin(), node->_tasks.end(), taskIndex) == node->_tasks.end()) {
+    node->_tasks.push_back(taskIndex);
+  }
+}
+
+void MQTT_SubscriptionIndex::remove(taskIndex_t taskIndex)
+{
+  remove(_root, taskIndex);
+}
+
+void MQTT_SubscriptionIndex::clear()
+{
+  _root._children.clear();
+  _root._tasks.clear();
+}
+
+bool MQTT_SubscriptionIndex::hasMatch(const char *topic) const
+{
+  if ((topic == nullptr) || (*topic == 0)) {
+    return false;
+  }
+  const char *end = topic + strlen(topic);
+
+  normalize(topic, end);
+  return match(_root, topic, end, true, nullptr);
+}
+
+void MQTT_SubscriptionIndex::getMatchingTasks(const char *topic, std::vector<taskIndex_t>& taskIndices) const
+{
+  if ((topic == nullptr) || (*topic == 0)) {
+    return;
+  }
+  const char *end = topic + strlen(topic);
+
+  normalize(topic, end);
+  match(_root, topic, end, true, &taskIndices);
+}
+
+void MQTT_SubscriptionIndex::normalize(const char *& begin, const char *& end)
+{
+  while ((begin < end) && isspace(static_cast<unsigned char>(*begin))) { ++begin; }
+
+  while ((begin < end) && isspace(static_cast<unsigned char>(*(end - 1)))) { --end; }
+
+  if ((begin < end) && (*begin == '/')) { ++begin; }
+
+  if ((begin < end) && (*(end - 1) == '/')) { --end; }
+}
+
+bool MQTT_SubscriptionIndex::match(const MQTT_SubscriptionNode& node,
+                                   const char                  *topic,
+                                   const char                  *end,
+                                   bool                         firstLevel,
+                                   std::vector<taskIndex_t>    *taskIndices)
+{
+  bool found = false;
+
+  if (topic == nullptr) {
+    // All topic levels matched.
+    // "a/b/#" does also match "a/b", as '#' includes the parent level.
+    found = addTasks(node, taskIndices);
+
+    for (auto it = node._children.begin(); it != node._children.end() && !(found && (taskIndices == nullptr)); ++it) {
+      if (equals(it->_level, '#')) {
+        found |= addTasks(*it, taskIndices);
+      }
+    }
+    return found;
+  }
+
+  const char  *separator = static_cast<const char *>(memchr(topic, '/', end - topic));
+  const size_t length    = (separator == nullptr) ? end - topic : separator - topic;
+  const char  *nextLevel = (separator == nullptr) ? nullptr : separator + 1;
+
+  // Topics starting with '$' (e.g. $SYS) are not matched by a wildcard on the first level.
+  const bool allowWildcard = !(firstLevel && (*topic == '$'));
+
+  for (auto it = node._children.begin(); it != node._children.end() && !(found && (taskIndices == nullptr)); ++it) {
+    const String& level = it->_level;
+
+    if (equals(level, '#')) {
+      if (allowWildcard) {
+        found |= addTasks(*it, taskIndices);
+      }
+    } else if ((allowWildcard && equals(level, '+')) ||
+               ((level.length() == length) && (strncmp(level.c_str(), topic, length) == 0))) {
+      found |= match(*it, nextLevel, end, false, taskIndices);
+    }
+  }
+  return found;
+}
+
+bool MQTT_SubscriptionIndex::addTasks(const MQTT_SubscriptionNode& node, std::vector<taskIndex_t> *taskIndices)
+{
+  if (taskIndices != nullptr) {
+    for (const taskIndex_t taskIndex : node._tasks) {
+      if (std::find(taskIndices->begin(), taskIndices->end(), taskIndex) == taskIndices->end()) {
+        taskIndices->push_back(taskIndex);
+      }
+    }
+  }
+  return !node._tasks.empty();
+}
+
+void MQTT_SubscriptionIndex::remove(MQTT_SubscriptionNode& node, taskIndex_t taskIndex)
+{
+  node._tasks.erase(std::remove(node._tasks.begin(), node._tasks.end(), taskIndex), node._tasks.end());
+
+  for (auto& child : node._children) {
+    remove(child, taskIndex);
+  }
+
+  // Prune branches without subscriptions
+  node._children.erase(
+    std::remove_if(node._children.begin(), node._children.end(),
+                   [](const MQTT_SubscriptionNode& child) { return child.isEmpty(); }),
+    node._children.end());
+}
+
+#endif // if FEATURE_MQTT
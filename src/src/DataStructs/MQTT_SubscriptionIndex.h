@@ -0,0 +1,85 @@
+#ifndef DATASTRUCTS_MQTT_SUBSCRIPTIONINDEX_H
+#define DATASTRUCTS_MQTT_SUBSCRIPTIONINDEX_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_MQTT
+
+# include "../DataTypes/TaskIndex.h"
+
+# include <vector>
+
+// Index of MQTT subscriptions per task, stored as a tree with one node per topic level.
+// Supports the MQTT wildcards '+' (single level) and '#' (multi level, last level only).
+// Used to find the tasks interested in an incoming message without
+// matching the topic against every subscription of every task.
+// Topic and subscription are normalized like MQTTCheckSubscription_037():
+// surrounding white space and a single leading and trailing '/' are ignored.
+
+struct MQTT_SubscriptionNode {
+  explicit MQTT_SubscriptionNode(const String& level) : _level(level) {}
+
+  bool isEmpty() const {
+    return _tasks.empty() && _children.empty();
+  }
+
+  String                           _level;
+  std::vector<MQTT_SubscriptionNode>_children;
+
+  // Tasks with a subscription ending at this level
+  std::vector<taskIndex_t>         _tasks;
+};
+
+class MQTT_SubscriptionIndex {
+public:
+
+  MQTT_SubscriptionIndex() : _root(EMPTY_STRING) {}
+
+  // Add subscription topic (with all system variables already replaced) for a task.
+  void add(const String& subscription,
+           taskIndex_t   taskIndex);
+
+  // Remove all subscriptions of a task.
+  void remove(taskIndex_t taskIndex);
+
+  void clear();
+
+  bool isEmpty() const {
+    return _root.isEmpty();
+  }
+
+  // Return true when at least one subscription matches the topic.
+  bool hasMatch(const char *topic) const;
+
+  // Collect the tasks having at least one subscription matching the topic.
+  // Each task is only added once.
+  void getMatchingTasks(const char               *topic,
+                        std::vector<taskIndex_t>& taskIndices) const;
+
+private:
+
+  // Strip white space and a leading and trailing '/' from the range [begin, end).
+  static void normalize(const char *& begin,
+                        const char *& end);
+
+  // Match the topic levels in [topic, end), topic is nullptr when all levels are matched.
+  // Return true when a match was found.
+  // When taskIndices is nullptr, stop at the first match.
+  static bool match(const MQTT_SubscriptionNode& node,
+                    const char                  *topic,
+                    const char                  *end,
+                    bool                         firstLevel,
+                    std::vector<taskIndex_t>    *taskIndices);
+
+  static bool addTasks(const MQTT_SubscriptionNode& node,
+                       std::vector<taskIndex_t>    *taskIndices);
+
+  static void remove(MQTT_SubscriptionNode& node,
+                     taskIndex_t            taskIndex);
+
+  MQTT_SubscriptionNode _root;
+};
+
+#endif // if FEATURE_MQTT
+
+#endif // ifndef DATASTRUCTS_MQTT_SUBSCRIPTIONINDEX_H
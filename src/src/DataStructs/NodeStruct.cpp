@@ -37,7 +37,7 @@ bool NodeStruct::validate() {
   }
   if (build < 20253) {
     version = 0;
-    dummy = 0;
+    p2pFeatures = 0;
     unix_time_frac = 0;
     unix_time_sec = 0;
   }
@@ -256,4 +256,9 @@ void NodeStruct::setAP_MAC(const MAC_address& mac)
   mac.get(ap_mac);
 }
 
+bool NodeStruct::hasP2PFeature(uint8_t feature) const
+{
+  return bitRead(p2pFeatures, feature);
+}
+
 #endif
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include <IPAddress.h>
 #include <map>
 
+// Bits in NodeStruct::p2pFeatures, to announce support of optional P2P messages.
+#define NODE_P2P_FEATURE_C013_V2   0 // Receiving batched sensor data frames of C013
+
 
 /*********************************************************************************************\
 * NodeStruct
@@ -61,6 +64,8 @@ struct __attribute__((__packed__)) NodeStruct
 
   void          setAP_MAC(const MAC_address& mac);
 
+  bool          hasP2PFeature(uint8_t feature) const;
+
 
   // Do not change the order of this data, as it is being sent via P2P UDP.
   // 6 byte mac  (STA interface)
@@ -97,7 +102,7 @@ struct __attribute__((__packed__)) NodeStruct
   // When kept as node info, this is the last time stamp the node info was updated.
   unsigned long lastUpdated = (1 << 30);
   uint8_t  version = 1;
-  uint8_t  dummy = 0; // Not yet used
+  uint8_t  p2pFeatures = 0; // Bitmap of supported optional P2P messages, see NODE_P2P_FEATURE_xxx
   uint32_t unix_time_sec = 0;
   uint32_t unix_time_frac = 0;
 };
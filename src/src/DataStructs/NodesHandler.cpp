@@ -19,6 +19,7 @@
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
+#include "../Globals/CPlugins.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/MQTT.h"
@@ -39,6 +40,7 @@ bool NodesHandler::addNode(const NodeStruct& node)
   MAC_address ESPEasy_NOW_MAC;
 
   bool isNewNode = true;
+  bool rebooted  = false;
 
   // Erase any existing node with matching MAC address
   for (auto it = _nodes.begin(); it != _nodes.end(); )
@@ -46,6 +48,14 @@ bool NodesHandler::addNode(const NodeStruct& node)
     const MAC_address sta = it->second.sta_mac;
     const MAC_address ap  = it->second.ap_mac;
     if ((!sta.all_zero() && node.match(sta)) || (!ap.all_zero() && node.match(ap))) {
+      // A node only loses its time source or changes build when it has been restarted.
+      // A changed unit number is handled as a new node.
+      if ((it->second.unit != node.unit) ||
+          (it->second.build != node.build) ||
+          ((it->second.timeSource != static_cast<uint8_t>(timeSource_t::No_time_source)) &&
+           (node.timeSource == static_cast<uint8_t>(timeSource_t::No_time_source)))) {
+        rebooted = true;
+      }
       rssi = it->second.getRSSI();
       if (!sta.all_zero())
         match_sta = sta;
@@ -78,6 +88,9 @@ bool NodesHandler::addNode(const NodeStruct& node)
     if (node.ESPEasy_Now_MAC().all_zero()) {
       _nodes[node.unit].setESPEasyNow_mac(ESPEasy_NOW_MAC);
     }
+    if (isNewNode || rebooted) {
+      ++_nodesChangeCount;
+    }
     _nodes_mutex.unlock();
   }
 
@@ -377,6 +390,12 @@ void NodesHandler::updateThisNode() {
   thisNode.build = Settings.Build;
   memcpy(thisNode.nodeName, Settings.getName().c_str(), 25);
   thisNode.nodeType = NODE_TYPE_ID;
+  #ifdef USES_C013
+
+  if (validControllerIndex(findFirstEnabledControllerWithId(13))) {
+    bitSet(thisNode.p2pFeatures, NODE_P2P_FEATURE_C013_V2);
+  }
+  #endif // ifdef USES_C013
 
   thisNode.webgui_portnumber = Settings.WebserverPort;
   const int load_int = getCPUload() * 2.55;
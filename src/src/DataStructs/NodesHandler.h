@@ -89,6 +89,11 @@ public:
 
   bool    recentlyBecameDistanceZero();
 
+  // Incremented when a node is added or a known node appears to have rebooted.
+  uint32_t getNodesChangeCount() const {
+    return _nodesChangeCount;
+  }
+
   void    setRSSI(const MAC_address& mac,
                   int                rssi);
 
@@ -141,6 +146,8 @@ private:
 #endif // ifdef USES_ESPEASY_NOW
 
   bool _recentlyBecameDistanceZero = false;
+
+  uint32_t _nodesChangeCount = 0;
 };
 
 #endif
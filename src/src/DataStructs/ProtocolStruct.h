@@ -22,24 +22,26 @@ struct ProtocolStruct
   uint16_t defaultPort{};
   union {
     struct {
-      uint16_t usesMQTT             : 1;
-      uint16_t usesAccount          : 1;
-      uint16_t usesPassword         : 1;
-      uint16_t usesTemplate         : 1; // When set, the protocol will pre-load some templates like default MQTT topics
-      uint16_t usesID               : 1; // Whether a controller supports sending an IDX value sent along with plugin data
-      uint16_t Custom               : 1; // When set, the controller has to define all parameters on the controller setup page
-      uint16_t usesHost             : 1;
-      uint16_t usesPort             : 1;
-      uint16_t usesQueue            : 1;
-      uint16_t usesCheckReply       : 1;
-      uint16_t usesTimeout          : 1;
-      uint16_t usesSampleSets       : 1;
-      uint16_t usesExtCreds         : 1;
-      uint16_t needsNetwork         : 1;
-      uint16_t allowsExpire         : 1;
-      uint16_t allowLocalSystemTime : 1;
+      uint32_t usesMQTT              : 1;
+      uint32_t usesAccount           : 1;
+      uint32_t usesPassword          : 1;
+      uint32_t usesTemplate          : 1; // When set, the protocol will pre-load some templates like default MQTT topics
+      uint32_t usesID                : 1; // Whether a controller supports sending an IDX value sent along with plugin data
+      uint32_t Custom                : 1; // When set, the controller has to define all parameters on the controller setup page
+      uint32_t usesHost              : 1;
+      uint32_t usesPort              : 1;
+      uint32_t usesQueue             : 1;
+      uint32_t usesCheckReply        : 1;
+      uint32_t usesTimeout           : 1;
+      uint32_t usesSampleSets        : 1;
+      uint32_t usesExtCreds          : 1;
+      uint32_t needsNetwork          : 1;
+      uint32_t allowsExpire          : 1;
+      uint32_t allowLocalSystemTime  : 1;
+      uint32_t allowsAggregateValues : 1; // When set, all values of a task may be sent as a single JSON payload
+      uint32_t allowsSpillToFlash    : 1; // When set, queue elements can be stored on the file system when the queue is full
     };
-    uint16_t bits{};
+    uint32_t bits{};
   };
 
 //  uint8_t Number{};
@@ -0,0 +1,86 @@
+#include "../DataStructs/RulesBlockCache.h"
+
+#if FEATURE_RULES_COMPILER
+
+# include <algorithm>
+
+void RulesBlockCache_element::addLine(size_t pos, const String& line)
+{
+  _positions.push_back(pos);
+  _lines.push_back(line);
+  _size += line.length();
+}
+
+void RulesBlockCache::clear()
+{
+  _blocks.clear();
+  _size       = 0;
+  _useCounter = 0;
+}
+
+bool RulesBlockCache::isCached(const String& filename, size_t pos) const
+{
+  return find(filename, pos) >= 0;
+}
+
+bool RulesBlockCache::get(const String& filename, size_t pos, String& line)
+{
+  const int blockIndex = find(filename, pos);
+
+  if (blockIndex < 0) {
+    return false;
+  }
+  RulesBlockCache_element& block = _blocks[blockIndex];
+  auto it                        = std::lower_bound(block._positions.begin(), block._positions.end(), pos);
+
+  if ((it == block._positions.end()) || (*it != pos)) {
+    return false;
+  }
+  block._lastUsed = ++_useCounter;
+  line            = block._lines[it - block._positions.begin()];
+  return true;
+}
+
+bool RulesBlockCache::add(RulesBlockCache_element&& block)
+{
+  if (block._positions.empty() ||
+      (block._size > RULES_BLOCK_CACHE_MAX_SIZE) ||
+      isCached(block._filename, block._positions.front())) {
+    return false;
+  }
+
+  while (!_blocks.empty() &&
+         ((_blocks.size() >= RULES_BLOCK_CACHE_MAX_BLOCKS) ||
+          ((_size + block._size) > RULES_BLOCK_CACHE_MAX_SIZE))) {
+    // Evict the least recently used block
+    auto lru = _blocks.begin();
+
+    for (auto it = _blocks.begin(); it != _blocks.end(); ++it) {
+      if (it->_lastUsed < lru->_lastUsed) {
+        lru = it;
+      }
+    }
+    _size -= lru->_size;
+    _blocks.erase(lru);
+  }
+  block._lastUsed = ++_useCounter;
+  _size          += block._size;
+  _blocks.push_back(std::move(block));
+  return true;
+}
+
+int RulesBlockCache::find(const String& filename, size_t pos) const
+{
+  for (size_t i = 0; i < _blocks.size(); ++i) {
+    const RulesBlockCache_element& block = _blocks[i];
+
+    if ((pos >= block._positions.front()) &&
+        (pos <= block._positions.back()) &&
+        block._filename.equals(filename)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+#endif // if FEATURE_RULES_COMPILER
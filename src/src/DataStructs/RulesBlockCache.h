@@ -0,0 +1,79 @@
+#ifndef DATASTRUCTS_RULESBLOCKCACHE_H
+#define DATASTRUCTS_RULESBLOCKCACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RULES_COMPILER
+
+# include <vector>
+
+// Max. number of "on ... do" blocks kept in memory
+# ifndef RULES_BLOCK_CACHE_MAX_BLOCKS
+#  define RULES_BLOCK_CACHE_MAX_BLOCKS  4
+# endif // ifndef RULES_BLOCK_CACHE_MAX_BLOCKS
+
+// Max. total length of the cached rules lines.
+// Set to 0 to disable the block cache.
+# ifndef RULES_BLOCK_CACHE_MAX_SIZE
+#  ifdef ESP8266
+#   define RULES_BLOCK_CACHE_MAX_SIZE  1024
+#  else // ifdef ESP8266
+#   define RULES_BLOCK_CACHE_MAX_SIZE  4096
+#  endif // ifdef ESP8266
+# endif // ifndef RULES_BLOCK_CACHE_MAX_SIZE
+
+
+// Lines of a single "on ... do" block, as returned by RulesHelperClass::readLn()
+struct RulesBlockCache_element {
+  RulesBlockCache_element() = default;
+
+  void addLine(size_t        pos,
+               const String& line);
+
+  String _filename;
+
+  // Position in the file of each line, in ascending order.
+  std::vector<size_t>_positions;
+  std::vector<String>_lines;
+
+  // Total length of the lines
+  size_t   _size     = 0;
+  uint32_t _lastUsed = 0;
+};
+
+
+// Keep the most recently matched "on ... do" blocks in memory,
+// so processing a frequent event does not need to access the file system.
+class RulesBlockCache {
+public:
+
+  RulesBlockCache() = default;
+
+  void clear();
+
+  bool isCached(const String& filename,
+                size_t        pos) const;
+
+  // Get a line starting at given position in the file.
+  // Return false when the line is not cached.
+  bool get(const String& filename,
+           size_t        pos,
+           String      & line);
+
+  // Add a block, evicting the least recently used blocks when needed.
+  // Return false when the block is too large to be cached.
+  bool add(RulesBlockCache_element&& block);
+
+private:
+
+  int find(const String& filename,
+           size_t        pos) const;
+
+  std::vector<RulesBlockCache_element>_blocks;
+  size_t   _size       = 0;
+  uint32_t _useCounter = 0;
+};
+
+#endif // if FEATURE_RULES_COMPILER
+
+#endif // ifndef DATASTRUCTS_RULESBLOCKCACHE_H
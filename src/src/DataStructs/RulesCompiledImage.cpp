@@ -0,0 +1,160 @@
+#include "../DataStructs/RulesCompiledImage.h"
+
+#if FEATURE_RULES_COMPILER
+
+# include "../Helpers/RulesMatcher.h"
+
+static bool rulesLineStartsWith(const String& line, const __FlashStringHelper *keyword)
+{
+  const size_t len = strlen_P((PGM_P)keyword);
+
+  return line.length() >= len && line.substring(0, len).equalsIgnoreCase(keyword);
+}
+
+bool RulesCompiledImage::addLine(const String& line, size_t pos, size_t length)
+{
+  if (line.isEmpty() || !_valid) {
+    return false;
+  }
+  const size_t index = _elements.size();
+
+  if (length > 0xFFFF) {
+    // Unusually long line, let it be read as before.
+    length = 0;
+  }
+
+  if (index >= 0xFFFF) {
+    // Jump indices are stored as uint16_t
+    _valid = false;
+    return false;
+  }
+
+  if (!_inBlock) {
+    // Lines outside an "on ... do" block are ignored by the rules engine
+    if (!rulesLineStartsWith(line, F("on "))) {
+      return false;
+    }
+    String event, action;
+    const bool oneLiner = getEventFromRulesLine(line, event, action) && !action.isEmpty();
+
+    _elements.emplace_back(RulesOpcode::On, pos);
+    _elements.back()._flag   = oneLiner;
+    _elements.back()._length = length;
+
+    if (oneLiner) {
+      _elements.back()._jump = index;
+    } else {
+      _inBlock = true;
+      _onIndex = index;
+    }
+    return true;
+  }
+
+  if (line.equalsIgnoreCase(F("endon"))) {
+    closeOpenIfBlocks(index);
+    _elements[_onIndex]._jump = index;
+    _elements.emplace_back(RulesOpcode::EndOn, pos);
+    _elements.back()._length = length;
+    _inBlock                 = false;
+    return true;
+  }
+
+  if (rulesLineStartsWith(line, F("elseif "))) {
+    if (!_ifStack.empty()) {
+      _elements[_ifStack.back()]._jump = index;
+      _ifStack.back()                  = index;
+    }
+    _elements.emplace_back(RulesOpcode::ElseIf, pos);
+  } else if (rulesLineStartsWith(line, F("if "))) {
+    _ifStack.push_back(index);
+    _elements.emplace_back(RulesOpcode::If, pos);
+  } else if (line.equalsIgnoreCase(F("else"))) {
+    if (!_ifStack.empty()) {
+      _elements[_ifStack.back()]._jump = index;
+      _ifStack.back()                  = index;
+    }
+    _elements.emplace_back(RulesOpcode::Else, pos);
+  } else if (line.equalsIgnoreCase(F("endif"))) {
+    if (!_ifStack.empty()) {
+      _elements[_ifStack.back()]._jump = index;
+      _ifStack.pop_back();
+    }
+    _elements.emplace_back(RulesOpcode::EndIf, pos);
+  } else {
+    _elements.emplace_back(RulesOpcode::Command, pos);
+    _elements.back()._flag = line.startsWith(F("%event"));
+  }
+
+  _elements.back()._length = length;
+
+  // Make sure a stray elseif/else without if never jumps backwards.
+  if (_elements.back()._jump < index) {
+    _elements.back()._jump = index + 1;
+  }
+  return true;
+}
+
+void RulesCompiledImage::finalize()
+{
+  if (_inBlock) {
+    // Missing "endon" at the end of the file
+    const size_t index = _elements.size();
+    closeOpenIfBlocks(index);
+    _elements[_onIndex]._jump = index;
+    _inBlock                  = false;
+  }
+  _ifStack.clear();
+  _ifStack.shrink_to_fit();
+  _elements.shrink_to_fit();
+}
+
+size_t RulesCompiledImage::findOnElement(size_t pos) const
+{
+  // Elements are ordered by position in the file.
+  size_t first = 0;
+  size_t last  = _elements.size();
+
+  while (first < last) {
+    const size_t mid = first + (last - first) / 2;
+
+    if (_elements[mid]._posInFile < pos) {
+      first = mid + 1;
+    } else {
+      last = mid;
+    }
+  }
+
+  if ((first < _elements.size()) &&
+      (_elements[first]._posInFile == pos) &&
+      (_elements[first]._opcode == RulesOpcode::On)) {
+    return first;
+  }
+  return _elements.size();
+}
+
+size_t RulesCompiledImage::getEndIf(size_t index) const
+{
+  while (index < _elements.size()) {
+    switch (_elements[index]._opcode) {
+      case RulesOpcode::If:
+      case RulesOpcode::ElseIf:
+      case RulesOpcode::Else:
+        index = _elements[index]._jump;
+        break;
+      default:
+        return index;
+    }
+  }
+  return _elements.size();
+}
+
+void RulesCompiledImage::closeOpenIfBlocks(size_t index)
+{
+  // Missing "endif", let the open branches jump to the end of the block.
+  while (!_ifStack.empty()) {
+    _elements[_ifStack.back()]._jump = index;
+    _ifStack.pop_back();
+  }
+}
+
+#endif // if FEATURE_RULES_COMPILER
@@ -0,0 +1,99 @@
+#ifndef DATASTRUCTS_RULESCOMPILEDIMAGE_H
+#define DATASTRUCTS_RULESCOMPILEDIMAGE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RULES_COMPILER
+
+# include <vector>
+
+// Pre-parsed representation of a rules file.
+// Each non-empty rules line is classified once when the rules are loaded,
+// so processing an event does not need to re-tokenize every line
+// to find out whether it is an "on", "if", "else", "endif", etc.
+// The line text itself is not stored here, only its position in the file
+// as used by RulesHelperClass::readLn() and the number of bytes to read.
+// Jump indices allow to skip non matching "on ... do" blocks and
+// non-taken if/elseif/else branches without reading those lines.
+
+enum class RulesOpcode : uint8_t {
+  On,      // on <event> do [<action>]
+  EndOn,
+  If,
+  ElseIf,
+  Else,
+  EndIf,
+  Command
+};
+
+struct RulesCompiled_element {
+  RulesCompiled_element(RulesOpcode opcode, size_t pos)
+    : _posInFile(pos), _opcode(opcode) {}
+
+  size_t _posInFile;
+
+  // Number of bytes in the file from _posInFile up to the end of the line.
+  // 0 when unknown.
+  uint16_t _length = 0;
+
+  // On:            Index of the matching EndOn (or the element itself for one-liners)
+  // If/ElseIf/Else: Index of the next branch of the same if-block, or its EndIf
+  // When the block is not closed, the jump points to the EndOn or the end of the image.
+  uint16_t    _jump = 0;
+  RulesOpcode _opcode;
+
+  // On:      Single line "on ... do <action>"
+  // Command: Line starts with "%event" and should be executed as restricted command.
+  bool _flag = false;
+};
+
+class RulesCompiledImage {
+public:
+
+  RulesCompiledImage() = default;
+
+  // Feed lines as returned by RulesHelperClass::readLn() in the order of the file.
+  // Length is the number of bytes read from the file for this line.
+  // Return true when the line was added to the image.
+  bool   addLine(const String& line,
+                 size_t        pos,
+                 size_t        length = 0);
+
+  // Must be called after the last line has been added.
+  void   finalize();
+
+  bool   isValid() const {
+    return _valid;
+  }
+
+  size_t size() const {
+    return _elements.size();
+  }
+
+  const RulesCompiled_element& operator[](size_t index) const {
+    return _elements[index];
+  }
+
+  // Find the index of the "on" element at given position in the file.
+  // Returns size() when not found.
+  size_t findOnElement(size_t pos) const;
+
+  // Follow the branches of an if-block starting at index.
+  // Returns the index of the matching EndIf, or the index of the EndOn
+  // (or size()) when the if-block was not closed.
+  size_t getEndIf(size_t index) const;
+
+private:
+
+  void closeOpenIfBlocks(size_t index);
+
+  std::vector<RulesCompiled_element>_elements;
+  std::vector<uint16_t>             _ifStack;
+  uint16_t                          _onIndex = 0;
+  bool                              _inBlock = false;
+  bool                              _valid   = true;
+};
+
+#endif // if FEATURE_RULES_COMPILER
+
+#endif // ifndef DATASTRUCTS_RULESCOMPILEDIMAGE_H
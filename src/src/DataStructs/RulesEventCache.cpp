@@ -1,13 +1,17 @@
 #include "../DataStructs/RulesEventCache.h"
 
 #include "../DataStructs/TimingStats.h"
+#include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Helpers/RulesMatcher.h"
 
 
 void RulesEventCache::clear()
 {
   _eventCache.clear();
-  _initialized = false;
+  _eventNameIndex.clear();
+  _alwaysCheck.clear();
+  _initialized  = false;
+  _rulesSkipped = false;
 }
 
 void RulesEventCache::initialize()
@@ -20,57 +24,110 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
   String event, action;
 
   if (getEventFromRulesLine(line, event, action)) {
+    if (_eventCache.size() >= 0xFFFF) {
+      // Index is stored as uint16_t
+      if (!_rulesSkipped) {
+        _rulesSkipped = true;
+        addLog(LOG_LEVEL_ERROR, F("Rules: Too many rules to cache, skipping the remaining rules"));
+      }
+      return false;
+    }
+    const uint16_t index = _eventCache.size();
+    const uint32_t hash  = getEventNameHash(event, true);
+
+    if (hash == 0) {
+      _alwaysCheck.push_back(index);
+    } else {
+      _eventNameIndex[hash].push_back(index);
+    }
     _eventCache.emplace_back(filename, pos, std::move(event), std::move(action));
     return true;
   }
   return false;
 }
 
-RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event, bool optimize)
+uint32_t RulesEventCache::getEventNameHash(const String& event, bool isRule)
 {
-  RulesEventCache_vector::iterator it   = _eventCache.begin();
-//  RulesEventCache_vector::iterator prev = _eventCache.end();
+  const size_t length = event.length();
+  size_t start        = 0;
+  size_t end          = 0;
+
+  // Find the end of the event name
+  for (; end < length; ++end) {
+    const char c = event[end];
+
+    if ((c == '=') || (c == '<') || (c == '>') || (c == '!')) {
+      break;
+    }
+
+    if (isRule) {
+      // Rules which will be changed by parseTemplate() or contain wildcards
+      // cannot be matched on their name only.
+      if ((c == '*') || (c == '[') || (c == '%') || (c == '{') || (c == '&')) {
+        return 0;
+      }
+    }
+  }
+
+  // Literal string events ("!...") may match on just a part of the event name.
+  if (isRule && (event[0] == '!')) {
+    return 0;
+  }
+
+  // Ignore leading and trailing spaces
+  while (start < end && event[start] == ' ') { ++start; }
+
+  while (end > start && event[end - 1] == ' ') { --end; }
 
-  // FIXME TD-er: Disable optimize as it has some side effects.
-  // For example, matching a specific event first and then a more generic one is perfectly normal to do.
-  // But this optimization will then put the generic one in front as it will be matched more often.
-  // Thus it will never match the more specific one anymore.
+  // FNV-1a hash
+  uint32_t hash = 2166136261u;
 
+  for (size_t i = start; i < end; ++i) {
+    hash ^= static_cast<uint8_t>(tolower(event[i]));
+    hash *= 16777619u;
+  }
+
+  // 0 is reserved for "no name"
+  return hash == 0 ? 1 : hash;
+}
 
-  for (; it != _eventCache.end(); ++it)
+RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event)
+{
+  // Only check the rules with the same event name and those which must always be checked.
+  // Both lists are sorted in the order of the rules, so merge them to make sure the first
+  // matching rule is found.
+  const RulesEventCache_indices *candidates = nullptr;
   {
+    auto it_index = _eventNameIndex.find(getEventNameHash(event, false));
+
+    if (it_index != _eventNameIndex.end()) {
+      candidates = &(it_index->second);
+    }
+  }
+  const size_t nrCandidates = candidates == nullptr ? 0 : candidates->size();
+  const RulesMatcher_event rulesEvent(event);
+  size_t candidate_pos      = 0;
+  size_t alwaysCheck_pos    = 0;
+
+  while (candidate_pos < nrCandidates || alwaysCheck_pos < _alwaysCheck.size()) {
+    uint16_t index;
+
+    if ((alwaysCheck_pos >= _alwaysCheck.size()) ||
+        ((candidate_pos < nrCandidates) && ((*candidates)[candidate_pos] < _alwaysCheck[alwaysCheck_pos]))) {
+      index = (*candidates)[candidate_pos];
+      ++candidate_pos;
+    } else {
+      index = _alwaysCheck[alwaysCheck_pos];
+      ++alwaysCheck_pos;
+    }
+
     START_TIMER
-    const bool match = ruleMatch(event, it->_event);
+    const bool match = ruleMatch(rulesEvent, _eventCache[index]._event);
     STOP_TIMER(RULES_MATCH);
 
     if (match) {
-      /*
-      if (optimize) {
-        it->_nrTimesMatched++;
-
-        if (prev != _eventCache.end()) {
-          // Check to see if we need to place this one more to the front of the vector
-          // to speed up parsing.
-          if (prev->_nrTimesMatched < it->_nrTimesMatched) {
-            std::swap(*prev, *it);
-            return prev;
-          }
-        }
-      }
-      */
-      return it;
-    }
-/*
-    if (optimize) {
-      if (prev == _eventCache.end()) {
-        prev = it;
-      }
-      else if (prev->_nrTimesMatched > it->_nrTimesMatched) {
-        // Found one that's having a lower match rate
-        prev = it;
-      }
+      return _eventCache.begin() + index;
     }
-    */
   }
-  return it;
+  return _eventCache.end();
 }
@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <map>
 #include <vector>
 
 struct RulesEventCache_element {
@@ -20,6 +21,9 @@ struct RulesEventCache_element {
 
 typedef std::vector<RulesEventCache_element> RulesEventCache_vector;
 
+// Indices in the RulesEventCache_vector, ordered as they appear in the rules.
+typedef std::vector<uint16_t> RulesEventCache_indices;
+
 class RulesEventCache {
 public:
 
@@ -37,16 +41,34 @@ public:
                const String& filename,
                size_t        pos);
 
-  RulesEventCache_vector::const_iterator findMatchingRule(const String& event, bool optimize);
+  RulesEventCache_vector::const_iterator findMatchingRule(const String& event);
 
   RulesEventCache_vector::const_iterator end() const {
     return _eventCache.end();
   }
 
+  // Compute a case insensitive hash of the event name.
+  // The event name is the part before the first compare operator ('=', '<', '>', '!'),
+  // e.g. "Taskname#Value", "Clock#Time" or "System#Boot"
+  // Returns 0 when the rule event cannot be matched on its name only.
+  // For example when it contains wildcards or needs to be parsed first.
+  static uint32_t getEventNameHash(const String& event,
+                                   bool          isRule);
+
 private:
 
   RulesEventCache_vector _eventCache;
+
+  // Rules grouped per hash of the event name.
+  std::map<uint32_t, RulesEventCache_indices> _eventNameIndex;
+
+  // Rules which must be checked for every event.
+  RulesEventCache_indices _alwaysCheck;
+
   bool _initialized = false;
+
+  // Set when rules were not added as the max. number of cached rules was reached.
+  bool _rulesSkipped = false;
 };
 
 #endif // ifndef DATASTRUCTS_RULESEVENTCACHE_H
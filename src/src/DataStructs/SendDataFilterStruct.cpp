@@ -0,0 +1,128 @@
+#include "../DataStructs/SendDataFilterStruct.h"
+
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+# include "../DataStructs/ESPEasy_EventStruct.h"
+# include "../Globals/Cache.h"
+# include "../Globals/Plugins.h"
+# include "../Globals/RuntimeData.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+
+
+bool SendDataFilterStruct::mustSend(struct EventStruct *event)
+{
+  const taskIndex_t TaskIndex = event->TaskIndex;
+
+  if (!validTaskIndex(TaskIndex)) {
+    return true;
+  }
+  const uint8_t sendOnChange = Cache.getTaskSendOnChange(TaskIndex);
+
+  if (sendOnChange == 0) {
+    // Filter not used for this task
+    return true;
+  }
+
+  const Sensor_VType sensorType = event->getSensorType();
+
+  if (sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
+    // Cannot compare strings, as these are not kept in the task values
+    return true;
+  }
+
+  const TaskValues_Data_t *data = UserVar.getTaskValues_Data(TaskIndex);
+
+  if (data == nullptr) {
+    return true;
+  }
+
+  auto it = _lastSent.find(TaskIndex);
+  bool changed = (it == _lastSent.end());
+
+  if (!changed) {
+    const uint16_t maxInterval = Cache.getTaskSendOnChangeMaxInterval(TaskIndex);
+
+    if ((maxInterval != 0) && (timePassedSince(it->second.moment) >= (1000l * maxInterval))) {
+      changed = true;
+    }
+  }
+
+  const uint8_t valueCount = getValueCountForTask(TaskIndex);
+
+  for (uint8_t i = 0; !changed && i < valueCount; ++i) {
+    if (bitRead(sendOnChange, i)) {
+      const bool valid     = data->isValid(i, sensorType);
+      const bool lastValid = it->second.values.isValid(i, sensorType);
+
+      if (valid != lastValid) {
+        changed = true;
+      } else if (valid) {
+        const ESPEASY_RULES_FLOAT_TYPE diff =
+          data->getAsDouble(i, sensorType) - it->second.values.getAsDouble(i, sensorType);
+
+        if (fabs(diff) > Cache.getTaskDeviceDeadband(TaskIndex, i)) {
+          changed = true;
+        }
+      }
+    }
+  }
+
+  if (changed) {
+    LastSent_t& lastSent = _lastSent[TaskIndex];
+    lastSent.values = *data;
+    lastSent.moment = millis();
+  }
+  return changed;
+}
+
+void SendDataFilterStruct::countSuppressed(taskIndex_t TaskIndex, controllerIndex_t ControllerIndex)
+{
+  if (validControllerIndex(ControllerIndex)) {
+    ++_suppressed[ControllerIndex];
+  }
+  auto it = _lastSent.find(TaskIndex);
+
+  if (it != _lastSent.end()) {
+    ++(it->second.suppressed);
+  }
+}
+
+uint32_t SendDataFilterStruct::getSuppressedCount(controllerIndex_t ControllerIndex) const
+{
+  if (validControllerIndex(ControllerIndex)) {
+    return _suppressed[ControllerIndex];
+  }
+  return 0;
+}
+
+uint32_t SendDataFilterStruct::getSuppressedCountTask(taskIndex_t TaskIndex) const
+{
+  auto it = _lastSent.find(TaskIndex);
+
+  if (it != _lastSent.end()) {
+    return it->second.suppressed;
+  }
+  return 0;
+}
+
+void SendDataFilterStruct::resetStats()
+{
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    _suppressed[x] = 0;
+  }
+
+  for (auto it = _lastSent.begin(); it != _lastSent.end(); ++it) {
+    it->second.suppressed = 0;
+  }
+}
+
+void SendDataFilterStruct::clear(taskIndex_t TaskIndex)
+{
+  auto it = _lastSent.find(TaskIndex);
+
+  if (it != _lastSent.end()) {
+    _lastSent.erase(it);
+  }
+}
+
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
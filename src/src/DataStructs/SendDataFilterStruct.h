@@ -0,0 +1,59 @@
+#ifndef DATASTRUCTS_SENDDATAFILTERSTRUCT_H
+#define DATASTRUCTS_SENDDATAFILTERSTRUCT_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+# include "../CustomBuild/ESPEasyLimits.h"
+# include "../DataTypes/ControllerIndex.h"
+# include "../DataTypes/TaskIndex.h"
+# include "../DataTypes/TaskValues_Data.h"
+
+# include <map>
+
+struct EventStruct;
+
+/*********************************************************************************************\
+* SendDataFilterStruct
+*
+* "Send On Change" filter, evaluated once per call to sendData() before the task values
+* are handed to the controllers.
+* Only task values with "Send On Change" checked are considered.
+* When such values are present, the task is only sent when at least one of them differs
+* more than its deadband from the value last sent, or when the "Send On Change Max Interval"
+* of the task has passed since the last send.
+* Controllers with "Ignore Send On Change" checked receive all task values.
+\*********************************************************************************************/
+struct SendDataFilterStruct {
+  // Return true when the values of the task must be sent.
+  // The values are then kept to compare the next values against.
+  bool     mustSend(struct EventStruct *event);
+
+  void     countSuppressed(taskIndex_t       TaskIndex,
+                           controllerIndex_t ControllerIndex);
+
+  uint32_t getSuppressedCount(controllerIndex_t ControllerIndex) const;
+
+  uint32_t getSuppressedCountTask(taskIndex_t TaskIndex) const;
+
+  void     resetStats();
+
+  // Forget the last sent values of a task, so the next values will be sent.
+  void     clear(taskIndex_t TaskIndex);
+
+private:
+
+  struct LastSent_t {
+    TaskValues_Data_t values;
+    unsigned long     moment     = 0;
+    uint32_t          suppressed = 0;
+  };
+
+  std::map<taskIndex_t, LastSent_t> _lastSent;
+  uint32_t _suppressed[CONTROLLER_MAX] = {};
+};
+
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+#endif // ifndef DATASTRUCTS_SENDDATAFILTERSTRUCT_H
@@ -10,6 +10,8 @@
 std::map<int, TimingStats> pluginStats;
 std::map<int, TimingStats> controllerStats;
 std::map<TimingStatsElements, TimingStats> miscStats;
+std::map<SchedulerTimerType_e, SchedulerTimingStats> schedulerStats;
+std::map<controllerIndex_t, ControllerSendTimingStats> controllerSendStats;
 unsigned long timingstats_last_reset(0);
 
 
@@ -253,6 +255,7 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::HANDLE_SCHEDULER_IDLE:      return F("handle_schedule() idle");
     case TimingStatsElements::HANDLE_SCHEDULER_TASK:      return F("handle_schedule() task");
     case TimingStatsElements::PARSE_TEMPLATE_PADDED:      return F("parseTemplate_padded()");
+    case TimingStatsElements::PARSE_TEMPLATE_COMPILED:    return F("parseTemplate compiled");
     case TimingStatsElements::PARSE_SYSVAR:               return F("parseSystemVariables()");
     case TimingStatsElements::PARSE_SYSVAR_NOCHANGE:      return F("parseSystemVariables() No change");
     case TimingStatsElements::HANDLE_SERVING_WEBPAGE:     return F("handle webpage");
@@ -329,4 +332,32 @@ void addMiscTimerStat(TimingStatsElements L, int64_t T)
   if (Settings.EnableTimingStats()) { miscStats[L].add(T); }
 }
 
+void addSchedulerTimingStat(SchedulerTimerType_e timerType, long lateness, uint64_t statisticsTimerStart)
+{
+  if (Settings.EnableTimingStats()) {
+    SchedulerTimingStats& stats = schedulerStats[timerType];
+
+    // Jobs may be processed slightly before their scheduled time.
+    stats.lateness.add(lateness > 0 ? lateness : 0);
+    stats.duration.add(usecPassedSince(statisticsTimerStart));
+  }
+}
+
+ControllerSendTimingStats* getControllerSendTimingStats(controllerIndex_t controllerIndex)
+{
+  if (!Settings.EnableTimingStats() || !validControllerIndex(controllerIndex)) { return nullptr; }
+  return &controllerSendStats[controllerIndex];
+}
+
+void addControllerSendTimingStat(controllerIndex_t controllerIndex, bool success, long duration)
+{
+  ControllerSendTimingStats *stats = getControllerSendTimingStats(controllerIndex);
+
+  if (stats != nullptr) {
+    stats->rtt.add(duration > 0 ? duration : 0);
+
+    if (!success) { ++stats->failures; }
+  }
+}
+
 #endif // if FEATURE_TIMING_STATS
@@ -5,9 +5,12 @@
 
 #if FEATURE_TIMING_STATS
 
+# include "../DataTypes/ControllerIndex.h"
 # include "../DataTypes/DeviceIndex.h"
 # include "../DataTypes/ESPEasy_plugin_functions.h"
 # include "../DataTypes/ProtocolIndex.h"
+# include "../DataTypes/SchedulerTimerType.h"
+# include "../DataStructs/LatencyHistogram.h"
 # include "../Globals/Settings.h"
 # include "../Helpers/ESPEasy_time_calc.h"
 
@@ -67,6 +70,7 @@ enum class TimingStatsElements {
   PARSE_SYSVAR,
   PARSE_SYSVAR_NOCHANGE,
   PARSE_TEMPLATE_PADDED,
+  PARSE_TEMPLATE_COMPILED,
   IS_NUMERICAL,
   GET_TASKVALUE_AS_STRING,
   FORMAT_USER_VAR,
@@ -149,6 +153,29 @@ private:
   uint64_t _minVal;
 };
 
+// Latency distribution of the scheduled jobs, per scheduler timer type.
+struct SchedulerTimingStats {
+  // Time between the scheduled time and the actual start of the job (msec)
+  LatencyHistogram lateness;
+
+  // Time needed to run the job (usec)
+  LatencyHistogram duration;
+};
+
+// Statistics of sending messages, per controller index.
+struct ControllerSendTimingStats {
+  // Duration of connecting to the MQTT broker or sending a queued message (msec)
+  LatencyHistogram rtt;
+
+  // Time between queueing a message and sending it successfully (msec)
+  LatencyHistogram queueWait;
+
+  uint32_t failures = 0; // Failed connection attempts or sends
+  uint32_t retries  = 0; // Messages which could not be sent and remained in the queue
+  uint32_t drops    = 0; // Messages removed from the queue without being sent
+  uint32_t interval = 0; // Last used time between messages (msec)
+};
+
 
 const __FlashStringHelper* getPluginFunctionName(int function);
 bool                       mustLogFunction(int function);
@@ -166,10 +193,23 @@ void                       stopTimer(TimingStatsElements L,
                                      uint64_t            statisticsTimerStart);
 void                       addMiscTimerStat(TimingStatsElements L,
                                             int64_t             T);
+void                       addSchedulerTimingStat(SchedulerTimerType_e timerType,
+                                                  long                 lateness,
+                                                  uint64_t             statisticsTimerStart);
+
+// Return nullptr when timing stats are not enabled.
+ControllerSendTimingStats* getControllerSendTimingStats(controllerIndex_t controllerIndex);
+
+// Add the duration (msec) and result of connecting or sending by a controller.
+void                       addControllerSendTimingStat(controllerIndex_t controllerIndex,
+                                                       bool              success,
+                                                       long              duration);
 
 extern std::map<int, TimingStats> pluginStats;
 extern std::map<int, TimingStats> controllerStats;
 extern std::map<TimingStatsElements, TimingStats> miscStats;
+extern std::map<SchedulerTimerType_e, SchedulerTimingStats> schedulerStats;
+extern std::map<controllerIndex_t, ControllerSendTimingStats> controllerSendStats;
 extern unsigned long timingstats_last_reset;
 
 # define START_TIMER const uint64_t statisticsTimerStart(getMicros64());
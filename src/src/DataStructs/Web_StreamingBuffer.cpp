@@ -14,38 +14,38 @@
 
 #include "../../ESPEasy_common.h"
 
-#ifdef ESP8266
-#define CHUNKED_BUFFER_SIZE         512
-#else 
-#define CHUNKED_BUFFER_SIZE         4096
-#endif
+#include <algorithm>
+
 
 Web_StreamingBuffer::Web_StreamingBuffer(void) : lowMemorySkip(false),
   initialRam(0), beforeTXRam(0), duringTXRam(0), finalRam(0), maxCoreUsage(0),
   maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0)
-{
-  buf.reserve(CHUNKED_BUFFER_SIZE + 50);
-  buf.clear();
-}
+{}
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(char a)                   {
-  if (this->buf.length() >= CHUNKED_BUFFER_SIZE) {
+  if (lowMemorySkip) { return *this; }
+  if (bufLength >= CHUNKED_BUFFER_SIZE) {
     flush();
   }
-  this->buf += a;
+  buf[bufLength++] = a;
   return *this;
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(uint64_t a) {
-  return addString(ull2String(a));
+  return addInteger(a, false);
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(int64_t a) {
-  return addString(ll2String(a));
+  return addInteger(a);
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::operator+=(const float& a)           {
-  return addString(toString(a, 2));
+  // Same as toString(a, 2), without allocating a String
+  char tmp[2 + 42];
+  const char *str = dtostrf(a, 4, 2, tmp);
+
+  while (*str == ' ') { ++str; }
+  return addBuffer(str, strlen(str));
 }
 
 #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
@@ -80,16 +80,14 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
   if (mmu_is_iram(str)) {
     // Have to copy the string using mmu_get functions
     // This is not a flash string.
-    bool done = false;
     const char* cur_char = str;
-    while (!done) {
+    while (length != 0) {
       const uint8_t ch = mmu_get_uint8(cur_char++);
-      if (ch == 0) return *this;
-      if (this->buf.length() >= CHUNKED_BUFFER_SIZE) {
-        flush();
-      }
-      this->buf += (char)ch;
+      if (ch == 0 && length < 0) return *this;
+      *this += (char)ch;
+      --length;
     }
+    return *this;
   }
   #endif
 
@@ -97,79 +95,96 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
 
   if (lowMemorySkip) { return *this; }
 
-  checkFull();
+  // Only check for \0 when no length was given, as it may be binary data
+  size_t remaining = (length < 0) ? strlen_P(str) : length;
 
-  int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
-  if (flush_step < 1) { flush_step = 0; }
+  flashStringData += remaining;
 
-  {
-    // Copy to internal buffer and send in chunks
-    PGM_P pos = str;
-    while (length != 0) {
-      if (flush_step == 0) {
-        flush();
-        flush_step = CHUNKED_BUFFER_SIZE;
-      }
-      const char c = (char)pgm_read_byte(pos);
-      if (c == '\0' && length < 0) {
-        // Only check for \0 when length was given (e.g. binary data)
-        return *this;
-      }
-      this->buf += c;
-      ++flashStringData;
-      ++pos;
-      --length;
-      --flush_step;
+  if (remaining >= CHUNKED_FLASH_DIRECT_SIZE) {
+    // Send what is already in the buffer, followed by the flash string itself.
+    trackTotalMem();
+    flush();
+    sendContentBlocking(str, remaining);
+    return *this;
+  }
+
+  PGM_P pos = str;
+  while (remaining > 0) {
+    if (bufLength >= CHUNKED_BUFFER_SIZE) {
+      checkFull();
     }
+    const size_t nrBytes = std::min(remaining, static_cast<size_t>(CHUNKED_BUFFER_SIZE - bufLength));
+    memcpy_P(buf + bufLength, pos, nrBytes);
+    bufLength += nrBytes;
+    pos       += nrBytes;
+    remaining -= nrBytes;
   }
   return *this;
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
-  if (lowMemorySkip) { return *this; }
-  const unsigned int length = a.length();
-  if (length == 0) { return *this; }
+  return addBuffer(a.c_str(), a.length());
+}
 
-  checkFull();
-  int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
+Web_StreamingBuffer& Web_StreamingBuffer::addInteger(int64_t value) {
+  if (value < 0) {
+    // Negate as unsigned value, to also handle the lowest int64_t value.
+    return addInteger(static_cast<uint64_t>(0) - static_cast<uint64_t>(value), true);
+  }
+  return addInteger(static_cast<uint64_t>(value), false);
+}
 
-  if (flush_step < 1) { flush_step = 0; }
+Web_StreamingBuffer& Web_StreamingBuffer::addInteger(uint64_t value, bool negative) {
+  // Format from the end of a small buffer, like ull2String() does, but without allocating a String.
+  char  tmp[21];
+  char *end = tmp + sizeof(tmp);
+  char *pos = end;
 
-  if (length < static_cast<unsigned int>(flush_step)) {
-    // Just use the faster String operator to copy flash strings.
-    this->buf += a;
-    return *this;
+  // 64 bit divisions are slow, so only use those for values not fitting in 32 bit.
+  while (value > 0xFFFFFFFFull) {
+    *--pos = '0' + static_cast<char>(value % 10);
+    value /= 10;
   }
+  uint32_t value32 = static_cast<uint32_t>(value);
+
+  do {
+    *--pos   = '0' + static_cast<char>(value32 % 10);
+    value32 /= 10;
+  } while (value32 != 0);
 
-  unsigned int pos = 0;
-  while (pos < length) {
-    if (flush_step == 0) {
-      flush();
-      flush_step = CHUNKED_BUFFER_SIZE;
-    } else {
-      // Just copy per byte instead of using substring as substring needs to allocate memory.
-      this->buf += a[pos];
-      ++pos;
-      --flush_step;
+  if (negative) {
+    *--pos = '-';
+  }
+  return addBuffer(pos, end - pos);
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::addBuffer(const char *data, size_t length) {
+  if (lowMemorySkip) { return *this; }
+
+  while (length > 0) {
+    if (bufLength >= CHUNKED_BUFFER_SIZE) {
+      checkFull();
     }
+    const size_t nrBytes = std::min(length, static_cast<size_t>(CHUNKED_BUFFER_SIZE - bufLength));
+    memcpy(buf + bufLength, data, nrBytes);
+    bufLength += nrBytes;
+    data      += nrBytes;
+    length    -= nrBytes;
   }
   return *this;
 }
 
 void Web_StreamingBuffer::flush() {
-  if (lowMemorySkip) {
-    this->buf.clear();
-  } else {
-    if (this->buf.length() > 0) {
-      sendContentBlocking(this->buf);
-    }
+  if (!lowMemorySkip && (bufLength > 0)) {
+    sendContentBlocking(buf, bufLength);
   }
+  bufLength = 0;
 }
 
 void Web_StreamingBuffer::checkFull() {
-  if (lowMemorySkip) { this->buf.clear(); }
+  if (lowMemorySkip) { bufLength = 0; }
 
-  if (this->buf.length() >= CHUNKED_BUFFER_SIZE) {
+  if (bufLength >= CHUNKED_BUFFER_SIZE) {
     trackTotalMem();
     flush();
   }
@@ -204,9 +219,8 @@ void Web_StreamingBuffer::startStream(bool allowOriginAll,
   initialRam   = ESP.getFreeHeap();
   beforeTXRam  = initialRam;
   sentBytes    = 0;
-  buf.clear();
-  buf.reserve(CHUNKED_BUFFER_SIZE);
-  
+  bufLength    = 0;
+
   if (beforeTXRam < 3000) {
     lowMemorySkip = true;
     web_server.send_P(200, (PGM_P)F("text/plain"), (PGM_P)F("Low memory. Cannot display webpage :-("));
@@ -249,9 +263,10 @@ void Web_StreamingBuffer::endStream() {
   #endif
 
   if (!lowMemorySkip) {
-    if (buf.length() > 0) { sendContentBlocking(buf); }
-    buf.clear();
-    sendContentBlocking(buf);
+    flush();
+
+    // Empty chunk marks the end of the chunked transfer
+    sendContentBlocking(buf, 0);
 
     web_server.client().flush();
 
@@ -279,14 +294,13 @@ void Web_StreamingBuffer::endStream() {
 
 
 
-void Web_StreamingBuffer::sendContentBlocking(String& data) {
+void Web_StreamingBuffer::sendContentBlocking(const char *data, size_t length) {
   #ifdef USE_SECOND_HEAP
   HeapSelectDram ephemeral;
   #endif
 
   delay(0); // Try to prevent WDT reboots
 
-  const uint32_t length   = data.length();
 #ifndef BUILD_NO_DEBUG
   if (loglevelActiveFor(LOG_LEVEL_DEBUG_DEV)) {
     String log;
@@ -313,21 +327,16 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
   // do chunked transfer encoding ourselves (WebServer doesn't support it)
   web_server.sendContent(size);
 
-  if (length > 0) { web_server.sendContent(data); }
+  if (length > 0) { web_server.sendContent_P(data, length); }
   web_server.sendContent("\r\n");
 #else // ESP8266 2.4.0rc2 and higher and the ESP32 webserver supports chunked http transfer
   unsigned int timeout = 100;
 
-  web_server.sendContent(data);
-
-  if (data.length() > CHUNKED_BUFFER_SIZE) {
-    data = String(); // Clear also allocated memory
-  } else {
-    data.clear();
-  }
+  // sendContent_P() can be used for data in RAM and in flash.
+  web_server.sendContent_P(data, length);
 
   const uint32_t beginWait = millis();
-  while ((!data.reserve(CHUNKED_BUFFER_SIZE) || (ESP.getFreeHeap() < 4000 /*freeBeforeSend*/ )) &&
+  while ((ESP.getFreeHeap() < 4000 /*freeBeforeSend*/ ) &&
          !timeOutReached(beginWait + timeout)) {
     if (ESP.getFreeHeap() < duringTXRam) {
       duringTXRam = ESP.getFreeHeap();
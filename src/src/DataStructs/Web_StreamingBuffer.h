@@ -2,8 +2,21 @@
 #define DATASTRUCTS_WEB_STREAMINGBUFFER_H
 
 #include <map>
+#include <type_traits>
 #include "../../ESPEasy_common.h"
 
+#ifdef ESP8266
+#define CHUNKED_BUFFER_SIZE         512
+#else 
+#define CHUNKED_BUFFER_SIZE         4096
+#endif
+
+// Flash strings of at least this length are sent directly from flash,
+// instead of being copied into the buffer first.
+#ifndef CHUNKED_FLASH_DIRECT_SIZE
+#define CHUNKED_FLASH_DIRECT_SIZE   (CHUNKED_BUFFER_SIZE / 2)
+#endif
+
 
 // ********************************************************************************
 // Core part of WebServer, the chunked streaming buffer
@@ -29,7 +42,10 @@ public:
 
 private:
 
-  String buf;
+  // Fixed size buffer, sent as a single chunk when full.
+  // No need for a second buffer, as sending a chunk blocks until the data is handed over to the TCP stack.
+  char     buf[CHUNKED_BUFFER_SIZE];
+  uint16_t bufLength = 0;
 
 public:
 
@@ -45,8 +61,22 @@ public:
   Web_StreamingBuffer& operator+=(const double& a);
 #endif
 
-template <typename T>
-  Web_StreamingBuffer& operator+=(T a) {
+  // Integer values are formatted directly into the buffer
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, Web_StreamingBuffer&>::type
+  operator+=(T a) {
+    return addInteger(static_cast<int64_t>(a));
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, Web_StreamingBuffer&>::type
+  operator+=(T a) {
+    return addInteger(static_cast<uint64_t>(a), false);
+  }
+
+  template <typename T>
+  typename std::enable_if<!std::is_integral<T>::value, Web_StreamingBuffer&>::type
+  operator+=(T a) {
     return addString(String(a));
   }
 
@@ -59,6 +89,12 @@ template <typename T>
 private:
   Web_StreamingBuffer& addString(const String& a);
 
+  Web_StreamingBuffer& addInteger(int64_t value);
+  Web_StreamingBuffer& addInteger(uint64_t value, bool negative);
+
+  // Copy data from RAM into the buffer, sending the buffer each time it is full.
+  Web_StreamingBuffer& addBuffer(const char *data, size_t length);
+
 public:
   void flush();
 
@@ -89,7 +125,7 @@ public:
 
 private: 
 
-  void sendContentBlocking(String& data);
+  void sendContentBlocking(const char *data, size_t length);
   void sendHeaderBlocking(bool          allowOriginAll,
                           const String& content_type,
                           const String& origin,
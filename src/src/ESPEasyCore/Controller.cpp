@@ -23,6 +23,7 @@
 #include "../Globals/MQTT.h"
 #include "../Globals/Plugins.h"
 #include "../Globals/RulesCalculate.h"
+#include "../Globals/SendDataFilter.h"
 
 #include "../Helpers/_CPlugin_Helper.h"
 #include "../Helpers/Misc.h"
@@ -54,6 +55,12 @@ void sendData(struct EventStruct *event)
 
 //  LoadTaskSettings(event->TaskIndex); // could have changed during background tasks.
 
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+  // Evaluate the "Send On Change" settings of the task values only once for all controllers.
+  const bool mustSend = SendDataFilter.mustSend(event);
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
   for (controllerIndex_t x = 0; x < CONTROLLER_MAX; x++)
   {
     event->ControllerIndex = x;
@@ -65,6 +72,14 @@ void sendData(struct EventStruct *event)
     {
       protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(event->ControllerIndex);
 
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+      if (!mustSend && !Cache.getControllerIgnoreSendOnChange(event->ControllerIndex)) {
+        SendDataFilter.countSuppressed(event->TaskIndex, event->ControllerIndex);
+        continue;
+      }
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
       if (validUserVar(event)) {
         String dummy;
         CPluginCall(ProtocolIndex, CPlugin::Function::CPLUGIN_PROTOCOL_SEND, event, dummy);
@@ -135,17 +150,12 @@ void incoming_mqtt_callback(char *c_topic, uint8_t *b_payload, unsigned int leng
 
   deviceIndex_t DeviceIndex = getDeviceIndex(PLUGIN_ID_MQTT_IMPORT); // Check if P037_MQTTimport is present in the build
 
-  if (validDeviceIndex(DeviceIndex)) {
-    //  Here we loop over all tasks and call each 037 plugin with function PLUGIN_MQTT_IMPORT
-    for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
-    {
-      if (Settings.TaskDeviceEnabled[taskIndex] && (Settings.getPluginID_for_task(taskIndex) == PLUGIN_ID_MQTT_IMPORT))
-      {
-        Scheduler.schedule_mqtt_plugin_import_event_timer(
-          DeviceIndex, taskIndex, PLUGIN_MQTT_IMPORT,
-          c_topic, b_payload, length);
-      }
-    }
+  if (validDeviceIndex(DeviceIndex) && MQTTimport_subscriptions.hasMatch(c_topic)) {
+    // Schedule a single PLUGIN_MQTT_IMPORT call holding the only copy of topic and payload.
+    // It will be dispatched to the MQTT import tasks with a matching subscription.
+    Scheduler.schedule_mqtt_plugin_import_event_timer(
+      DeviceIndex, PLUGIN_MQTT_IMPORT,
+      c_topic, b_payload, length);
   }
 }
 
@@ -259,6 +269,9 @@ bool MQTTConnect(controllerIndex_t controller_idx)
   delay(0);
 
   count_connection_results(MQTTresult, F("MQTT : Broker "), Settings.Protocol[controller_idx], connect_start_time);
+#if FEATURE_TIMING_STATS
+  addControllerSendTimingStat(controller_idx, MQTTresult, timePassedSince(connect_start_time));
+#endif // if FEATURE_TIMING_STATS
 
   if (!MQTTresult) {
     MQTTclient.disconnect();
@@ -17,10 +17,12 @@
 # include "../Globals/NetworkState.h"
 # include "../Globals/Settings.h"
 
+# include "../Helpers/_CPlugin_Helper.h"
 # include "../Helpers/Network.h"
 # include "../Helpers/Networking.h"
 # include "../Helpers/PeriodicalActions.h"
 # include "../Helpers/StringConverter.h"
+# include "../Helpers/SystemVariables.h"
 
 # include <ETH.h>
 
@@ -116,6 +118,7 @@ void processEthernetConnected() {
   addLog(LOG_LEVEL_INFO, F("processEthernetConnected()"));
   EthEventData.setEthConnected();
   EthEventData.processedConnect = true;
+  SystemVariables::markNetworkChanged();
 
   if (Settings.UseRules)
   {
@@ -131,6 +134,11 @@ void processEthernetDisconnected() {
   EthEventData.setEthDisconnected();
   EthEventData.processedDisconnect     = true;
   EthEventData.ethConnectAttemptNeeded = true;
+  clearDNScache();
+  SystemVariables::markNetworkChanged();
+  # if FEATURE_HTTP_CLIENT
+  closeIdleControllerHTTPConnections(true);
+  # endif // if FEATURE_HTTP_CLIENT
 
   if (Settings.UseRules)
   {
@@ -151,6 +159,7 @@ void processEthernetGotIP() {
   if (!ip) {
     return;
   }
+  SystemVariables::markNetworkChanged();
 
   const IPAddress gw     = NetworkGatewayIP();
   const IPAddress subnet = NetworkSubnetMask();
@@ -195,6 +195,12 @@ bool rulesProcessingFile(const String& fileName,
 
   bool moreAvailable = true;
   bool eventHandled = false;
+#if FEATURE_RULES_COMPILER
+
+  if (rulesProcessingCompiled(fileName, event, pos, startOnMatched, eventHandled)) {
+    moreAvailable = false;
+  }
+#endif // if FEATURE_RULES_COMPILER
   while (moreAvailable && !eventHandled) {
     const bool searchNextOnBlock = !codeBlock && !match;
     String line = Cache.rulesHelper.readLn(fileName, pos, moreAvailable, searchNextOnBlock);
@@ -243,6 +249,238 @@ bool rulesProcessingFile(const String& fileName,
 }
 
 
+#if FEATURE_RULES_COMPILER
+
+/********************************************************************************************\
+   Rules processing using the pre-parsed image of a rules file
+ \*********************************************************************************************/
+static String readCompiledRulesLine(const String& fileName, const RulesCompiled_element& element)
+{
+  return Cache.rulesHelper.readCompiledLn(fileName, element);
+}
+
+static bool evaluateCompiledRulesCondition(const String& fileName, const RulesCompiled_element& element,
+                                           const String& event, uint8_t ifBlock)
+{
+  String check = readCompiledRulesLine(fileName, element);
+
+  substitute_eventvalue(check, event);
+  check = parseTemplate(check);
+  check.toLowerCase();
+
+  // Strip the "if " or "elseif " keyword
+  check = check.substring(element._opcode == RulesOpcode::If ? 3 : 7);
+  check.trim();
+
+  const bool condition = conditionMatchExtended(check);
+#ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log  = F("Lev.");
+    log += String(ifBlock);
+    log += element._opcode == RulesOpcode::If ? F(": [if ") : F(": [elseif ");
+    log += check;
+    log += F("]=");
+    log += boolToString(condition);
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+#endif // ifndef BUILD_NO_DEBUG
+  return condition;
+}
+
+// Returns true when the block was ended by its "endon".
+// Like the text interpreter, a block running into the end of the file
+// does not mark the event as handled.
+static bool processCompiledRulesBlock(const String            & fileName,
+                                      const RulesCompiledImage& image,
+                                      size_t                    index,
+                                      const String            & event)
+{
+  bool    ifBranche[RULES_IF_MAX_NESTING_LEVEL];
+  uint8_t ifBlock = 0;
+
+  for (++index; index < image.size(); ++index) {
+    const RulesCompiled_element& element = image[index];
+
+    switch (element._opcode) {
+      case RulesOpcode::On:
+      case RulesOpcode::EndOn:
+        return true;
+      case RulesOpcode::If:
+
+        if (ifBlock >= RULES_IF_MAX_NESTING_LEVEL) {
+          if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+            String log  = F("Lev.");
+            log += String(ifBlock);
+            log += F(": Error: IF Nesting level exceeded!");
+            addLogMove(LOG_LEVEL_ERROR, log);
+          }
+
+          // Skip the entire if-block including its "endif"
+          index = image.getEndIf(index);
+
+          if ((index < image.size()) && (image[index]._opcode != RulesOpcode::EndIf)) {
+            // Missing "endif", let the "endon" end the block
+            --index;
+          }
+          break;
+        }
+        ++ifBlock;
+        ifBranche[ifBlock - 1] = evaluateCompiledRulesCondition(fileName, element, event, ifBlock);
+
+        if (!ifBranche[ifBlock - 1]) {
+          // Continue at the next elseif, else or endif
+          index = element._jump - 1;
+        }
+        break;
+      case RulesOpcode::ElseIf:
+
+        if (ifBlock == 0) { break; }
+
+        if (ifBranche[ifBlock - 1]) {
+          // Already executed a branch of this if-block
+          index = image.getEndIf(index) - 1;
+        } else {
+          ifBranche[ifBlock - 1] = evaluateCompiledRulesCondition(fileName, element, event, ifBlock);
+
+          if (!ifBranche[ifBlock - 1]) {
+            index = element._jump - 1;
+          }
+        }
+        break;
+      case RulesOpcode::Else:
+
+        if (ifBlock == 0) { break; }
+
+        if (ifBranche[ifBlock - 1]) {
+          index = image.getEndIf(index) - 1;
+        } else {
+          ifBranche[ifBlock - 1] = true;
+        }
+        break;
+      case RulesOpcode::EndIf:
+
+        if (ifBlock) {
+          --ifBlock;
+        }
+        break;
+      case RulesOpcode::Command:
+      {
+        START_TIMER
+        String action = readCompiledRulesLine(fileName, element);
+        substitute_eventvalue(action, event);
+        action = parseTemplate(action);
+
+        if (element._flag) {
+          action = String(F("restrict,")) + action;
+
+          if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+            String log = F("Rules : Prefix command with 'restrict': ");
+            log += action;
+            addLogMove(LOG_LEVEL_ERROR, log);
+          }
+        }
+        executeRulesAction(action, event);
+        STOP_TIMER(RULES_PROCESS_MATCHED);
+        break;
+      }
+    }
+  }
+  return false;
+}
+
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos,
+                             bool          startOnMatched,
+                             bool        & eventHandled)
+{
+  if ((pos != 0) && !startOnMatched) {
+    return false;
+  }
+
+  // Keep a reference to the image as long as we're using it,
+  // since executing commands may trigger reloading the rules.
+  std::shared_ptr<const RulesCompiledImage> image = Cache.rulesHelper.getCompiledImage(fileName);
+
+  if (!image) {
+    return false;
+  }
+
+  size_t index = 0;
+
+  if (startOnMatched) {
+    index = image->findOnElement(pos);
+
+    if (index >= image->size()) {
+      // Image does not match the position found in the event cache
+      return false;
+    }
+  }
+
+  const RulesMatcher_event rulesEvent(event);
+
+  while (index < image->size() && !eventHandled) {
+    const RulesCompiled_element& element = (*image)[index];
+
+    if (element._opcode != RulesOpcode::On) {
+      ++index;
+      continue;
+    }
+    String line = readCompiledRulesLine(fileName, element);
+    {
+      START_TIMER
+      line = parseTemplate(line);
+      STOP_TIMER(RULES_PARSE_LINE);
+    }
+    String ruleEvent, action;
+    bool   match = false;
+
+    if (getEventFromRulesLine(line, ruleEvent, action)) {
+      START_TIMER
+      match = startOnMatched || ruleMatch(rulesEvent, ruleEvent);
+      STOP_TIMER(RULES_MATCH);
+    }
+
+    if (!match && (action.length() > 0)) {
+      // Like the text interpreter, any one-liner ends processing the file,
+      // also when it did not match.
+      eventHandled = true;
+      break;
+    }
+
+    if (match) {
+      // Matched blocks are likely to match again soon.
+      Cache.rulesHelper.cacheCompiledBlock(fileName, *image, index);
+
+      if (action.length() > 0) {
+        // single on/do/action line, no block
+        bool    isCommand = true;
+        bool    condition[RULES_IF_MAX_NESTING_LEVEL];
+        bool    ifBranche[RULES_IF_MAX_NESTING_LEVEL];
+        uint8_t ifBlock     = 0;
+        uint8_t fakeIfBlock = 0;
+
+        START_TIMER
+        processMatchedRule(action, event,
+                           isCommand, condition,
+                           ifBranche, ifBlock, fakeIfBlock);
+        STOP_TIMER(RULES_PROCESS_MATCHED);
+        eventHandled = true;
+      } else {
+        eventHandled = processCompiledRulesBlock(fileName, *image, index, event);
+      }
+    }
+
+    // Skip the block of this "on ... do"
+    index          = element._jump + 1;
+    startOnMatched = false;
+  }
+  return true;
+}
+
+#endif // if FEATURE_RULES_COMPILER
+
 /********************************************************************************************\
    Parse string commands
  \*********************************************************************************************/
@@ -976,23 +1214,27 @@ void processMatchedRule(String& action, const String& event,
   // process the action if it's a command and unconditional, or conditional and
   // the condition matches the if or else block.
   if (isCommand) {
-    substitute_eventvalue(action, event);
+    executeRulesAction(action, event);
+  }
+}
 
-    const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
+void executeRulesAction(String& action, const String& event) {
+  substitute_eventvalue(action, event);
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
-      actionlog += action;
-      addLogMove(LOG_LEVEL_INFO, actionlog);
-    }
+  const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
 
-    if (executeRestricted) {
-      ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2).c_str());
-    } else {
-      ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str());
-    }
-    delay(0);
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
+    actionlog += action;
+    addLogMove(LOG_LEVEL_INFO, actionlog);
+  }
+
+  if (executeRestricted) {
+    ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2).c_str());
+  } else {
+    ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str());
   }
+  delay(0);
 }
 
 /********************************************************************************************\
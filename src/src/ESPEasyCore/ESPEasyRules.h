@@ -37,6 +37,19 @@ bool rulesProcessingFile(const String& fileName,
                          bool   startOnMatched = false);
 
 
+#if FEATURE_RULES_COMPILER
+
+/********************************************************************************************\
+   Rules processing using the pre-parsed image of a rules file
+   Return false when no image is available and the rules text must be processed instead.
+ \*********************************************************************************************/
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos,
+                             bool          startOnMatched,
+                             bool        & eventHandled);
+
+#endif // if FEATURE_RULES_COMPILER
 
 /********************************************************************************************\
    Parse string commands
@@ -90,6 +103,11 @@ void processMatchedRule(String& action,
                         uint8_t  & ifBlock,
                         uint8_t  & fakeIfBlock);
 
+// Execute a single command from the rules, substituting %eventvalue% and
+// handling the optional "restrict" prefix.
+void executeRulesAction(String      & action,
+                        const String& event);
+
 
 /********************************************************************************************\
    Check expression
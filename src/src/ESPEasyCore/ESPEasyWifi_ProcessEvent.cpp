@@ -20,6 +20,7 @@
 #include "../Globals/Settings.h"
 #include "../Globals/WiFi_AP_Candidates.h"
 
+#include "../Helpers/_CPlugin_Helper.h"
 #include "../Helpers/Convert.h"
 #include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/ESPEasy_Storage.h"
@@ -29,6 +30,7 @@
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_WiFi.h"
 #include "../Helpers/StringProvider.h"
+#include "../Helpers/SystemVariables.h"
 
 // #include "../ESPEasyCore/ESPEasyEth.h"
 // #include "../ESPEasyCore/ESPEasyWiFiEvent.h"
@@ -238,6 +240,11 @@ void processDisconnect() {
       WiFiEventData.processingDisconnect.isSet()) { return; }
   WiFiEventData.processingDisconnect.setNow();
   WiFiEventData.setWiFiDisconnected();
+  clearDNScache();
+  SystemVariables::markNetworkChanged();
+  #if FEATURE_HTTP_CLIENT
+  closeIdleControllerHTTPConnections(true);
+  #endif // if FEATURE_HTTP_CLIENT
   WiFiEventData.wifiConnectAttemptNeeded = true;
   delay(100); // FIXME TD-er: See https://github.com/letscontrolit/ESPEasy/issues/1987#issuecomment-451644424
 
@@ -290,6 +297,7 @@ void processConnect() {
     return;
   }
   WiFiEventData.processedConnect = true;
+  SystemVariables::markNetworkChanged();
   if (WiFi.status() == WL_DISCONNECTED) {
     // Apparently not really connected
     return;
@@ -372,6 +380,7 @@ void processGotIP() {
   if (checkAndResetWiFi()) {
     return;
   }
+  SystemVariables::markNetworkChanged();
 
   IPAddress ip = NetworkLocalIP();
 
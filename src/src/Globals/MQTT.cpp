@@ -13,6 +13,8 @@ bool MQTTclient_must_send_LWT_connected = false;
 bool MQTTclient_connected               = false;
 int  mqtt_reconnect_count               = 0;
 LongTermTimer MQTTclient_next_connect_attempt;
+
+MQTT_SubscriptionIndex MQTTimport_subscriptions;
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
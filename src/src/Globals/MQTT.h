@@ -9,6 +9,7 @@
 # include <WiFiClient.h>
 # include <PubSubClient.h>
 
+#include "../DataStructs/MQTT_SubscriptionIndex.h"
 #include "../Helpers/LongTermTimer.h"
 
 // MQTT client
@@ -19,6 +20,9 @@ extern bool MQTTclient_must_send_LWT_connected;
 extern bool MQTTclient_connected;
 extern int  mqtt_reconnect_count;
 extern LongTermTimer MQTTclient_next_connect_attempt;
+
+// Subscriptions of all MQTT import tasks, used to dispatch incoming messages
+extern MQTT_SubscriptionIndex MQTTimport_subscriptions;
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
@@ -43,9 +43,7 @@ CalculateReturnCode Calculate(const String& input,
                               ESPEASY_RULES_FLOAT_TYPE      & result)
 {
   START_TIMER;
-  CalculateReturnCode returnCode = RulesCalculate.doCalculate(
-    RulesCalculate_t::preProces(input).c_str(),
-    &result);
+  CalculateReturnCode returnCode = RulesCalculate.doCalculateCached(input, &result);
 
   if (isError(returnCode)) {
     if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
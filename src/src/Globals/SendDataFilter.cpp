@@ -0,0 +1,7 @@
+#include "../Globals/SendDataFilter.h"
+
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+SendDataFilterStruct SendDataFilter;
+
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
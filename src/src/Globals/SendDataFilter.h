@@ -0,0 +1,14 @@
+#ifndef GLOBALS_SENDDATAFILTER_H
+#define GLOBALS_SENDDATAFILTER_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+# include "../DataStructs/SendDataFilterStruct.h"
+
+extern SendDataFilterStruct SendDataFilter;
+
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+#endif // ifndef GLOBALS_SENDDATAFILTER_H
@@ -8,8 +8,10 @@ int           calc_CRC16(const String& text);
 int IRAM_ATTR calc_CRC16(const char *ptr,
                          int         count);
 
+// Use the returned value as 'crc' to continue the checksum over another block of data.
 uint32_t      calc_CRC32(const uint8_t *data,
-                         size_t         length);
+                         size_t         length,
+                         uint32_t       crc = 0xffffffff);
 
 uint8_t       calc_CRC8(const uint8_t *data,
                         size_t         length);
@@ -6,6 +6,7 @@
 #include "../DataStructs/TimingStats.h"
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../Helpers/Convert.h"
+#include "../Helpers/StringConverter.h"
 #include "../Helpers/_Plugin_init.h"
 
 
@@ -22,6 +23,14 @@ void stream_json_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   json_prop(F("unit"), F("usec"));
 }
 
+void stream_json_latency_histogram(const LatencyHistogram& histogram, const __FlashStringHelper *unit) {
+  json_number(F("p50"), String(histogram.getPercentile(50)));
+  json_number(F("p95"), String(histogram.getPercentile(95)));
+  json_number(F("p99"), String(histogram.getPercentile(99)));
+  json_number(F("max"), String(histogram.getMax()));
+  json_prop(F("unit"), unit);
+}
+
 void jsonStatistics(bool clearStats) {
   bool firstPlugin     = true;
   deviceIndex_t  currentDeviceIndex = INVALID_DEVICE_INDEX;
@@ -131,10 +140,61 @@ void jsonStatistics(bool clearStats) {
 
   json_close(true);   // Close misc list
 
+
+  json_open(true, F("scheduler"));
+  for (auto& x: schedulerStats) {
+    if (!x.second.duration.isEmpty()) {
+      json_open(); // open new scheduler item
+      json_prop(F("name"), toString(x.first));
+      json_prop(F("id"),   String(static_cast<int>(x.first)));
+      json_number(F("count"), String(x.second.duration.getCount()));
+      json_open(false, F("lateness"));
+      {
+        stream_json_latency_histogram(x.second.lateness, F("msec"));
+      }
+      json_close(false);
+      json_open(false, F("duration"));
+      {
+        stream_json_latency_histogram(x.second.duration, F("usec"));
+      }
+      json_close(false);
+      json_close();     // close scheduler item
+    }
+  }
+
+  json_close(true);   // Close scheduler list
+
+  json_open(true, F("controller_send"));
+  for (auto& x: controllerSendStats) {
+    json_open(); // open new controller item
+    json_prop(F("name"), get_formatted_Controller_number(Settings.Protocol[x.first]));
+    json_prop(F("id"),   String(x.first + 1));
+    json_number(F("sent"),     String(x.second.queueWait.getCount()));
+    json_number(F("failures"), String(x.second.failures));
+    json_number(F("retries"),  String(x.second.retries));
+    json_number(F("drops"),    String(x.second.drops));
+    json_number(F("interval"), String(x.second.interval));
+    json_open(false, F("rtt"));
+    {
+      stream_json_latency_histogram(x.second.rtt, F("msec"));
+    }
+    json_close(false);
+    json_open(false, F("queue_wait"));
+    {
+      stream_json_latency_histogram(x.second.queueWait, F("msec"));
+    }
+    json_close(false);
+    json_close();     // close controller item
+  }
+
+  json_close(true);   // Close controller_send list
+
   if (clearStats) {
     pluginStats.clear();
     controllerStats.clear();
     miscStats.clear();
+    schedulerStats.clear();
+    controllerSendStats.clear();
     timingstats_last_reset = millis();
   }
 }
@@ -13,6 +13,8 @@
 
 void stream_json_timing_stats(const TimingStats& stats, long timeSinceLastReset);
 
+void stream_json_latency_histogram(const LatencyHistogram& histogram, const __FlashStringHelper *unit);
+
 void jsonStatistics(bool clearStats);
 
 #endif // if FEATURE_TIMING_STATS
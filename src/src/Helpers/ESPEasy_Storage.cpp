@@ -177,6 +177,9 @@ fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e
       return f;
     }
     clearFileCaches();
+  } else if (!equals(mode, 'r')) {
+    // Content may change, checksum used as ETag is no longer valid.
+    Cache.fileContentChecksums.erase(patch_fname(fname));
   }
   if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
     f = ESPEASY_FS.open(patch_fname(fname), mode.c_str());
@@ -1245,6 +1248,9 @@ String SaveControllerSettings(controllerIndex_t ControllerIndex, ControllerSetti
   #ifdef ESP32
   Cache.setControllerSettings(ControllerIndex, controller_settings);
   #endif
+  #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+  Cache.setControllerIgnoreSendOnChange(ControllerIndex, controller_settings.ignoreSendOnChange());
+  #endif
   STOP_TIMER(SAVE_CONTROLLER_SETTINGS);
 
   return res;
@@ -1260,6 +1266,9 @@ String LoadControllerSettings(controllerIndex_t ControllerIndex, ControllerSetti
   START_TIMER
   #ifdef ESP32
   if (Cache.getControllerSettings(ControllerIndex, controller_settings)) {
+    #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+    Cache.setControllerIgnoreSendOnChange(ControllerIndex, controller_settings.ignoreSendOnChange());
+    #endif
     STOP_TIMER(LOAD_CONTROLLER_SETTINGS_C);
     return EMPTY_STRING;
   }
@@ -1274,6 +1283,9 @@ String LoadControllerSettings(controllerIndex_t ControllerIndex, ControllerSetti
   #ifdef ESP32
   Cache.setControllerSettings(ControllerIndex, controller_settings);
   #endif
+  #if FEATURE_TASKVALUE_SEND_ON_CHANGE
+  Cache.setControllerIgnoreSendOnChange(ControllerIndex, controller_settings.ignoreSendOnChange());
+  #endif
   STOP_TIMER(LOAD_CONTROLLER_SETTINGS);
   return result;
 }
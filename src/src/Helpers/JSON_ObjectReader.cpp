@@ -0,0 +1,338 @@
+#include "../Helpers/JSON_ObjectReader.h"
+
+bool JSON_ObjectReader::begin(const String& json)
+{
+  _json   = &json;
+  _data   = json.c_str();
+  _length = json.length();
+
+  const int pos = skipWhitespace(0);
+
+  if ((pos >= _length) || (_data[pos] != '{')) {
+    end();
+    return false;
+  }
+  _firstPos = pos + 1;
+  _pos      = _firstPos;
+  return true;
+}
+
+void JSON_ObjectReader::end()
+{
+  _json     = nullptr;
+  _data     = nullptr;
+  _length   = 0;
+  _firstPos = 0;
+  _pos      = 0;
+}
+
+void JSON_ObjectReader::rewind()
+{
+  _pos = _firstPos;
+}
+
+bool JSON_ObjectReader::atEnd() const
+{
+  Member member;
+
+  return !isValid() || (readMember(_pos, member) < 0);
+}
+
+bool JSON_ObjectReader::next(String& key, String& value)
+{
+  if (!isValid()) {
+    return false;
+  }
+  Member member;
+  const int pos = readMember(_pos, member);
+
+  if (pos < 0) {
+    return false;
+  }
+  key   = unescapeString(member.keyStart, member.keyEnd);
+  value = toValueString(member.valueStart, member.valueEnd);
+  _pos  = pos;
+  return true;
+}
+
+void JSON_ObjectReader::extract(const String keys[], String values[], uint8_t count) const
+{
+  if (count > 32) { count = 32; }
+  uint32_t pending = 0;
+
+  for (uint8_t i = 0; i < count; ++i) {
+    if (keys[i].isEmpty()) {
+      values[i].clear();
+    } else {
+      values[i] = F("null");
+      bitSet(pending, i);
+    }
+  }
+
+  if (!isValid()) {
+    return;
+  }
+  Member member;
+  int    pos = _firstPos;
+
+  while ((pending != 0) && ((pos = readMember(pos, member)) >= 0)) {
+    for (uint8_t i = 0; i < count; ++i) {
+      if (!bitRead(pending, i)) {
+        continue;
+      }
+      const char *key       = keys[i].c_str();
+      const char *separator = strchr(key, '.');
+      const int   keyLength = (separator == nullptr) ? keys[i].length() : separator - key;
+
+      if (!keyEquals(member, key, keyLength)) {
+        continue;
+      }
+      bitClear(pending, i);
+
+      if (separator == nullptr) {
+        values[i] = toValueString(member.valueStart, member.valueEnd);
+      } else if (_data[member.valueStart] == '{') {
+        // "object.member", look up the member in the nested object
+        const char *subKey          = separator + 1;
+        const char *subSeparator    = strchr(subKey, '.');
+        const int   subKeyLength    = (subSeparator == nullptr) ? strlen(subKey) : subSeparator - subKey;
+        Member      subMember;
+        int         subPos = member.valueStart + 1;
+
+        while ((subPos = readMember(subPos, subMember)) >= 0) {
+          if (keyEquals(subMember, subKey, subKeyLength)) {
+            values[i] = toValueString(subMember.valueStart, subMember.valueEnd);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+int JSON_ObjectReader::readMember(int pos, Member& member) const
+{
+  pos = skipWhitespace(pos);
+
+  if ((pos < _length) && (_data[pos] == ',')) {
+    pos = skipWhitespace(pos + 1);
+  }
+
+  if ((pos >= _length) || (_data[pos] != '"')) {
+    // End of the object, or malformed
+    return -1;
+  }
+  const int keyEnd = stringEnd(pos);
+
+  if (keyEnd < 0) {
+    return -1;
+  }
+  member.keyStart = pos + 1;
+  member.keyEnd   = keyEnd - 1;
+
+  pos = skipWhitespace(keyEnd);
+
+  if ((pos >= _length) || (_data[pos] != ':')) {
+    return -1;
+  }
+  pos = skipWhitespace(pos + 1);
+
+  const int end = valueEnd(pos);
+
+  if (end < 0) {
+    return -1;
+  }
+  member.valueStart = pos;
+  member.valueEnd   = end;
+  return end;
+}
+
+int JSON_ObjectReader::skipWhitespace(int pos) const
+{
+  while ((pos < _length) && isspace(static_cast<uint8_t>(_data[pos]))) {
+    ++pos;
+  }
+  return pos;
+}
+
+int JSON_ObjectReader::valueEnd(int pos) const
+{
+  if (pos >= _length) {
+    return -1;
+  }
+  const char c = _data[pos];
+
+  if (c == '"') {
+    return stringEnd(pos);
+  }
+
+  if ((c == '{') || (c == '[')) {
+    int depth = 0;
+
+    for (int i = pos; i < _length; ++i) {
+      switch (_data[i]) {
+        case '"':
+          i = stringEnd(i);
+
+          if (i < 0) {
+            return -1;
+          }
+          --i; // Compensate for ++i of the for loop
+          break;
+        case '{':
+        case '[':
+          ++depth;
+          break;
+        case '}':
+        case ']':
+
+          if (--depth == 0) {
+            return i + 1;
+          }
+          break;
+      }
+    }
+    return -1;
+  }
+
+  // Number, true, false or null
+  int i = pos;
+
+  while ((i < _length) && (strchr(",}] \t\r\n", _data[i]) == nullptr)) {
+    ++i;
+  }
+  return (i > pos) ? i : -1;
+}
+
+int JSON_ObjectReader::stringEnd(int pos) const
+{
+  // pos is the position of the opening quote
+  for (int i = pos + 1; i < _length; ++i) {
+    if (_data[i] == '\\') {
+      ++i; // Skip escaped character
+    } else if (_data[i] == '"') {
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+bool JSON_ObjectReader::keyEquals(const Member& member, const char *key, int keyLength) const
+{
+  return ((member.keyEnd - member.keyStart) == keyLength) &&
+         (strncmp(_data + member.keyStart, key, keyLength) == 0);
+}
+
+String JSON_ObjectReader::toValueString(int start, int end) const
+{
+  if (_data[start] == '"') {
+    return unescapeString(start + 1, end - 1);
+  }
+
+  if ((_data[start] == '{') || (_data[start] == '[')) {
+    return minify(start, end);
+  }
+  return _json->substring(start, end);
+}
+
+String JSON_ObjectReader::minify(int start, int end) const
+{
+  bool hasWhitespace = false;
+
+  for (int i = start; i < end && !hasWhitespace; ++i) {
+    if (_data[i] == '"') {
+      i = stringEnd(i) - 1; // Strings are kept as-is
+    } else {
+      hasWhitespace = isspace(static_cast<uint8_t>(_data[i]));
+    }
+  }
+
+  if (!hasWhitespace) {
+    return _json->substring(start, end);
+  }
+  String result;
+
+  result.reserve(end - start);
+
+  for (int i = start; i < end; ++i) {
+    if (_data[i] == '"') {
+      const int strEnd = stringEnd(i);
+
+      for (; i < strEnd; ++i) {
+        result += _data[i];
+      }
+      --i; // Compensate for ++i of the for loop
+    } else if (!isspace(static_cast<uint8_t>(_data[i]))) {
+      result += _data[i];
+    }
+  }
+  return result;
+}
+
+String JSON_ObjectReader::unescapeString(int start, int end) const
+{
+  if (memchr(_data + start, '\\', end - start) == nullptr) {
+    // Nothing to unescape
+    return _json->substring(start, end);
+  }
+  String result;
+
+  result.reserve(end - start);
+
+  for (int i = start; i < end; ++i) {
+    char c = _data[i];
+
+    if ((c == '\\') && ((i + 1) < end)) {
+      c = _data[++i];
+
+      switch (c) {
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u':
+        {
+          if ((i + 4) >= end) {
+            return result;
+          }
+          uint32_t codepoint = strtoul(_json->substring(i + 1, i + 5).c_str(), nullptr, 16);
+          i += 4;
+
+          if ((codepoint >= 0xD800) && (codepoint < 0xDC00) &&
+              ((i + 6) < end) && (_data[i + 1] == '\\') && (_data[i + 2] == 'u')) {
+            // Surrogate pair
+            const uint32_t low = strtoul(_json->substring(i + 3, i + 7).c_str(), nullptr, 16);
+
+            if ((low >= 0xDC00) && (low < 0xE000)) {
+              codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+              i        += 6;
+            }
+          }
+
+          // Encode as UTF-8
+          if (codepoint < 0x80) {
+            result += static_cast<char>(codepoint);
+          } else if (codepoint < 0x800) {
+            result += static_cast<char>(0xC0 | (codepoint >> 6));
+            result += static_cast<char>(0x80 | (codepoint & 0x3F));
+          } else if (codepoint < 0x10000) {
+            result += static_cast<char>(0xE0 | (codepoint >> 12));
+            result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (codepoint & 0x3F));
+          } else {
+            result += static_cast<char>(0xF0 | (codepoint >> 18));
+            result += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (codepoint & 0x3F));
+          }
+          continue;
+        }
+        default: // '"', '\\' and '/'
+          break;
+      }
+    }
+    result += c;
+  }
+  return result;
+}
@@ -0,0 +1,90 @@
+#ifndef HELPERS_JSON_OBJECTREADER_H
+#define HELPERS_JSON_OBJECTREADER_H
+
+#include "../../ESPEasy_common.h"
+
+// Pull reader for the members of a JSON object.
+// Works directly on the text of the message, without building a document in memory.
+// Only the keys and values actually requested are copied into a String.
+// String values are unescaped, nested objects and arrays are returned without white space,
+// like ArduinoJson serializes them.
+// Numbers and true/false/null are returned as they appear in the message,
+// so a number is not reformatted like ArduinoJson does (e.g. 26.000 is not returned as 26).
+// The String holding the message must not be changed or destructed while reading.
+class JSON_ObjectReader {
+public:
+
+  JSON_ObjectReader() = default;
+
+  // Return false when the message is not a JSON object.
+  bool begin(const String& json);
+
+  void end();
+
+  bool isValid() const {
+    return _json != nullptr;
+  }
+
+  // Start reading the members again from the first one.
+  void rewind();
+
+  // Return true when there are no more members to read.
+  bool atEnd() const;
+
+  // Read the next member of the object.
+  // Return false at the end of the object or when the message is malformed.
+  bool next(String& key,
+            String& value);
+
+  // Look up the values of a number of keys in a single pass over the message.
+  // A key may address a member of a nested object as "object.member"
+  // Keys not present will get the value "null", like ArduinoJson does.
+  // Max. 32 keys.
+  void extract(const String keys[],
+               String       values[],
+               uint8_t      count) const;
+
+private:
+
+  struct Member {
+    int keyStart;
+    int keyEnd;
+    int valueStart;
+    int valueEnd;
+  };
+
+  // Read the member at pos, or after the ',' at pos.
+  // Also used for nested objects, with pos just after their opening '{'
+  // Return the position after the member, or -1 when at the end of the object or on error.
+  int    readMember(int     pos,
+                    Member& member) const;
+
+  int    skipWhitespace(int pos) const;
+
+  // Return the position after the value starting at pos, or -1 on error.
+  int    valueEnd(int pos) const;
+
+  int    stringEnd(int pos) const;
+
+  bool   keyEquals(const Member& member,
+                   const char   *key,
+                   int           keyLength) const;
+
+  String toValueString(int start,
+                       int end) const;
+
+  String unescapeString(int start,
+                        int end) const;
+
+  // Return the nested object or array in [start, end) without white space outside strings.
+  String minify(int start,
+                int end) const;
+
+  const String *_json     = nullptr;
+  const char   *_data     = nullptr;
+  int           _length   = 0;
+  int           _firstPos = 0; // Position after the opening '{'
+  int           _pos      = 0;
+};
+
+#endif // ifndef HELPERS_JSON_OBJECTREADER_H
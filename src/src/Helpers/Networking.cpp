@@ -92,6 +92,7 @@ void etharp_gratuitous_r(struct netif *netif) {
 # endif // ifdef ESP32
 #endif  // if FEATURE_DOWNLOAD
 
+#include <map>
 #include <vector>
 
 /*********************************************************************************************\
@@ -1098,6 +1099,17 @@ bool setDNS(int index, const IPAddress& dns) {
   return false;
 }
 
+struct DNS_cache_entry {
+  IPAddress     ip;
+  unsigned long lastResolved = 0;
+};
+
+static std::map<String, DNS_cache_entry> DNS_cache;
+
+void clearDNScache() {
+  DNS_cache.clear();
+}
+
 bool resolveHostByName(const char *aHostname, IPAddress& aResult, uint32_t timeout_ms) {
   START_TIMER;
 
@@ -1105,6 +1117,24 @@ bool resolveHostByName(const char *aHostname, IPAddress& aResult, uint32_t timeo
     return false;
   }
 
+  if (aResult.fromString(aHostname)) {
+    // Already an IP address, no need to look it up.
+    return true;
+  }
+  const String hostname(aHostname);
+
+  {
+    auto it = DNS_cache.find(hostname);
+
+    if (it != DNS_cache.end()) {
+      if (timePassedSince(it->second.lastResolved) < DNS_CACHE_TTL) {
+        aResult = it->second.ip;
+        return true;
+      }
+      DNS_cache.erase(it);
+    }
+  }
+
   FeedSW_watchdog();
 
   // FIXME TD-er: Must try to restore DNS server entries.
@@ -1120,6 +1150,21 @@ bool resolveHostByName(const char *aHostname, IPAddress& aResult, uint32_t timeo
 
   if (!resolvedIP) {
     Scheduler.sendGratuitousARP_now();
+  } else {
+    if (DNS_cache.size() >= DNS_CACHE_MAX_ENTRIES) {
+      // Make room by removing the entry resolved longest ago.
+      auto oldest = DNS_cache.begin();
+
+      for (auto it = DNS_cache.begin(); it != DNS_cache.end(); ++it) {
+        if (timePassedSince(it->second.lastResolved) > timePassedSince(oldest->second.lastResolved)) {
+          oldest = it;
+        }
+      }
+      DNS_cache.erase(oldest);
+    }
+    DNS_cache_entry& entry = DNS_cache[hostname];
+    entry.ip           = aResult;
+    entry.lastResolved = millis();
   }
   STOP_TIMER(HOST_BY_NAME_STATS);
   return resolvedIP;
@@ -1453,6 +1498,9 @@ int http_authenticate(const String& logIdentifier,
   if (Settings.SendToHTTP_follow_redirects()) {
     http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
     http.setRedirectLimit(2);
+  } else {
+    // The HTTPClient may be reused from a previous call
+    http.setFollowRedirects(HTTPC_DISABLE_FOLLOW_REDIRECTS);
   }
 
   #ifdef MUSTFIX_CLIENT_TIMEOUT_IN_SECONDS
@@ -1581,7 +1629,44 @@ String send_via_http(const String& logIdentifier,
                      bool          must_check_reply) {
   WiFiClient client;
   HTTPClient http;
-  http.setReuse(false);
+
+  return send_via_http(
+    logIdentifier,
+    client,
+    http,
+    timeout,
+    user,
+    pass,
+    host,
+    port,
+    uri,
+    HttpMethod,
+    header,
+    postStr,
+    httpCode,
+    must_check_reply,
+    false);
+}
+
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply,
+                     bool          keep_alive) {
+  // Without reading the reply, the response may still be arriving when sending the next request.
+  // So the connection can only be reused when the reply is checked.
+  keep_alive = keep_alive && must_check_reply;
+  http.setReuse(keep_alive);
 
   httpCode = http_authenticate(
     logIdentifier,
@@ -1609,10 +1694,13 @@ String send_via_http(const String& logIdentifier,
 #endif
   }
   http.end();
-  // http.end() does not call client.stop() if it is no longer connected.
-  // However the client may still keep its internal state which may prevent 
-  // future connections to the same host until there has been a connection to another host inbetween.
-  client.stop(); 
+
+  if (!keep_alive || (httpCode <= 0)) {
+    // http.end() does not call client.stop() if it is no longer connected.
+    // However the client may still keep its internal state which may prevent 
+    // future connections to the same host until there has been a connection to another host inbetween.
+    client.stop(); 
+  }
   return response;
 }
 #endif // FEATURE_HTTP_CLIENT
@@ -160,8 +160,24 @@ bool valid_DNS_address(const IPAddress& dns);
 
 bool setDNS(int index, const IPAddress& dns);
 
+// Resolved host names are cached for DNS_CACHE_TTL msec.
+// The DNS API does not provide the TTL of the DNS record, so a fixed TTL is used.
+#ifndef DNS_CACHE_TTL
+# define DNS_CACHE_TTL          300000
+#endif // ifndef DNS_CACHE_TTL
+#ifndef DNS_CACHE_MAX_ENTRIES
+# ifdef ESP8266
+#  define DNS_CACHE_MAX_ENTRIES 4
+# else // ifdef ESP8266
+#  define DNS_CACHE_MAX_ENTRIES 8
+# endif // ifdef ESP8266
+#endif // ifndef DNS_CACHE_MAX_ENTRIES
+
 bool resolveHostByName(const char *aHostname, IPAddress& aResult, uint32_t timeout_ms = 1000);
 
+// Must be called when the network connection is lost, as the DNS server may be different after reconnect.
+void clearDNScache();
+
 bool hostReachable(const String& hostname);
 
 // Create a random port for the UDP connection.
@@ -219,6 +235,25 @@ String send_via_http(const String& logIdentifier,
                      const String& postStr,
                      int         & httpCode,
                      bool          must_check_reply);
+
+// Send using the given client objects, which may be kept by the caller to reuse the connection.
+// When keep_alive is set, HTTP/1.1 keep-alive is requested and the connection is left open
+// if the server allows it.
+String send_via_http(const String& logIdentifier,
+                     WiFiClient  & client,
+                     HTTPClient  & http,
+                     uint16_t      timeout,
+                     const String& user,
+                     const String& pass,
+                     const String& host,
+                     uint16_t      port,
+                     const String& uri,
+                     const String& HttpMethod,
+                     const String& header,
+                     const String& postStr,
+                     int         & httpCode,
+                     bool          must_check_reply,
+                     bool          keep_alive);
 #endif // FEATURE_HTTP_CLIENT
 
 #if FEATURE_DOWNLOAD
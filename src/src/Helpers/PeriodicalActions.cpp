@@ -30,6 +30,7 @@
 #include "../Globals/Settings.h"
 #include "../Globals/Statistics.h"
 #include "../Globals/WiFi_AP_Candidates.h"
+#include "../Helpers/_CPlugin_Helper.h"
 #include "../Helpers/ESPEasyRTC.h"
 #include "../Helpers/FS_Helper.h"
 #include "../Helpers/Hardware.h"
@@ -167,6 +168,10 @@ void runOncePerSecond()
 //  unsigned long start = micros();
   String dummy;
   PluginCall(PLUGIN_ONCE_A_SECOND, 0, dummy);
+
+  #if FEATURE_HTTP_CLIENT
+  closeIdleControllerHTTPConnections();
+  #endif // if FEATURE_HTTP_CLIENT
 //  unsigned long elapsed = micros() - start;
 
 
@@ -300,44 +305,60 @@ void processMQTTdelayQueue() {
   }
 
   START_TIMER;
-  MQTT_queue_element *element(static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext()));
-
-  if (element == nullptr) { return; }
 
-  bool handled = false;
+  // With "Batch Publish" enabled, keep publishing queued messages
+  // as long as the broker accepts them, up to a maximum number of messages and bytes.
+  uint8_t nrProcessed = 0;
+  size_t  nrBytesSent = 0;
+  bool    mustContinue = true;
 
-  if (element->_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
-    struct EventStruct TempEvent(element->_taskIndex);
-    String dummy;
+  while (mustContinue) {
+    MQTT_queue_element *element(static_cast<MQTT_queue_element *>(MQTTDelayHandler->getNext()));
 
-    // FIXME TD-er: Do we need anything from the element in the event?
-//    TempEvent.String1 = element->_topic;
-//    TempEvent.String2 = element->_payload;
-    if (PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy)) {
-      handled = true;
-      MQTTDelayHandler->markProcessed(true);
-    } else {
-      MQTTDelayHandler->markProcessed(false);
+    if (element == nullptr) {
+      if (nrProcessed == 0) { return; }
+      break;
     }
-  } else
-  if (!handled) {
-    if (MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
-      if (WiFiEventData.connectionFailures > 0) {
-        --WiFiEventData.connectionFailures;
-      }
-      MQTTDelayHandler->markProcessed(true);
+
+    bool processed = false;
+
+    if (element->_call_PLUGIN_PROCESS_CONTROLLER_DATA) {
+      struct EventStruct TempEvent(element->_taskIndex);
+      String dummy;
+
+      // FIXME TD-er: Do we need anything from the element in the event?
+//      TempEvent.String1 = element->_topic;
+//      TempEvent.String2 = element->_payload;
+      processed = PluginCall(PLUGIN_PROCESS_CONTROLLER_DATA, &TempEvent, dummy);
     } else {
-      MQTTDelayHandler->markProcessed(false);
+      // Element is deleted when marked as processed, so compute its size first.
+      nrBytesSent += element->_topic.length() + element->_payload.length();
+
+      processed = MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained);
+
+      if (processed) {
+        if (WiFiEventData.connectionFailures > 0) {
+          --WiFiEventData.connectionFailures;
+        }
+      } else {
 #ifndef BUILD_NO_DEBUG
 
-      if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-        String log = F("MQTT : process MQTT queue not published, ");
-        log += MQTTDelayHandler->sendQueue.size();
-        log += F(" items left in queue");
-        addLogMove(LOG_LEVEL_DEBUG, log);
-      }
+        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+          String log = F("MQTT : process MQTT queue not published, ");
+          log += MQTTDelayHandler->sendQueue.size();
+          log += F(" items left in queue");
+          addLogMove(LOG_LEVEL_DEBUG, log);
+        }
 #endif // ifndef BUILD_NO_DEBUG
+      }
     }
+    MQTTDelayHandler->markProcessed(processed);
+    ++nrProcessed;
+
+    mustContinue = processed &&
+                   nrProcessed < MQTTDelayHandler->max_batch_size &&
+                   nrBytesSent < CONTROLLER_DELAY_QUEUE_BATCH_BYTES &&
+                   MQTTclient.connected();
   }
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon as possible.
   scheduleNextMQTTdelayQueue();
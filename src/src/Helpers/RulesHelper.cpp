@@ -129,7 +129,7 @@ bool RulesHelperClass::findMatchingRule(const String& event, String& filename, s
   if (!_eventCache.isInitialized()) {
     init();
   }
-  RulesEventCache_vector::const_iterator it = _eventCache.findMatchingRule(event, Settings.EnableRulesEventReorder());
+  RulesEventCache_vector::const_iterator it = _eventCache.findMatchingRule(event);
 
   if (it == _eventCache.end()) { return false; }
 
@@ -150,10 +150,25 @@ void RulesHelperClass::init()
     size_t pos                   = 0;
     bool   moreAvailable         = true;
     const bool searchNextOnBlock = false;
+#if FEATURE_RULES_COMPILER
+
+    // Compile the rules file while reading it for the event cache.
+    std::shared_ptr<RulesCompiledImage> image;
+
+    if (_compiledImages.find(filename) == _compiledImages.end()) {
+      image.reset(new (std::nothrow) RulesCompiledImage());
+    }
+#endif // if FEATURE_RULES_COMPILER
 
     while (moreAvailable) {
       const size_t pos_start_line = pos;
       const String rulesLine      = readLn(filename, pos, moreAvailable, searchNextOnBlock);
+#if FEATURE_RULES_COMPILER
+
+      if (image) {
+        image->addLine(rulesLine, pos_start_line, pos - pos_start_line + 1);
+      }
+#endif // if FEATURE_RULES_COMPILER
 
       if (_eventCache.addLine(
             rulesLine,
@@ -173,10 +188,128 @@ void RulesHelperClass::init()
 #endif // ifndef BUILD_NO_DEBUG
       }
     }
+#if FEATURE_RULES_COMPILER
+
+    if (image) {
+      storeCompiledImage(filename, image);
+    }
+#endif // if FEATURE_RULES_COMPILER
   }
   _eventCache.initialize();
 }
 
+#if FEATURE_RULES_COMPILER
+std::shared_ptr<const RulesCompiledImage> RulesHelperClass::getCompiledImage(const String& filename)
+{
+  auto it = _compiledImages.find(filename);
+
+  if (it != _compiledImages.end()) {
+    return it->second;
+  }
+
+  // Only the rules set files are compiled, so the number of images is bounded.
+  // Other files (e.g. one file per event) are processed as text.
+  bool isRulesSetFile = false;
+
+  for (uint8_t x = 0; x < RULESETS_MAX && !isRulesSetFile; x++) {
+    isRulesSetFile = filename.equalsIgnoreCase(getRulesFileName(x));
+  }
+
+  if (!isRulesSetFile) {
+    return nullptr;
+  }
+
+  std::shared_ptr<RulesCompiledImage> image(new (std::nothrow) RulesCompiledImage());
+
+  if (!image) {
+    return nullptr;
+  }
+
+  size_t pos                   = 0;
+  bool   moreAvailable         = true;
+  const bool searchNextOnBlock = false;
+
+  while (moreAvailable) {
+    const size_t pos_start_line = pos;
+    const String rulesLine      = readLn(filename, pos, moreAvailable, searchNextOnBlock);
+    image->addLine(rulesLine, pos_start_line, pos - pos_start_line + 1);
+  }
+  return storeCompiledImage(filename, image);
+}
+
+String RulesHelperClass::readCompiledLn(const String& filename, const RulesCompiled_element& element)
+{
+  size_t pos = element._posInFile;
+
+# ifndef CACHE_RULES_IN_MEMORY
+  String line;
+
+  if (_blockCache.get(filename, pos, line)) {
+    return line;
+  }
+
+  if (element._length != 0) {
+    return readLn(filename, pos, element._length);
+  }
+# endif // ifndef CACHE_RULES_IN_MEMORY
+  bool moreAvailable = false;
+
+  return readLn(filename, pos, moreAvailable, false);
+}
+
+void RulesHelperClass::cacheCompiledBlock(const String& filename, const RulesCompiledImage& image, size_t index)
+{
+# ifndef CACHE_RULES_IN_MEMORY
+
+  if ((RULES_BLOCK_CACHE_MAX_SIZE == 0) ||
+      (index >= image.size()) ||
+      _blockCache.isCached(filename, image[index]._posInFile)) {
+    return;
+  }
+  RulesBlockCache_element block;
+
+  block._filename = filename;
+
+  // The "on" element jumps to its "endon", or to itself for a one-liner.
+  for (size_t i = index; i <= image[index]._jump && i < image.size(); ++i) {
+    block.addLine(image[i]._posInFile, readCompiledLn(filename, image[i]));
+
+    if (block._size > RULES_BLOCK_CACHE_MAX_SIZE) {
+      return;
+    }
+  }
+  _blockCache.add(std::move(block));
+# endif // ifndef CACHE_RULES_IN_MEMORY
+}
+
+std::shared_ptr<const RulesCompiledImage> RulesHelperClass::storeCompiledImage(
+  const String                       & filename,
+  std::shared_ptr<RulesCompiledImage>& image)
+{
+  image->finalize();
+
+  if (!image->isValid()) {
+    // Store an empty pointer, so we will not try to compile this file again
+    // and fall back to processing the text.
+    image.reset();
+  }
+# ifndef BUILD_NO_DEBUG
+  else if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    String log = F("Rules : Compiled ");
+    log += image->size();
+    log += F(" lines from ");
+    log += filename;
+    addLogMove(LOG_LEVEL_DEBUG, log);
+  }
+# endif // ifndef BUILD_NO_DEBUG
+  std::shared_ptr<const RulesCompiledImage> res(image);
+
+  _compiledImages[filename] = res;
+  return res;
+}
+
+#endif // if FEATURE_RULES_COMPILER
+
 void RulesHelperClass::closeAllFiles() {
   for (auto it = _fileHandleMap.begin(); it != _fileHandleMap.end();) {
     #ifdef CACHE_RULES_IN_MEMORY
@@ -187,6 +320,12 @@ void RulesHelperClass::closeAllFiles() {
     #endif // ifdef CACHE_RULES_IN_MEMORY
   }
   _eventCache.clear();
+#if FEATURE_RULES_COMPILER
+  _compiledImages.clear();
+# ifndef CACHE_RULES_IN_MEMORY
+  _blockCache.clear();
+# endif // ifndef CACHE_RULES_IN_MEMORY
+#endif // if FEATURE_RULES_COMPILER
 }
 
 #ifndef CACHE_RULES_IN_MEMORY
@@ -226,6 +365,30 @@ size_t RulesHelperClass::read(const String& filename, size_t& pos, uint8_t *buff
   return ret;
 }
 
+String RulesHelperClass::readLn(const String& filename, size_t pos, size_t length)
+{
+  std::vector<uint8_t> buf;
+
+  buf.resize(length);
+
+  const size_t len       = read(filename, pos, &buf[0], length);
+  bool firstNonSpaceRead = false;
+  String line;
+
+  line.reserve(length);
+
+  for (size_t x = 0; x < len; x++) {
+    if (addChar(char(buf[x]), line, firstNonSpaceRead)) {
+      return line;
+    }
+  }
+
+  // Last line of the file
+  rules_strip_trailing_comments(line);
+  check_rules_line_user_errors(line);
+  return line;
+}
+
 #endif // ifndef CACHE_RULES_IN_MEMORY
 
 bool RulesHelperClass::addChar(char c, String& line,   bool& firstNonSpaceRead)
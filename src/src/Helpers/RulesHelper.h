@@ -3,10 +3,13 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/RulesBlockCache.h"
+#include "../DataStructs/RulesCompiledImage.h"
 #include "../DataStructs/RulesEventCache.h"
 
 #include <FS.h>
 #include <map>
+#include <memory>
 
 #ifdef ESP32
 # define CACHE_RULES_IN_MEMORY
@@ -40,6 +43,26 @@ public:
                         String      & filename,
                         size_t      & pos);
 
+#if FEATURE_RULES_COMPILER
+
+  // Get the pre-parsed image of a rules file.
+  // The image is compiled on first use and kept until closeAllFiles() is called.
+  // Only the rules set files (rules1.txt ... rules4.txt) are compiled.
+  // Returns an empty pointer when no valid image could be made.
+  std::shared_ptr<const RulesCompiledImage> getCompiledImage(const String& filename);
+
+  // Read the line of an element of a compiled image.
+  String readCompiledLn(const String               & filename,
+                        const RulesCompiled_element& element);
+
+  // Keep the lines of the "on ... do" block starting at index of the image in memory,
+  // so processing the next matching event does not need to access the file.
+  // Only used when the rules files are not cached in memory.
+  void cacheCompiledBlock(const String            & filename,
+                          const RulesCompiledImage& image,
+                          size_t                    index);
+#endif // if FEATURE_RULES_COMPILER
+
 private:
 
 #ifndef CACHE_RULES_IN_MEMORY
@@ -48,6 +71,11 @@ private:
               uint8_t      *buffer,
               size_t        length);
 
+  // Read a single line of known length, starting at pos.
+  String readLn(const String& filename,
+                size_t        pos,
+                size_t        length);
+
 #endif // ifndef CACHE_RULES_IN_MEMORY
 
   bool addChar(char    c,
@@ -77,6 +105,19 @@ private:
   RulesEventCache _eventCache;
 
   FileHandleMap _fileHandleMap;
+
+#if FEATURE_RULES_COMPILER
+  typedef std::map<String, std::shared_ptr<const RulesCompiledImage> >CompiledImageMap;
+
+  std::shared_ptr<const RulesCompiledImage> storeCompiledImage(const String                       & filename,
+                                                               std::shared_ptr<RulesCompiledImage>& image);
+
+  CompiledImageMap _compiledImages;
+
+# ifndef CACHE_RULES_IN_MEMORY
+  RulesBlockCache _blockCache;
+# endif // ifndef CACHE_RULES_IN_MEMORY
+#endif // if FEATURE_RULES_COMPILER
 };
 
 #endif // ifndef HELPERS_RULESHELPER_H
@@ -1,5 +1,7 @@
 #include "../Helpers/RulesMatcher.h"
 
+#include "../Globals/Plugins_other.h"
+
 #include "../Helpers/ESPEasy_math.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/Numerical.h"
@@ -7,7 +9,82 @@
 #include "../Helpers/StringParser.h"
 
 
-bool ruleMatch(String event, String rule) {
+// Case insensitive compare of the first 'length' characters, like String::equalsIgnoreCase()
+static bool equalsIgnoreCase(const char *str1, const char *str2, size_t length)
+{
+  for (size_t i = 0; i < length; ++i) {
+    if (tolower(str1[i]) != tolower(str2[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check if the string has leading or trailing characters which will be removed by String::trim()
+static bool mustTrim(const String& str)
+{
+  const size_t length = str.length();
+
+  return length > 0 &&
+         (isspace(static_cast<uint8_t>(str[0])) ||
+          isspace(static_cast<uint8_t>(str[length - 1])));
+}
+
+RulesMatcher_event::RulesMatcher_event(const String& event) : _event(&event)
+{
+  if (mustTrim(event)) {
+    _trimmedEvent = event;
+    _trimmedEvent.trim();
+    _mustTrim = true;
+  }
+  const String& trimmed = get();
+
+  isLiteral = trimmed.charAt(0) == '!';
+
+  // parse event into verb and value
+  const int equal_pos = trimmed.indexOf('=');
+
+  if (equal_pos >= 0) {
+    hasValue   = true;
+    nameLength = equal_pos;
+    validValue = validDoubleFromString(trimmed.substring(equal_pos + 1), value);
+  } else {
+    nameLength = trimmed.length();
+  }
+
+  // clock events need different handling...
+  isClockTime = trimmed.substring(0, 10).equalsIgnoreCase(F("Clock#Time"));
+
+  if (isClockTime && (equal_pos > 0)) {
+    clockEvent = string2TimeLong(trimmed.substring(equal_pos + 1));
+  }
+}
+
+bool ruleNeedsParseTemplate(const String& rule)
+{
+  if (parseTemplate_CallBack_ptr != nullptr) {
+    return true;
+  }
+
+  for (size_t i = 0; i < rule.length(); ++i) {
+    switch (rule[i]) {
+      case '[': // [taskname#valuename]
+      case '%': // System variables and standard conversions
+      case '{': // String commands and special characters like {D}
+      case '&': // HTML entities like &deg;
+        return true;
+    }
+  }
+  return false;
+}
+
+bool ruleMatch(const String& event, const String& rule) {
+  const RulesMatcher_event rulesEvent(event);
+
+  return ruleMatch(rulesEvent, rule);
+}
+
+bool ruleMatch(const RulesMatcher_event& event, const String& rule) {
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("ruleMatch"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -17,30 +94,36 @@ bool ruleMatch(String event, String rule) {
     return true;
   }
 
-  rule.trim();
-  parseStandardConversions(rule, false);
-  rule = parseTemplate(rule);
-
-  event.trim();
+  // Only make a copy of the rule when it needs to be changed.
+  // Most rules are plain event names, which can be matched in place.
+  String parsedRule;
+  const String *rulePtr = &rule;
+
+  if (mustTrim(rule) || ruleNeedsParseTemplate(rule)) {
+    parsedRule = rule;
+    parsedRule.trim();
+    parseStandardConversions(parsedRule, false);
+    parsedRule = parseTemplate(parsedRule);
+    rulePtr    = &parsedRule;
+  }
+  const String& rule_s  = *rulePtr;
+  const String& event_s = event.get();
 
-  if (event.equalsIgnoreCase(rule)) {
+  if (event_s.equalsIgnoreCase(rule_s)) {
     return true;
   }
 
   // clock events need different handling...
-  if (event.substring(0, 10).equalsIgnoreCase(F("Clock#Time")))
+  if (event.isClockTime)
   {
-    int pos1 = event.indexOf('=');
-    int pos2 = rule.indexOf('=');
+    const int pos2 = rule_s.indexOf('=');
 
-    if ((pos1 > 0) && (pos2 > 0)) {
-      if (event.substring(0, pos1).equalsIgnoreCase(rule.substring(0, pos2))) // if this is a clock rule
+    if ((event.nameLength > 0) && event.hasValue && (pos2 > 0)) {
+      if ((event.nameLength == pos2) && equalsIgnoreCase(event_s.c_str(), rule_s.c_str(), pos2)) // if this is a clock rule
       {
-//        addLog(LOG_LEVEL_INFO, concat(F("Clock#Time="), rule.substring(pos2 + 1)));
-        unsigned long clockEvent = string2TimeLong(event.substring(pos1 + 1));
-        unsigned long clockSet   = string2TimeLong(rule.substring(pos2 + 1));
+        const unsigned long clockSet = string2TimeLong(rule_s.substring(pos2 + 1));
 
-        return matchClockEvent(clockEvent, clockSet);
+        return matchClockEvent(event.clockEvent, clockSet);
       }
     } else {
       // Not supported yet, see: https://github.com/letscontrolit/ESPEasy/issues/2640
@@ -50,63 +133,63 @@ bool ruleMatch(String event, String rule) {
 
   // Handling wildcard in event
   {
-    const int asterisk_pos = rule.indexOf('*');
+    const int asterisk_pos = rule_s.indexOf('*');
 
     if (asterisk_pos != -1) // a * sign in rule, so use a 'wildcard' match on message
     {
-      return event.substring(0, asterisk_pos).equalsIgnoreCase(rule.substring(0, asterisk_pos));
+      return static_cast<int>(event_s.length()) >= asterisk_pos &&
+             equalsIgnoreCase(event_s.c_str(), rule_s.c_str(), asterisk_pos);
     }
   }
 
   // Special handling of literal string events, they should start with '!'
-  if (event.charAt(0) == '!') {
-    const bool pound_char_found = rule.indexOf('#') != -1;
+  if (event.isLiteral) {
+    const bool pound_char_found = rule_s.indexOf('#') != -1;
 
     if (!pound_char_found)
     {
       // no # sign in rule, use 'wildcard' match on event 'source'
-      return event.substring(0, rule.length()).equalsIgnoreCase(rule);
+      return event_s.length() >= rule_s.length() &&
+             equalsIgnoreCase(event_s.c_str(), rule_s.c_str(), rule_s.length());
     }
-    return event.equalsIgnoreCase(rule);
-  }
 
+    // Full match was already checked above.
+    return false;
+  }
 
-  // parse event into verb and value
-  ESPEASY_RULES_FLOAT_TYPE value{};
-  int    equal_pos   = event.indexOf('=');
-
-  if (equal_pos >= 0) {
-    if (!validDoubleFromString(event.substring(equal_pos + 1), value)) {
-      return false;
+  if (event.hasValue && !event.validValue) {
+    return false;
 
-      // FIXME TD-er: What to do when trying to match NaN values?
-    }
-    event = event.substring(0, equal_pos);
+    // FIXME TD-er: What to do when trying to match NaN values?
   }
 
   // parse rule
   int  posStart, posEnd;
   char compare;
 
-  if (!findCompareCondition(rule, compare, posStart, posEnd)) {
+  if (!findCompareCondition(rule_s.c_str(), rule_s.length(), compare, posStart, posEnd)) {
     // No compare condition found, so just check if the event- and rule string match.
-    return event.equalsIgnoreCase(rule);
+    return (event.nameLength == static_cast<int>(rule_s.length())) &&
+           equalsIgnoreCase(event_s.c_str(), rule_s.c_str(), event.nameLength);
   }
 
-  const bool stringMatch = event.equalsIgnoreCase(rule.substring(0, posStart));
-  ESPEASY_RULES_FLOAT_TYPE     ruleValue{};
+  const bool stringMatch = (event.nameLength == posStart) &&
+                           equalsIgnoreCase(event_s.c_str(), rule_s.c_str(), posStart);
 
-  if (!validDoubleFromString(rule.substring(posEnd), ruleValue)) {
+  if (!stringMatch) {
+    return false;
+  }
+
+  ESPEASY_RULES_FLOAT_TYPE ruleValue{};
+
+  if (!validDoubleFromString(rule_s.substring(posEnd), ruleValue)) {
     return false;
 
     // FIXME TD-er: What to do when trying to match NaN values?
   }
 
-  bool match = false;
+  const bool match = compareDoubleValues(compare, event.value, ruleValue);
 
-  if (stringMatch) {
-    match = compareDoubleValues(compare, value, ruleValue);
-  }
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("ruleMatch2"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -139,71 +222,58 @@ bool compareDoubleValues(char compare, const ESPEASY_RULES_FLOAT_TYPE& Value1, c
   return false;
 }
 
+// Find the first occurrence of a 1 or 2 character compare operator
+// and check whether it is before the compare condition found so far.
+static bool checkCompareCondition(const char *check,
+                                  int         length,
+                                  char        c1,
+                                  char        c2,
+                                  char        compareValue,
+                                  char      & compare,
+                                  int       & posStart,
+                                  int       & posEnd)
+{
+  const int opLength = (c2 == '\0') ? 1 : 2;
+
+  for (int comparePos = 0; comparePos + opLength <= length; ++comparePos) {
+    if ((check[comparePos] == c1) && ((opLength == 1) || (check[comparePos + 1] == c2))) {
+      // Only the first occurrence is considered and it may not be at the start.
+      if ((comparePos > 0) && (comparePos < posStart)) {
+        posStart = comparePos;
+        posEnd   = posStart + opLength;
+        compare  = compareValue;
+        return true;
+      }
+      return false;
+    }
+  }
+  return false;
+}
+
 // Find the compare condition.
 // @param posStart = first position of the compare condition in the string
 // @param posEnd   = first position rest of the string, right after the compare condition.
 bool findCompareCondition(const String& check, char& compare, int& posStart, int& posEnd)
 {
-  posStart = check.length();
-  posEnd   = posStart;
-  int  comparePos = 0;
-  bool found      = false;
-
-  if (((comparePos = check.indexOf(F("!="))) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 2;
-    compare  = '<' + '>';
-    found    = true;
-  }
-
-  if (((comparePos = check.indexOf(F("<>"))) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 2;
-    compare  = '<' + '>';
-    found    = true;
-  }
-
-  if (((comparePos = check.indexOf(F(">="))) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 2;
-    compare  = '>' + '=';
-    found    = true;
-  }
-
-  if (((comparePos = check.indexOf(F("<="))) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 2;
-    compare  = '<' + '=';
-    found    = true;
-  }
-
-  if (((comparePos = check.indexOf(F("=="))) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 2;
-    compare  = '=';
-    found    = true;
-  }
-
-  if (((comparePos = check.indexOf('<')) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 1;
-    compare  = '<';
-    found    = true;
-  }
-
-  if (((comparePos = check.indexOf('>')) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 1;
-    compare  = '>';
-    found    = true;
-  }
+  return findCompareCondition(check.c_str(), check.length(), compare, posStart, posEnd);
+}
 
-  if (((comparePos = check.indexOf('=')) > 0) && (comparePos < posStart)) {
-    posStart = comparePos;
-    posEnd   = posStart + 1;
-    compare  = '=';
-    found    = true;
-  }
+bool findCompareCondition(const char *check, int length, char& compare, int& posStart, int& posEnd)
+{
+  posStart = length;
+  posEnd   = posStart;
+  bool found = false;
+
+  // 2 character operators must be checked first,
+  // as they take precedence over a 1 character operator at the same position.
+  if (checkCompareCondition(check, length, '!', '=', '<' + '>', compare, posStart, posEnd)) { found = true; }
+  if (checkCompareCondition(check, length, '<', '>', '<' + '>', compare, posStart, posEnd)) { found = true; }
+  if (checkCompareCondition(check, length, '>', '=', '>' + '=', compare, posStart, posEnd)) { found = true; }
+  if (checkCompareCondition(check, length, '<', '=', '<' + '=', compare, posStart, posEnd)) { found = true; }
+  if (checkCompareCondition(check, length, '=', '=', '=',       compare, posStart, posEnd)) { found = true; }
+  if (checkCompareCondition(check, length, '<', '\0', '<',      compare, posStart, posEnd)) { found = true; }
+  if (checkCompareCondition(check, length, '>', '\0', '>',      compare, posStart, posEnd)) { found = true; }
+  if (checkCompareCondition(check, length, '=', '\0', '=',      compare, posStart, posEnd)) { found = true; }
   return found;
 }
 
@@ -3,12 +3,53 @@
 
 #include "../../ESPEasy_common.h"
 
+/********************************************************************************************\
+   Event split into its name and value.
+   Used to match an event against a number of rules,
+   without parsing the event again for every rule.
+   N.B. Refers to the given event string, so this must not be used after the event string is destructed.
+ \*********************************************************************************************/
+struct RulesMatcher_event {
+  explicit RulesMatcher_event(const String& event);
+
+  // The trimmed event
+  const String& get() const {
+    return _mustTrim ? _trimmedEvent : *_event;
+  }
+
+  ESPEASY_RULES_FLOAT_TYPE value{};
+
+  // Position of the '=' or the length of the event when there is no value.
+  int nameLength = 0;
+
+  // Clock#Time=Day,hh:mm as computed by string2TimeLong()
+  unsigned long clockEvent = 0;
+
+  bool hasValue    = false;
+  bool validValue  = false;
+  bool isClockTime = false;
+  bool isLiteral   = false;
+
+private:
+
+  const String *_event;
+  String        _trimmedEvent;
+  bool          _mustTrim = false;
+};
+
 /********************************************************************************************\
    Check if an event matches to a given rule
  \*********************************************************************************************/
-// Both strings are copied, since they may need to be trimmed and call parseTemplate
-bool ruleMatch(String event,
-               String rule);
+
+// The rule is only copied when it needs to be trimmed or contains markers for parseTemplate.
+bool ruleMatch(const RulesMatcher_event& event,
+               const String            & rule);
+
+bool ruleMatch(const String& event,
+               const String& rule);
+
+// Check whether a rule needs to be processed by parseTemplate before it can be matched.
+bool ruleNeedsParseTemplate(const String& rule);
 
 
 bool compareIntValues(char       compare,
@@ -24,6 +65,12 @@ bool findCompareCondition(const String& check,
                           int         & posStart,
                           int         & posEnd);
 
+bool findCompareCondition(const char *check,
+                          int         length,
+                          char      & compare,
+                          int       & posStart,
+                          int       & posEnd);
+
 
 // Split a rules line into 2 parts:
 // - event: The part between on ... do
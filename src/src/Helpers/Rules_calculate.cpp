@@ -23,6 +23,14 @@ bool isError(CalculateReturnCode returnCode) {
 
 bool RulesCalculate_t::is_number(char oc, char c)
 {
+  #if FEATURE_RULES_CALCULATE_CACHE
+
+  if ((_program != nullptr) && (c == CALCULATE_OPERAND_MARKER)) {
+    // Compiling a template, marker replaces a numerical operand.
+    return true;
+  }
+  #endif // if FEATURE_RULES_CALCULATE_CACHE
+
   // Check if it matches part of a number (identifier)
   return
     (c == '.')   ||                                // A decimal point of a floating point number.
@@ -309,6 +317,21 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
   return ret;
 }
 
+CalculateReturnCode RulesCalculate_t::processToken(char *token)
+{
+  #if FEATURE_RULES_CALCULATE_CACHE
+
+  if (_program != nullptr) {
+    if (token[0] != 0) {
+      *_program += token;
+      *_program += ' ';
+    }
+    return CalculateReturnCode::OK;
+  }
+  #endif // if FEATURE_RULES_CALCULATE_CACHE
+  return RPNCalculate(token);
+}
+
 // operators
 // precedence   operators         associativity
 // 4            !                 right to left
@@ -402,7 +425,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
       else if (is_operator(c) || is_unary_operator(c))
       {
         *(TokenPos) = 0; // Mark end of token string
-        error       = RPNCalculate(token);
+        error       = processToken(token);
         TokenPos    = token;
 
         if (isError(error)) { return error; }
@@ -427,7 +450,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
             *TokenPos = sc;
             ++TokenPos;
             *(TokenPos) = 0; // Mark end of token string
-            error       = RPNCalculate(token);
+            error       = processToken(token);
             TokenPos    = token;
 
             if (isError(error)) { return error; }
@@ -461,7 +484,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
         while (sl > 0)
         {
           *(TokenPos) = 0; // Mark end of token string
-          error       = RPNCalculate(token);
+          error       = processToken(token);
           TokenPos    = token;
 
           if (isError(error)) { return error; }
@@ -514,7 +537,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
     }
 
     *(TokenPos) = 0; // Mark end of token string
-    error       = RPNCalculate(token);
+    error       = processToken(token);
     TokenPos    = token;
 
     if (isError(error)) { return error; }
@@ -524,7 +547,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   }
 
   *(TokenPos) = 0; // Mark end of token string
-  error       = RPNCalculate(token);
+  error       = processToken(token);
   TokenPos    = token;
 
   if (isError(error))
@@ -532,6 +555,13 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
     *result = 0;
     return error;
   }
+  #if FEATURE_RULES_CALCULATE_CACHE
+
+  if (_program != nullptr) {
+    // Only compiled, nothing evaluated.
+    return CalculateReturnCode::OK;
+  }
+  #endif // if FEATURE_RULES_CALCULATE_CACHE
   *result = *sp;
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("Calculate2"));
@@ -539,6 +569,182 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   return CalculateReturnCode::OK;
 }
 
+CalculateReturnCode RulesCalculate_t::doCalculateCached(const String& input, ESPEASY_RULES_FLOAT_TYPE *result)
+{
+  #if FEATURE_RULES_CALCULATE_CACHE
+  String expressionTemplate;
+  RulesCalculate_operand operands[CALCULATE_MAX_OPERANDS];
+  uint8_t nrOperands = 0;
+
+  if (makeTemplate(input, expressionTemplate, operands, nrOperands)) {
+    const RulesCalculate_cacheElement& compiled = getCompiled(expressionTemplate, nrOperands);
+
+    if (compiled._valid && executeProgram(compiled._program, input, operands, result)) {
+      return CalculateReturnCode::OK;
+    }
+  }
+  #endif // if FEATURE_RULES_CALCULATE_CACHE
+  return doCalculate(preProces(input).c_str(), result);
+}
+
+#if FEATURE_RULES_CALCULATE_CACHE
+
+// Word characters, which may be part of a function name or (hex) number.
+static bool isWordChar(char c)
+{
+  return isalnum(static_cast<unsigned char>(c)) || (c == '_');
+}
+
+bool RulesCalculate_t::makeTemplate(const String         & input,
+                                    String               & expressionTemplate,
+                                    RulesCalculate_operand operands[],
+                                    uint8_t              & nrOperands)
+{
+  const size_t length = input.length();
+
+  nrOperands = 0;
+
+  if ((length == 0) || (length > 0xFFFF) || (input.indexOf(CALCULATE_OPERAND_MARKER) != -1)) {
+    return false;
+  }
+
+  if (!expressionTemplate.reserve(length)) {
+    return false;
+  }
+
+  size_t pos = 0;
+
+  while (pos < length) {
+    const char c = input[pos];
+
+    if (isdigit(static_cast<unsigned char>(c)) || (c == '.')) {
+      size_t end = pos + 1;
+
+      while ((end < length) && (isdigit(static_cast<unsigned char>(input[end])) || (input[end] == '.'))) {
+        ++end;
+      }
+
+      // Only plain decimal numbers are replaced.
+      // Something like "0x1F" or "1e3" is kept in the template as-is.
+      if (((end == length) || !isWordChar(input[end])) && (nrOperands < CALCULATE_MAX_OPERANDS)) {
+        operands[nrOperands]._start  = pos;
+        operands[nrOperands]._length = end - pos;
+        ++nrOperands;
+        expressionTemplate += CALCULATE_OPERAND_MARKER;
+      } else {
+        expressionTemplate += input.substring(pos, end);
+      }
+      pos = end;
+    } else {
+      expressionTemplate += c;
+      ++pos;
+    }
+  }
+  return true;
+}
+
+const RulesCalculate_cacheElement& RulesCalculate_t::getCompiled(const String& expressionTemplate, uint8_t nrOperands)
+{
+  ++_cacheCounter;
+
+  size_t leastRecentlyUsed = 0;
+
+  for (size_t i = 0; i < _cache.size(); ++i) {
+    if (_cache[i]._template.equals(expressionTemplate)) {
+      _cache[i]._lastUsed = _cacheCounter;
+      return _cache[i];
+    }
+
+    if (_cache[i]._lastUsed < _cache[leastRecentlyUsed]._lastUsed) {
+      leastRecentlyUsed = i;
+    }
+  }
+
+  if (_cache.size() < CALCULATE_CACHE_SIZE) {
+    _cache.emplace_back();
+    leastRecentlyUsed = _cache.size() - 1;
+  }
+  RulesCalculate_cacheElement& element = _cache[leastRecentlyUsed];
+
+  element._template = expressionTemplate;
+  element._program  = String();
+  element._lastUsed = _cacheCounter;
+
+  // Run the infix to RPN conversion on the template,
+  // collecting the tokens instead of evaluating them.
+  ESPEASY_RULES_FLOAT_TYPE dummy{};
+
+  _program        = &element._program;
+  element._valid  = !isError(doCalculate(preProces(expressionTemplate).c_str(), &dummy));
+  _program        = nullptr;
+
+  if (element._valid) {
+    // Operands must be present in the program in the same order as in the template.
+    uint8_t count = 0;
+
+    for (size_t i = 0; i < element._program.length(); ++i) {
+      if (element._program[i] == CALCULATE_OPERAND_MARKER) {
+        ++count;
+      }
+    }
+    element._valid = (count == nrOperands);
+  }
+  return element;
+}
+
+bool RulesCalculate_t::executeProgram(const String                & program,
+                                      const String                & input,
+                                      const RulesCalculate_operand operands[],
+                                      ESPEASY_RULES_FLOAT_TYPE     *result)
+{
+  char   token[TOKEN_LENGTH];
+  size_t tokenLength = 0;
+  size_t operand     = 0;
+
+  sp = globalstack - 1;
+
+  for (size_t i = 0; i < program.length(); ++i) {
+    const char c = program[i];
+
+    if (c == ' ') {
+      token[tokenLength] = 0;
+
+      if (isError(RPNCalculate(token))) {
+        return false;
+      }
+      tokenLength = 0;
+    } else if (c == CALCULATE_OPERAND_MARKER) {
+      const RulesCalculate_operand& op = operands[operand];
+
+      if ((tokenLength + op._length) >= (TOKEN_LENGTH - 1)) {
+        // Let doCalculate() decide whether this exceeds the max. token length.
+        return false;
+      }
+
+      for (size_t j = 0; j < op._length; ++j) {
+        token[tokenLength] = input[op._start + j];
+        ++tokenLength;
+      }
+      ++operand;
+    } else {
+      if ((tokenLength + 1) >= (TOKEN_LENGTH - 1)) {
+        return false;
+      }
+      token[tokenLength] = c;
+      ++tokenLength;
+    }
+  }
+
+  if (sp < globalstack) {
+    // Nothing evaluated
+    return false;
+  }
+  *result = *sp;
+  return true;
+}
+
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 void preProcessReplace(String& input, UnaryOperator op) {
   String find = toString(op);
 
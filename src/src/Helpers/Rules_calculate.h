@@ -4,6 +4,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <vector>
+
 /********************************************************************************************\
    Calculate function for simple expressions
  \*********************************************************************************************/
@@ -13,6 +15,14 @@
 #define TOKEN_LENGTH 25
 #define OPERATOR_STACK_SIZE 32
 
+#if FEATURE_RULES_CALCULATE_CACHE
+# define CALCULATE_CACHE_SIZE     8
+# define CALCULATE_MAX_OPERANDS   16
+
+// Marker for a numerical operand in a cached expression template.
+# define CALCULATE_OPERAND_MARKER '\x01'
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 enum class CalculateReturnCode : uint8_t{
   OK                           = 0u,
   ERROR_STACK_OVERFLOW         = 1u,
@@ -57,6 +67,26 @@ void   preProcessReplace(String      & input,
 bool   angleDegree(UnaryOperator op);
 const __FlashStringHelper* toString(UnaryOperator op);
 
+#if FEATURE_RULES_CALCULATE_CACHE
+
+// Position of a numerical operand in the expression given to Calculate.
+struct RulesCalculate_operand {
+  uint16_t _start  = 0;
+  uint16_t _length = 0;
+};
+
+// Compiled expression, where the numerical operands are replaced by a marker.
+// For example "sin_d(30)+[var#1]*2.5" (after replacing [var#1] by its value)
+// is stored as template "sin_d(\x01)+\x01*\x01" and the RPN tokens are only
+// computed once for all evaluations of this expression.
+struct RulesCalculate_cacheElement {
+  String   _template;
+  String   _program;  // RPN tokens, separated by a space
+  uint32_t _lastUsed = 0;
+  bool     _valid    = false;
+};
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
 class RulesCalculate_t {
 private:
 
@@ -89,6 +119,35 @@ private:
 
   CalculateReturnCode RPNCalculate(char *token);
 
+  // Either evaluate the token, or add it to the program being compiled.
+  CalculateReturnCode processToken(char *token);
+
+#if FEATURE_RULES_CALCULATE_CACHE
+
+  // Replace the numerical operands in the input by a marker.
+  // Return false when the input cannot be used as a template.
+  static bool makeTemplate(const String         & input,
+                           String               & expressionTemplate,
+                           RulesCalculate_operand operands[],
+                           uint8_t              & nrOperands);
+
+  const RulesCalculate_cacheElement& getCompiled(const String& expressionTemplate,
+                                                 uint8_t       nrOperands);
+
+  // Return false when the program could not be executed and the expression
+  // must be evaluated by doCalculate() to get the same result or error.
+  bool executeProgram(const String                & program,
+                      const String                & input,
+                      const RulesCalculate_operand operands[],
+                      ESPEASY_RULES_FLOAT_TYPE     *result);
+
+  std::vector<RulesCalculate_cacheElement>_cache;
+  uint32_t                                _cacheCounter = 0;
+
+  // Program being compiled by doCalculate()
+  String *_program = nullptr;
+#endif // if FEATURE_RULES_CALCULATE_CACHE
+
   // operators
   // precedence   operators         associativity
   // 3            !                 right to left
@@ -107,6 +166,12 @@ public:
   CalculateReturnCode doCalculate(const char *input,
                                   ESPEASY_RULES_FLOAT_TYPE     *result);
 
+  // Same as doCalculate(), but the input is not yet pre-processed.
+  // Recently used expressions are kept compiled, so repeated evaluations
+  // of the same formula with other values only need to execute the RPN tokens.
+  CalculateReturnCode doCalculateCached(const String& input,
+                                        ESPEASY_RULES_FLOAT_TYPE *result);
+
   // Try to replace multi byte operators with single character ones.
   // For example log, sin, cos, tan.
   static String preProces(const String& input);
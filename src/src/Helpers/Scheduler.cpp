@@ -62,6 +62,10 @@ void ESPEasy_Scheduler::handle_schedule() {
   }
 
   const SchedulerTimerID timerID(mixed_id);
+  #if FEATURE_TIMING_STATS
+  const long     lateness = timePassedSince(timer);
+  const uint64_t jobStart(getMicros64());
+  #endif // if FEATURE_TIMING_STATS
 
   delay(0); // See: https://github.com/letscontrolit/ESPEasy/issues/1818#issuecomment-425351328
 
@@ -92,6 +96,9 @@ void ESPEasy_Scheduler::handle_schedule() {
       // - IntendedReboot is just used to mark the intended reboot reason in RTC.
       break;
   }
+  #if FEATURE_TIMING_STATS
+  addSchedulerTimingStat(timerID.getTimerType(), lateness, jobStart);
+  #endif // if FEATURE_TIMING_STATS
   STOP_TIMER(HANDLE_SCHEDULER_TASK);
 }
 
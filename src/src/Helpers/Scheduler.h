@@ -241,8 +241,9 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
                                         struct EventStruct&& event);
 
 #if FEATURE_MQTT
+  // Event is not scheduled per task, but dispatched to all tasks
+  // with a subscription matching the topic when processed.
   void schedule_mqtt_plugin_import_event_timer(deviceIndex_t DeviceIndex,
-                                               taskIndex_t   TaskIndex,
                                                uint8_t       Function,
                                                char         *c_topic,
                                                uint8_t      *b_payload,
@@ -298,6 +299,15 @@ void                 setPluginTaskTimer(unsigned long msecFromNow,
 
 private:
 
+#if FEATURE_MQTT
+
+  // Call the MQTT import plugin for each task with a subscription matching the topic in event.String1
+  // The same event is used for all tasks, so the payload is only kept in memory once.
+  void dispatch_mqtt_plugin_import_event(deviceIndex_t       DeviceIndex,
+                                         uint8_t             Function,
+                                         struct EventStruct& event);
+#endif // if FEATURE_MQTT
+
   // Map mixed timer ID to system timer struct.
   // N.B. Must use Mixed timer ID, similar to how it is handled in the scheduler.
   std::map<unsigned long, systemTimerStruct>systemTimers;
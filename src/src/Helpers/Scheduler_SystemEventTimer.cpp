@@ -5,8 +5,11 @@
 
 #include "../Globals/CPlugins.h"
 #include "../Globals/Device.h"
+#include "../Globals/MQTT.h"
 #include "../Globals/NPlugins.h"
+#include "../Globals/Plugins.h"
 #include "../Globals/RTC.h"
+#include "../Globals/Settings.h"
 
 #include "../Helpers/_Plugin_init.h"
 #include "../Helpers/ESPEasyRTC.h"
@@ -34,13 +37,12 @@ void ESPEasy_Scheduler::schedule_plugin_task_event_timer(
 #if FEATURE_MQTT
 void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(
   deviceIndex_t DeviceIndex,
-  taskIndex_t   TaskIndex,
   uint8_t       Function,
   char         *c_topic,
   uint8_t      *b_payload,
   unsigned int  length) {
   if (validDeviceIndex(DeviceIndex)) {
-    EventStruct  event(TaskIndex);
+    EventStruct  event;
     const size_t topic_length = strlen_P(c_topic);
 
     if (!(event.String1.reserve(topic_length) &&
@@ -68,6 +70,29 @@ void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(
   }
 }
 
+void ESPEasy_Scheduler::dispatch_mqtt_plugin_import_event(
+  deviceIndex_t       DeviceIndex,
+  uint8_t             Function,
+  struct EventStruct& event) {
+  std::vector<taskIndex_t> taskIndices;
+
+  MQTTimport_subscriptions.getMatchingTasks(event.String1.c_str(), taskIndices);
+
+  String dummy;
+
+  for (const taskIndex_t taskIndex : taskIndices) {
+    if (validTaskIndex(taskIndex) &&
+        Settings.TaskDeviceEnabled[taskIndex] &&
+        (getDeviceIndex_from_TaskIndex(taskIndex) == DeviceIndex)) {
+      if (Device[DeviceIndex].ErrorStateValues) {
+        LoadTaskSettings(taskIndex);
+      }
+      event.setTaskIndex(taskIndex);
+      PluginCall(DeviceIndex, Function, &event, dummy);
+    }
+  }
+}
+
 #endif // if FEATURE_MQTT
 
 void ESPEasy_Scheduler::schedule_controller_event_timer(
@@ -177,6 +202,14 @@ void ESPEasy_Scheduler::process_system_event_queue() {
       const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(Index);
 
       if (validDeviceIndex(deviceIndex)) {
+#if FEATURE_MQTT
+
+        if (Function == PLUGIN_MQTT_IMPORT) {
+          dispatch_mqtt_plugin_import_event(deviceIndex, Function, ScheduledEventQueue.front().event);
+          break;
+        }
+#endif // if FEATURE_MQTT
+
         if (((Function != PLUGIN_READ) &&
              (Function != PLUGIN_MQTT_CONNECTION_STATE) &&
              (Function != PLUGIN_MQTT_IMPORT))
@@ -15,6 +15,7 @@
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/MQTT.h"
 #include "../Globals/Plugins.h"
+#include "../Globals/Plugins_other.h"
 #include "../Globals/Settings.h"
 
 #include "../Helpers/Convert.h"
@@ -310,6 +311,21 @@ void addNewLine(String& line) {
   line += F("\r\n");
 }
 
+void appendSubstring(String& dest, const String& src, int start, int end) {
+  if (end > static_cast<int>(src.length())) {
+    end = src.length();
+  }
+
+  if ((start == 0) && (end == static_cast<int>(src.length()))) {
+    dest += src;
+    return;
+  }
+
+  for (int i = start; i < end; ++i) {
+    dest += src[i];
+  }
+}
+
 size_t UTF8_charLength(uint8_t firstByte) {
   if (firstByte <= 0x7f) {
     return 1;
@@ -1178,6 +1194,17 @@ void parseSpecialCharacters(String& s, bool useURLencode)
    replace other system variables like %sysname%, %systime%, %ip%
  \*********************************************************************************************/
 void parseControllerVariables(String& s, struct EventStruct *event, bool useURLencode) {
+  #if FEATURE_COMPILED_TEMPLATES
+
+  if ((event != nullptr) && validControllerIndex(event->ControllerIndex) && (parseTemplate_CallBack_ptr == nullptr)) {
+    const CompiledTemplateStruct& compiled = Cache.getControllerTemplate(event->ControllerIndex, s);
+
+    if (compiled.isCompiled()) {
+      s = compiled.render(event, 0, useURLencode);
+      return;
+    }
+  }
+  #endif // if FEATURE_COMPILED_TEMPLATES
   s = parseTemplate(s, useURLencode);
   parseEventVariables(s, event, useURLencode);
 }
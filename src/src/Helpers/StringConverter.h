@@ -134,6 +134,12 @@ void   removeChar(String& line, char character);
 
 void   addNewLine(String& line);
 
+// Append the characters [start, end) of src to dest, without creating a temporary substring.
+void   appendSubstring(String      & dest,
+                       const String& src,
+                       int           start,
+                       int           end);
+
 size_t UTF8_charLength(uint8_t firstByte);
 
 void   replaceUnicodeByChar(String& line, char replChar);
@@ -52,149 +52,28 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
   const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
   String newString;
 
-  newString.reserve(minimal_lineSize); // Our best guess of the new size.
-
-
   if (parseTemplate_CallBack_ptr != nullptr) {
     parseTemplate_CallBack_ptr(tmpString, useURLencode);
   }
   parseSystemVariables(tmpString, useURLencode);
 
+  // Our best guess of the new size.
+  // All output is appended to this buffer, so no intermediate copies of the template are made.
+  newString.reserve(std::max(static_cast<unsigned int>(minimal_lineSize), tmpString.length()) + 16);
 
   int startpos = 0;
   int lastStartpos = 0;
   int endpos = 0;
-  {
+
+  // Single forward scan for [...#...] markers, skipped altogether when there cannot be any.
+  if (tmpString.indexOf('[') != -1) {
     String deviceName, valueName, format;
 
     while (findNextDevValNameInString(tmpString, startpos, endpos, deviceName, valueName, format)) {
       // First copy all upto the start of the [...#...] part to be replaced.
-      newString += tmpString.substring(lastStartpos, startpos);
-
-      // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
-      const bool devNameEqInt = equals(deviceName, F("int"));
-      if (devNameEqInt || equals(deviceName, F("var")))
-      {
-        // Address an internal variable either as float or as int
-        // For example: Let,10,[VAR#9]
-        unsigned int varNum;
-
-        if (validUIntFromString(valueName, varNum)) {
-          unsigned char nr_decimals = maxNrDecimals_fpType(getCustomFloatVar(varNum));
-          bool trimTrailingZeros    = true;
-
-          if (devNameEqInt) {
-            nr_decimals = 0;
-          } else if (!format.isEmpty())
-          {
-            // There is some formatting here, so do not throw away decimals
-            trimTrailingZeros = false;
-          }
-          #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
-          String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
-          #else
-          String value = floatToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
-          #endif
-          transformValue(
-            newString, 
-            minimal_lineSize, 
-            std::move(value), 
-            format, 
-            tmpString);
-        }
-      }
-      else if (equals(deviceName, F("plugin")))
-      {
-        // Handle a plugin request.
-        // For example: "[Plugin#GPIO#Pinstate#N]"
-        // The command is stored in valueName & format
-        String command;
-        command.reserve(valueName.length() + format.length() + 1);
-        command  = valueName;
-        command += '#';
-        command += format;
-        command.replace('#', ',');
-
-        if (getGPIOPinStateValues(command)) {
-          newString += command;
-        }
-  /* @giig1967g
-        if (PluginCall(PLUGIN_REQUEST, 0, command))
-        {
-          // Do not call transformValue here.
-          // The "format" is not empty so must not call the formatter function.
-          newString += command;
-        }
-  */
-      }
-      else
-      {
-        // Address a value from a plugin.
-        // For example: "[bme#temp]"
-        // If value name is unknown, run a PLUGIN_GET_CONFIG_VALUE command.
-        // For example: "[<taskname>#getLevel]"
-        taskIndex_t taskIndex = findTaskIndexByName(deviceName, true); // Check for enabled/disabled is done separately
-
-        if (validTaskIndex(taskIndex)) {
-          bool isHandled = false;
-          if (Settings.TaskDeviceEnabled[taskIndex]) {
-            uint8_t valueNr = findDeviceValueIndexByName(valueName, taskIndex);
-
-            if (valueNr != VARS_PER_TASK) {
-              // here we know the task and value, so find the uservar
-              // Try to format and transform the values
-              bool   isvalid;
-              String value = formatUserVar(taskIndex, valueNr, isvalid);
-
-              if (isvalid) {
-                transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
-                isHandled = true;
-              }
-            } else {
-              // try if this is a get config request
-              struct EventStruct TempEvent(taskIndex);
-              String tmpName = valueName;
-
-              if (PluginCall(PLUGIN_GET_CONFIG_VALUE, &TempEvent, tmpName))
-              {
-                transformValue(newString, minimal_lineSize, std::move(tmpName), format, tmpString);
-                isHandled = true;
-              }
-            }
-          }
-          if (!isHandled && valueName.startsWith(F("settings."))) {  // Task settings values
-            String value;
-            if (valueName.endsWith(F(".enabled"))) {           // Task state
-              value = Settings.TaskDeviceEnabled[taskIndex] ? '1' : '0';
-            } else if (valueName.endsWith(F(".interval"))) {   // Task interval
-              value = Settings.TaskDeviceTimer[taskIndex];
-            } else if (valueName.endsWith(F(".valuecount"))) { // Task value count
-              value = getValueCountForTask(taskIndex);
-            } else if ((valueName.indexOf(F(".controller")) == 8) && valueName.length() >= 20) { // Task controller values
-              String ctrl = valueName.substring(19, 20);
-              int ctrlNr = 0;
-              if (validIntFromString(ctrl, ctrlNr) && (ctrlNr >= 1) && (ctrlNr <= CONTROLLER_MAX) && 
-                  Settings.ControllerEnabled[ctrlNr - 1]) { // Controller nr. valid and enabled
-                if (valueName.endsWith(F(".enabled"))) {    // Task-controller enabled
-                  value = Settings.TaskDeviceSendData[ctrlNr - 1][taskIndex];
-                } else if (valueName.endsWith(F(".idx"))) { // Task-controller idx value
-                  protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(ctrlNr - 1);
-
-                  if (validProtocolIndex(ProtocolIndex) && 
-                      getProtocolStruct(ProtocolIndex).usesID && (Settings.Protocol[ctrlNr - 1] != 0)) {
-                    value = Settings.TaskDeviceID[ctrlNr - 1][taskIndex];
-                  }
-                }
-              }
-            }
-            if (!value.isEmpty()) {
-              transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
-              // isHandled = true;
-            }
-          }
-        }
-      }
+      appendSubstring(newString, tmpString, lastStartpos, startpos);
 
+      parseTemplate_appendMarker(newString, minimal_lineSize, deviceName, valueName, format, tmpString);
 
       // Conversion is done (or impossible) for the found "[...#...]"
       // Continue with the next one.
@@ -207,7 +86,7 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
   }
 
   // Copy the rest of the string (or all if no replacements were done)
-  newString += tmpString.substring(lastStartpos);
+  appendSubstring(newString, tmpString, lastStartpos, tmpString.length());
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("parseTemplate2"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -235,6 +114,159 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
   return newString;
 }
 
+String parseTemplate_compiled(taskIndex_t taskIndex, const String& tmpString, uint8_t minimal_lineSize)
+{
+  #if FEATURE_COMPILED_TEMPLATES
+
+  if (validTaskIndex(taskIndex) && (parseTemplate_CallBack_ptr == nullptr)) {
+    const CompiledTemplateStruct& compiled = Cache.getTaskTemplate(taskIndex, tmpString);
+
+    if (compiled.isCompiled()) {
+      return compiled.render(nullptr, minimal_lineSize, false);
+    }
+  }
+  #endif // if FEATURE_COMPILED_TEMPLATES
+
+  // parseTemplate_padded() will replace the system variables in the template
+  String tmp(tmpString);
+
+  return parseTemplate_padded(tmp, minimal_lineSize);
+}
+
+// Append the replacement of a single [deviceName#valueName#format] marker.
+// Nothing is appended when the marker cannot be resolved.
+void parseTemplate_appendMarker(String      & newString,
+                                uint8_t       minimal_lineSize,
+                                const String& deviceName,
+                                const String& valueName,
+                                String      & format,
+                                const String& tmpString)
+{
+  // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
+  const bool devNameEqInt = equals(deviceName, F("int"));
+  if (devNameEqInt || equals(deviceName, F("var")))
+  {
+    // Address an internal variable either as float or as int
+    // For example: Let,10,[VAR#9]
+    unsigned int varNum;
+
+    if (validUIntFromString(valueName, varNum)) {
+      unsigned char nr_decimals = maxNrDecimals_fpType(getCustomFloatVar(varNum));
+      bool trimTrailingZeros    = true;
+
+      if (devNameEqInt) {
+        nr_decimals = 0;
+      } else if (!format.isEmpty())
+      {
+        // There is some formatting here, so do not throw away decimals
+        trimTrailingZeros = false;
+      }
+      #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+      String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
+      #else
+      String value = floatToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
+      #endif
+      transformValue(
+        newString,
+        minimal_lineSize,
+        std::move(value),
+        format,
+        tmpString);
+    }
+  }
+  else if (equals(deviceName, F("plugin")))
+  {
+    // Handle a plugin request.
+    // For example: "[Plugin#GPIO#Pinstate#N]"
+    // The command is stored in valueName & format
+    String command;
+    command.reserve(valueName.length() + format.length() + 1);
+    command  = valueName;
+    command += '#';
+    command += format;
+    command.replace('#', ',');
+
+    if (getGPIOPinStateValues(command)) {
+      newString += command;
+    }
+  /* @giig1967g
+    if (PluginCall(PLUGIN_REQUEST, 0, command))
+    {
+      // Do not call transformValue here.
+      // The "format" is not empty so must not call the formatter function.
+      newString += command;
+    }
+  */
+  }
+  else
+  {
+    // Address a value from a plugin.
+    // For example: "[bme#temp]"
+    // If value name is unknown, run a PLUGIN_GET_CONFIG_VALUE command.
+    // For example: "[<taskname>#getLevel]"
+    taskIndex_t taskIndex = findTaskIndexByName(deviceName, true); // Check for enabled/disabled is done separately
+
+    if (validTaskIndex(taskIndex)) {
+      bool isHandled = false;
+      if (Settings.TaskDeviceEnabled[taskIndex]) {
+        uint8_t valueNr = findDeviceValueIndexByName(valueName, taskIndex);
+
+        if (valueNr != VARS_PER_TASK) {
+          // here we know the task and value, so find the uservar
+          // Try to format and transform the values
+          bool   isvalid;
+          String value = formatUserVar(taskIndex, valueNr, isvalid);
+
+          if (isvalid) {
+            transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
+            isHandled = true;
+          }
+        } else {
+          // try if this is a get config request
+          struct EventStruct TempEvent(taskIndex);
+          String tmpName = valueName;
+
+          if (PluginCall(PLUGIN_GET_CONFIG_VALUE, &TempEvent, tmpName))
+          {
+            transformValue(newString, minimal_lineSize, std::move(tmpName), format, tmpString);
+            isHandled = true;
+          }
+        }
+      }
+      if (!isHandled && valueName.startsWith(F("settings."))) {  // Task settings values
+        String value;
+        if (valueName.endsWith(F(".enabled"))) {           // Task state
+          value = Settings.TaskDeviceEnabled[taskIndex] ? '1' : '0';
+        } else if (valueName.endsWith(F(".interval"))) {   // Task interval
+          value = Settings.TaskDeviceTimer[taskIndex];
+        } else if (valueName.endsWith(F(".valuecount"))) { // Task value count
+          value = getValueCountForTask(taskIndex);
+        } else if ((valueName.indexOf(F(".controller")) == 8) && valueName.length() >= 20) { // Task controller values
+          String ctrl = valueName.substring(19, 20);
+          int ctrlNr = 0;
+          if (validIntFromString(ctrl, ctrlNr) && (ctrlNr >= 1) && (ctrlNr <= CONTROLLER_MAX) && 
+              Settings.ControllerEnabled[ctrlNr - 1]) { // Controller nr. valid and enabled
+            if (valueName.endsWith(F(".enabled"))) {    // Task-controller enabled
+              value = Settings.TaskDeviceSendData[ctrlNr - 1][taskIndex];
+            } else if (valueName.endsWith(F(".idx"))) { // Task-controller idx value
+              protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(ctrlNr - 1);
+
+              if (validProtocolIndex(ProtocolIndex) && 
+                  getProtocolStruct(ProtocolIndex).usesID && (Settings.Protocol[ctrlNr - 1] != 0)) {
+                value = Settings.TaskDeviceID[ctrlNr - 1][taskIndex];
+              }
+            }
+          }
+        }
+        if (!value.isEmpty()) {
+          transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
+          // isHandled = true;
+        }
+      }
+    }
+  }
+}
+
 /********************************************************************************************\
    Transform values
  \*********************************************************************************************/
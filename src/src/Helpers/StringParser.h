@@ -20,6 +20,23 @@ String parseTemplate_padded(String& tmpString,
                             uint8_t    minimal_lineSize,
                             bool    useURLencode);
 
+// Same as parseTemplate_padded(), using a compiled version of the template kept in the cache of the task.
+// Meant for templates which are used repeatedly, like display lines.
+// tmpString is not modified.
+String parseTemplate_compiled(taskIndex_t   taskIndex,
+                              const String& tmpString,
+                              uint8_t       minimal_lineSize);
+
+// Append the replacement of a single [deviceName#valueName#format] marker.
+// deviceName and valueName must be lower case.
+// Nothing is appended when the marker cannot be resolved.
+void parseTemplate_appendMarker(String      & newString,
+                                uint8_t       minimal_lineSize,
+                                const String& deviceName,
+                                const String& valueName,
+                                String      & format,
+                                const String& tmpString);
+
 
 /********************************************************************************************\
    Transform values
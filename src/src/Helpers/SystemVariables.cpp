@@ -38,36 +38,8 @@
   # include <WiFi.h>
 #endif // if defined(ESP32)
 
+#include <algorithm>
 
-String getReplacementString(const String& format, String& s) {
-  int startpos = s.indexOf(format);
-  int endpos   = s.indexOf('%', startpos + 1);
-  String R     = s.substring(startpos, endpos + 1);
-
-#ifndef BUILD_NO_DEBUG
-
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    String log = F("ReplacementString SunTime: ");
-    log += R;
-    log += F(" offset: ");
-    log += ESPEasy_time::getSecOffset(R);
-    addLogMove(LOG_LEVEL_DEBUG, log);
-  }
-#endif // ifndef BUILD_NO_DEBUG
-  return R;
-}
-
-void replSunRiseTimeString(const String& format, String& s, boolean useURLencode) {
-  String R = getReplacementString(format, s);
-
-  repl(R, node_time.getSunriseTimeString(':', ESPEasy_time::getSecOffset(R)), s, useURLencode);
-}
-
-void replSunSetTimeString(const String& format, String& s, boolean useURLencode) {
-  String R = getReplacementString(format, s);
-
-  repl(R, node_time.getSunsetTimeString(':', ESPEasy_time::getSecOffset(R)), s, useURLencode);
-}
 
 String timeReplacement_leadZero(int value)
 {
@@ -136,7 +108,162 @@ LabelType::Enum SystemVariables2LabelType(SystemVariables::Enum enumval) {
 }
 
 
+SystemVariables::Volatility SystemVariables::getVolatility(SystemVariables::Enum enumval) {
+  switch (enumval)
+  {
+    case MAC:
+    case MAC_INT:
+    case SYSBUILD_DATE:
+    case SYSBUILD_DESCR:
+    case SYSBUILD_FILENAME:
+    case SYSBUILD_GIT:
+    case SYSBUILD_TIME:
+    case SYSNAME:
+    case UNIT_sysvar:
+    #if FEATURE_ZEROFILLED_UNITNUMBER
+    case UNIT_0_sysvar:
+    #endif // FEATURE_ZEROFILLED_UNITNUMBER
+    case FLASH_FREQ:
+    case FLASH_SIZE:
+    case FLASH_CHIP_VENDOR:
+    case FLASH_CHIP_MODEL:
+    case FS_SIZE:
+    case ESP_CHIP_ID:
+    case ESP_CHIP_FREQ:
+    case ESP_CHIP_MODEL:
+    case ESP_CHIP_REVISION:
+    case ESP_CHIP_CORES:
+    case ESP_BOARD_NAME:
+      return Volatility::Static;
+
+    case BSSID:
+    case IP:
+    case IP4:
+    case SUBNET:
+    case GATEWAY:
+    case DNS:
+    case DNS_1:
+    case DNS_2:
+    case SSID:
+    case WI_CH:
+    #if FEATURE_ETHERNET
+    case ETHWIFIMODE:
+    case ETHCONNECTED:
+    case ETHDUPLEX:
+    case ETHSPEED:
+    case ETHSTATE:
+    case ETHSPEEDSTATE:
+    #endif // if FEATURE_ETHERNET
+      return Volatility::Network;
+
+    // Simple values, or values which are expected to be exact at the moment of the call
+    case BOOT_CAUSE:
+    case CR:
+    case LF:
+    case SPACE:
+    case S_CR:
+    case S_LF:
+    case CLIENTIP:
+    case ISMQTT:
+    case ISMQTTIMP:
+    case ISNTP:
+    case ISWIFI:
+    case SUNRISE:
+    case SUNSET:
+    case SYSHEAP:
+    case SYSSTACK:
+    case UPTIME_MS:
+    case UNKNOWN:
+      return Volatility::PerCall;
+
+    default:
+      // Time related values and measurements like RSSI, load, VCC and free file system space.
+      break;
+  }
+  return Volatility::PerSecond;
+}
+
+#if FEATURE_SYSVAR_CACHE
+
+// Small cache for computed values, replacing the oldest entry when full.
+// An entry is valid as long as its generation matches the current generation for its volatility.
+# ifndef SYSVAR_CACHE_SIZE
+#  define SYSVAR_CACHE_SIZE  16
+# endif // ifndef SYSVAR_CACHE_SIZE
+
+struct SystemVariableCacheEntry {
+  String                value;
+  uint32_t              generation = 0;
+  SystemVariables::Enum enumval    = SystemVariables::UNKNOWN;
+};
+
+static SystemVariableCacheEntry systemVariableCache[SYSVAR_CACHE_SIZE];
+static uint8_t  systemVariableCacheNext = 0;
+static uint32_t systemVariableNetworkGeneration = 0;
+
+#endif // if FEATURE_SYSVAR_CACHE
+
+void SystemVariables::markNetworkChanged() {
+  #if FEATURE_SYSVAR_CACHE
+  ++systemVariableNetworkGeneration;
+  #endif // if FEATURE_SYSVAR_CACHE
+}
+
+void SystemVariables::clearCache() {
+  #if FEATURE_SYSVAR_CACHE
+
+  for (uint8_t i = 0; i < SYSVAR_CACHE_SIZE; ++i) {
+    systemVariableCache[i].enumval = UNKNOWN;
+    systemVariableCache[i].value   = String();
+  }
+  systemVariableCacheNext = 0;
+  #endif // if FEATURE_SYSVAR_CACHE
+}
+
 String SystemVariables::getSystemVariable(SystemVariables::Enum enumval) {
+  #if FEATURE_SYSVAR_CACHE
+  uint32_t generation = 0;
+
+  switch (getVolatility(enumval)) {
+    case Volatility::PerCall:
+      return computeSystemVariable(enumval);
+    case Volatility::Static:
+      break;
+    case Volatility::Network:
+      generation = systemVariableNetworkGeneration;
+      break;
+    case Volatility::PerSecond:
+      // Same moment the local time used by the time variables is updated.
+      generation = node_time.getUnixTime();
+      break;
+  }
+
+  for (uint8_t i = 0; i < SYSVAR_CACHE_SIZE; ++i) {
+    SystemVariableCacheEntry& entry = systemVariableCache[i];
+
+    if (entry.enumval == enumval) {
+      if (entry.generation != generation) {
+        entry.value      = computeSystemVariable(enumval);
+        entry.generation = generation;
+      }
+      return entry.value;
+    }
+  }
+
+  SystemVariableCacheEntry& entry = systemVariableCache[systemVariableCacheNext];
+
+  systemVariableCacheNext = (systemVariableCacheNext + 1) % SYSVAR_CACHE_SIZE;
+
+  entry.value      = computeSystemVariable(enumval);
+  entry.generation = generation;
+  entry.enumval    = enumval;
+  return entry.value;
+  #else // if FEATURE_SYSVAR_CACHE
+  return computeSystemVariable(enumval);
+  #endif // if FEATURE_SYSVAR_CACHE
+}
+
+String SystemVariables::computeSystemVariable(SystemVariables::Enum enumval) {
   const LabelType::Enum label = SystemVariables2LabelType(enumval);
 
   if (LabelType::MAX_LABEL != label) {
@@ -223,111 +350,232 @@ String SystemVariables::getSystemVariable(SystemVariables::Enum enumval) {
   return EMPTY_STRING;
 }
 
-#define SMART_REPL_T(T, S) \
-  while (s.indexOf(T) != -1) { (S((T), s, useURLencode)); }
-
-void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
+// Compare a name of 'length' characters with a name stored in flash.
+// Return < 0 when name sorts before flashName, 0 when equal and > 0 when name sorts after flashName.
+int compareSystemVariableName(const char *name, size_t length, const __FlashStringHelper *flashName)
 {
-  START_TIMER
+  PGM_P p = reinterpret_cast<PGM_P>(flashName);
 
-  if (s.indexOf('%') == -1) {
-    STOP_TIMER(PARSE_SYSVAR_NOCHANGE);
-    return;
+  for (size_t i = 0; i < length; ++i) {
+    const uint8_t c = pgm_read_byte(p + i);
+
+    if ((c == 0) || (static_cast<uint8_t>(name[i]) != c)) {
+      return static_cast<uint8_t>(name[i]) < c ? -1 : 1;
+    }
   }
+  return (pgm_read_byte(p + length) == 0) ? 0 : -1;
+}
 
-  SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(0);
-
-  do {
-    enumval = SystemVariables::nextReplacementEnum(s, enumval);
-
-    switch (enumval)
-    {
-      case SUNRISE:           
-        SMART_REPL_T(SystemVariables::toString(enumval), replSunRiseTimeString); 
-        break;
-      case SUNSET:            
-        SMART_REPL_T(SystemVariables::toString(enumval), replSunSetTimeString); 
-        break;
-      case UNKNOWN:
-
-        // Do not replace
-        break;
-      default:
-      {
-        const String value = getSystemVariable(enumval);
-        repl(SystemVariables::toString(enumval), value, s, useURLencode);
-        break;
-      }
+bool systemVariableNameLess(uint8_t lhs, uint8_t rhs)
+{
+  PGM_P p1 = reinterpret_cast<PGM_P>(SystemVariables::toFlashString(static_cast<SystemVariables::Enum>(lhs)));
+  PGM_P p2 = reinterpret_cast<PGM_P>(SystemVariables::toFlashString(static_cast<SystemVariables::Enum>(rhs)));
+
+  for (;;) {
+    const uint8_t c1 = pgm_read_byte(p1++);
+    const uint8_t c2 = pgm_read_byte(p2++);
+
+    if ((c1 != c2) || (c1 == 0)) {
+      return c1 < c2;
     }
   }
-  while (enumval != SystemVariables::Enum::UNKNOWN);
-
-  int v_index = s.indexOf(F("%v"));
-
-  while ((v_index != -1)) {
-    unsigned int i;
-
-    if (validUIntFromString(s.substring(v_index + 2), i)) {
-      String key = F("%v");
-      key += i;
-      key += '%';
-
-      if (s.indexOf(key) != -1) {
-        const bool trimTrailingZeros = true;
-        #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
-        const String value = doubleToString(getCustomFloatVar(i), 6, trimTrailingZeros);
-        #else
-        const String value = floatToString(getCustomFloatVar(i), 6, trimTrailingZeros);
-        #endif
-        repl(key, value, s, useURLencode);
-      }
+}
+
+// Enum values sorted by their name, to allow a binary search on the name.
+// The enum itself cannot be kept sorted by name as some entries depend on build flags.
+const uint8_t * getSystemVariablesSortedByName()
+{
+  static uint8_t sorted[SystemVariables::Enum::UNKNOWN] = { 0 };
+  static bool    initialized                             = false;
+
+  if (!initialized) {
+    for (uint8_t i = 0; i < SystemVariables::Enum::UNKNOWN; ++i) {
+      sorted[i] = i;
     }
-    v_index = s.indexOf(F("%v"), v_index + 1); // Find next occurance
+    std::sort(sorted, sorted + SystemVariables::Enum::UNKNOWN, systemVariableNameLess);
+    initialized = true;
   }
+  return sorted;
+}
 
-  STOP_TIMER(PARSE_SYSVAR);
+// Check for a sunrise/sunset variable with an offset, like "sunrise-1h"
+bool isSunTimeWithOffset(const char *name, size_t length, const __FlashStringHelper *prefix)
+{
+  const size_t prefix_length = strlen_P(reinterpret_cast<PGM_P>(prefix));
+
+  return length > prefix_length &&
+         (name[prefix_length] == '+' || name[prefix_length] == '-') &&
+         strncmp_P(name, reinterpret_cast<PGM_P>(prefix), prefix_length) == 0;
 }
 
-#undef SMART_REPL_T
+// Check for "vN", referring to the internal variable N.
+bool isCustomFloatVarName(const char *name, size_t length, unsigned int& varNum)
+{
+  // Keep the number of digits limited, to prevent overflow.
+  // Leading zeroes are not accepted, like the "%v1%" key the old search and replace used.
+  if ((length < 2) || (length > 10) || (name[0] != 'v') || ((name[1] == '0') && (length > 2))) {
+    return false;
+  }
+  varNum = 0;
 
+  for (size_t i = 1; i < length; ++i) {
+    if (!isDigit(name[i])) {
+      return false;
+    }
+    varNum = (varNum * 10) + (name[i] - '0');
+  }
+  return true;
+}
 
-SystemVariables::Enum SystemVariables::nextReplacementEnum(const String& str, SystemVariables::Enum last_tested)
+bool SystemVariables::parseToken(const char *name, size_t length, SystemVariables::Token& token)
 {
-  if (str.indexOf('%') == -1) {
-    return Enum::UNKNOWN;
+  token = Token();
+
+  unsigned int varNum = 0;
+
+  if (isCustomFloatVarName(name, length, varNum)) {
+    token.isCustomFloatVar = true;
+    token.param            = varNum;
+    return true;
   }
 
-  SystemVariables::Enum nextTested = static_cast<SystemVariables::Enum>(0);
+  token.enumval = findByName(name, length);
 
-  if (last_tested > nextTested) {
-    nextTested = static_cast<SystemVariables::Enum>(last_tested + 1);
+  if (token.enumval != Enum::UNKNOWN) {
+    return true;
   }
 
-  if (nextTested >= Enum::UNKNOWN) {
-    return Enum::UNKNOWN;
+  const bool sunrise = isSunTimeWithOffset(name, length, F("sunrise"));
+
+  if (sunrise || isSunTimeWithOffset(name, length, F("sunset"))) {
+    // getSecOffset() expects the trailing '%'
+    String format;
+
+    if (format.reserve(length + 2)) {
+      format += '%';
+
+      for (size_t i = 0; i < length; ++i) {
+        format += name[i];
+      }
+      format += '%';
+    }
+    token.enumval = sunrise ? Enum::SUNRISE : Enum::SUNSET;
+    token.param   = ESPEasy_time::getSecOffset(format);
+
+    #ifndef BUILD_NO_DEBUG
+
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+      String log = F("ReplacementString SunTime: ");
+      log += format;
+      log += F(" offset: ");
+      log += token.param;
+      addLogMove(LOG_LEVEL_DEBUG, log);
+    }
+    #endif // ifndef BUILD_NO_DEBUG
+    return true;
   }
+  return false;
+}
 
-  String str_prefix        = SystemVariables::toString(nextTested).substring(0, 2);
-  bool   str_prefix_exists = str.indexOf(str_prefix) != -1;
+String SystemVariables::getTokenValue(const SystemVariables::Token& token)
+{
+  if (token.isCustomFloatVar) {
+    const bool trimTrailingZeros = true;
+    #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+    return doubleToString(getCustomFloatVar(token.param), 6, trimTrailingZeros);
+    #else
+    return floatToString(getCustomFloatVar(token.param), 6, trimTrailingZeros);
+    #endif
+  }
 
-  for (int i = nextTested; i < Enum::UNKNOWN; ++i) {
-    SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(i);
-    const String new_str_prefix   = SystemVariables::toString(enumval).substring(0, 2);
+  switch (token.enumval) {
+    case Enum::SUNRISE: return node_time.getSunriseTimeString(':', token.param);
+    case Enum::SUNSET:  return node_time.getSunsetTimeString(':', token.param);
+    case Enum::UNKNOWN: return EMPTY_STRING;
+    default:
+      break;
+  }
+  return getSystemVariable(token.enumval);
+}
 
-    if ((str_prefix == new_str_prefix) && !str_prefix_exists) {
-      // Just continue
-    } else {
-      str_prefix        = new_str_prefix;
-      str_prefix_exists = str.indexOf(str_prefix) != -1;
+void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
+{
+  START_TIMER
+
+  int startpos = s.indexOf('%');
+
+  if (startpos == -1) {
+    STOP_TIMER(PARSE_SYSVAR_NOCHANGE);
+    return;
+  }
+
+  // Walk the string once, looking up every %...% token.
+  // The result is only constructed when the first replacement is found.
+  String newString;
+  bool   replaced   = false;
+  int    copiedUpTo = 0;
 
-      if (str_prefix_exists) {
-        if (str.indexOf(SystemVariables::toString(enumval)) != -1) {
-          return enumval;
-        }
+  while (startpos != -1) {
+    const int endpos = s.indexOf('%', startpos + 1);
+
+    if (endpos == -1) {
+      break;
+    }
+    Token token;
+
+    if (parseToken(s.c_str() + startpos + 1, endpos - startpos - 1, token)) {
+      const String value = getTokenValue(token);
+
+      if (!replaced) {
+        newString.reserve(s.length() + value.length());
+        replaced = true;
+      }
+      appendSubstring(newString, s, copiedUpTo, startpos);
+
+      if (useURLencode) {
+        newString += URLEncode(value);
+      } else {
+        newString += value;
       }
+      copiedUpTo = endpos + 1;
+      startpos   = s.indexOf('%', copiedUpTo);
+    } else {
+      // The closing '%' may be the start of the next token, like in "100%%sysname%"
+      startpos = endpos;
     }
   }
 
+  if (!replaced) {
+    STOP_TIMER(PARSE_SYSVAR_NOCHANGE);
+    return;
+  }
+  appendSubstring(newString, s, copiedUpTo, s.length());
+  s = std::move(newString);
+
+  STOP_TIMER(PARSE_SYSVAR);
+}
+
+SystemVariables::Enum SystemVariables::findByName(const char *name, size_t length)
+{
+  const uint8_t *sorted = getSystemVariablesSortedByName();
+  int low               = 0;
+  int high              = Enum::UNKNOWN - 1;
+
+  while (low <= high) {
+    const int mid                 = (low + high) / 2;
+    const SystemVariables::Enum e = static_cast<SystemVariables::Enum>(sorted[mid]);
+    const int cmp                 = compareSystemVariableName(name, length, toFlashString(e));
+
+    if (cmp == 0) {
+      return e;
+    }
+
+    if (cmp < 0) {
+      high = mid - 1;
+    } else {
+      low = mid + 1;
+    }
+  }
   return Enum::UNKNOWN;
 }
 
@@ -115,17 +115,53 @@ public:
     UNKNOWN
   };
 
-  // Find the next thing to replace.
-  // Return UNKNOWN when nothing needs to be replaced.
-  static SystemVariables::Enum nextReplacementEnum(const String& str, SystemVariables::Enum last_tested);
+  // Find the system variable by its name, excluding the '%' characters.
+  // The name is case sensitive and does not need to be null terminated.
+  // Return UNKNOWN when not found.
+  static SystemVariables::Enum findByName(const char *name, size_t length);
+
+  // A %...% token found in a string, for example "%sysname%", "%sunrise-1h%" or "%v12%"
+  struct Token {
+    SystemVariables::Enum enumval = UNKNOWN;
+    int32_t               param   = 0;     // Offset in seconds for SUNRISE/SUNSET, variable nr for custom float vars
+    bool                  isCustomFloatVar = false;
+  };
+
+  // Parse the token name, excluding the '%' characters.
+  // Return false when it is not a system variable.
+  static bool parseToken(const char *name, size_t length, SystemVariables::Token& token);
+
+  static String getTokenValue(const SystemVariables::Token& token);
 
   static String toString(SystemVariables::Enum enumval);
   static const __FlashStringHelper * toFlashString(SystemVariables::Enum enumval);
 
+  // How long a computed value of a system variable remains valid.
+  enum class Volatility : uint8_t {
+    Static,    // Does not change until reboot or a settings change
+    Network,   // Only changes when the network (dis)connects or gets a new IP
+    PerSecond, // Changes at most once per second
+    PerCall    // Must be computed on every call, or is too cheap to cache
+  };
+
+  static SystemVariables::Volatility getVolatility(SystemVariables::Enum enumval);
+
+  // Served from a small cache when the value is not of Volatility::PerCall and
+  // still valid, see FEATURE_SYSVAR_CACHE.
   static String getSystemVariable(SystemVariables::Enum enumval);
 
+  // Invalidate cached values of Volatility::Network
+  static void markNetworkChanged();
+
+  // Invalidate all cached values
+  static void clearCache();
+
   static void parseSystemVariables(String& s, boolean useURLencode);
 
+private:
+
+  static String computeSystemVariable(SystemVariables::Enum enumval);
+
 };
 
 
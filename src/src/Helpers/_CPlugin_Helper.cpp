@@ -30,6 +30,9 @@
 #include <WiFiClient.h>
 #include <WiFiUdp.h>
 
+#include <memory>
+#include <new>
+
 
 bool safeReadStringUntil(Stream     & input,
                          String     & str,
@@ -222,6 +225,58 @@ bool client_available(WiFiClient& client) {
   return (client.available() != 0) || (client.connected() != 0);
 }
 
+// Connection kept open between sending messages of a controller to the same host.
+struct ControllerHTTPConnection {
+  WiFiClient    client;
+  HTTPClient    http;
+  String        host;
+  uint16_t      port     = 0;
+  unsigned long lastUsed = 0;
+};
+
+static std::unique_ptr<ControllerHTTPConnection> controllerHTTPConnections[CONTROLLER_MAX];
+
+static ControllerHTTPConnection* getControllerHTTPConnection(controllerIndex_t controller_idx,
+                                                             const String    & host,
+                                                             uint16_t          port) {
+  if (!validControllerIndex(controller_idx)) {
+    return nullptr;
+  }
+  std::unique_ptr<ControllerHTTPConnection>& connection = controllerHTTPConnections[controller_idx];
+
+  if (!connection) {
+    connection.reset(new (std::nothrow) ControllerHTTPConnection);
+
+    if (!connection) {
+      return nullptr;
+    }
+  }
+
+  if ((connection->port != port) || !connection->host.equals(host) ||
+      (timePassedSince(connection->lastUsed) > HTTP_KEEP_ALIVE_IDLE_TIMEOUT)) {
+    // Do not reuse a connection to another host or one which may already have been closed by the server.
+    connection->client.stop();
+    connection->host = host;
+    connection->port = port;
+  }
+  return connection.get();
+}
+
+void closeIdleControllerHTTPConnections(bool closeAll) {
+  for (controllerIndex_t i = 0; i < CONTROLLER_MAX; ++i) {
+    std::unique_ptr<ControllerHTTPConnection>& connection = controllerHTTPConnections[i];
+
+    if (connection) {
+      if (closeAll ||
+          !connection->client.connected() ||
+          (timePassedSince(connection->lastUsed) > HTTP_KEEP_ALIVE_IDLE_TIMEOUT)) {
+        connection->client.stop();
+        connection.reset();
+      }
+    }
+  }
+}
+
 String send_via_http(int                             controller_number,
                      const ControllerSettingsStruct& ControllerSettings,
                      controllerIndex_t               controller_idx,
@@ -239,20 +294,49 @@ String send_via_http(int                             controller_number,
     ? WiFiEventData.getSuggestedTimeout(controller_number, ControllerSettings.ClientTimeout)
     : ControllerSettings.ClientTimeout;
 
+  const String host = ControllerSettings.getHost();
+
+  // Keep the connection open when the reply is checked, as the reply must be read completely to reuse it.
+  ControllerHTTPConnection *connection = ControllerSettings.MustCheckReply
+    ? getControllerHTTPConnection(controller_idx, host, ControllerSettings.Port)
+    : nullptr;
+
   const unsigned long connect_start_time = millis();
-  const String result = send_via_http(
-    get_formatted_Controller_number(controller_number),
-    timeout,
-    getControllerUser(controller_idx, ControllerSettings),
-    getControllerPass(controller_idx, ControllerSettings),
-    ControllerSettings.getHost(),
-    ControllerSettings.Port,
-    uri,
-    HttpMethod,
-    header,
-    postStr,
-    httpCode,
-    ControllerSettings.MustCheckReply);
+  String result;
+
+  if (connection != nullptr) {
+    result = send_via_http(
+      get_formatted_Controller_number(controller_number),
+      connection->client,
+      connection->http,
+      timeout,
+      getControllerUser(controller_idx, ControllerSettings),
+      getControllerPass(controller_idx, ControllerSettings),
+      host,
+      ControllerSettings.Port,
+      uri,
+      HttpMethod,
+      header,
+      postStr,
+      httpCode,
+      ControllerSettings.MustCheckReply,
+      true);
+    connection->lastUsed = millis();
+  } else {
+    result = send_via_http(
+      get_formatted_Controller_number(controller_number),
+      timeout,
+      getControllerUser(controller_idx, ControllerSettings),
+      getControllerPass(controller_idx, ControllerSettings),
+      host,
+      ControllerSettings.Port,
+      uri,
+      HttpMethod,
+      header,
+      postStr,
+      httpCode,
+      ControllerSettings.MustCheckReply);
+  }
 
   // FIXME TD-er: Shouldn't this be: success = (httpCode >= 100) && (httpCode < 300)
   // or is reachability of the host the important factor here?
@@ -62,6 +62,15 @@ String send_via_http(int                             controller_number,
                      const String                  & header,
                      const String                  & postStr,
                      int                           & httpCode);
+
+// Idle time in msec after which a kept-alive HTTP connection of a controller is closed.
+#ifndef HTTP_KEEP_ALIVE_IDLE_TIMEOUT
+# define HTTP_KEEP_ALIVE_IDLE_TIMEOUT  10000
+#endif // ifndef HTTP_KEEP_ALIVE_IDLE_TIMEOUT
+
+// Close the kept-alive HTTP connections of controllers which have been idle for too long,
+// or all of them when closeAll is set.
+void closeIdleControllerHTTPConnections(bool closeAll = false);
 #endif // FEATURE_HTTP_CLIENT
                      
 
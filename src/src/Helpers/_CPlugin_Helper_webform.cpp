@@ -2,6 +2,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../ControllerQueue/ControllerQueueSpillStruct.h"
 #include "../DataStructs/ESPEasy_EventStruct.h"
 #include "../DataTypes/ESPEasy_plugin_functions.h"
 #include "../Globals/CPlugins.h"
@@ -51,6 +52,15 @@ const __FlashStringHelper * toString(ControllerSettingsStruct::VarType parameter
     case ControllerSettingsStruct::CONTROLLER_SEND_BINARY:              return  F("Send Binary");            
     case ControllerSettingsStruct::CONTROLLER_TIMEOUT:                  return  F("Client Timeout");         
     case ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR:     return  F("Sample Set Initiator");   
+    case ControllerSettingsStruct::CONTROLLER_BATCH_PUBLISH:            return  F("Batch Publish");
+    case ControllerSettingsStruct::CONTROLLER_AGGREGATE_VALUES:         return  F("Aggregate Values");
+    case ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH:           return  F("Spill Queue to Flash");
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL:   return  F("Adaptive Send Interval");
+    case ControllerSettingsStruct::CONTROLLER_BATCH_FRAMING:            return  F("Batch Framing");
+    case ControllerSettingsStruct::CONTROLLER_BATCH_MAX_SIZE:           return  F("Batch Max Size");
+    case ControllerSettingsStruct::CONTROLLER_BATCH_MAX_AGE:            return  F("Batch Max Age");
+    case ControllerSettingsStruct::CONTROLLER_IGNORE_SEND_ON_CHANGE:    return  F("Ignore Send On Change");
+    case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_SIZE:           return  F("Max Queue Size");
 
     case ControllerSettingsStruct::CONTROLLER_ENABLED:
 
@@ -210,6 +220,30 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:
       addFormCheckBox(displayName, internalName, ControllerSettings.deduplicate());
       break;
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL:
+    {
+      addFormCheckBox(displayName, internalName, ControllerSettings.adaptiveSendInterval());
+      String note = F("Start at Minimum Send Interval, shorten by ");
+      note += CONTROLLER_DELAY_QUEUE_ADAPTIVE_STEP;
+      note += F(" ms after each sent message, double after each failure (");
+      note += CONTROLLER_DELAY_QUEUE_ADAPTIVE_MIN;
+      note += F(" ... ");
+      note += CONTROLLER_DELAY_QUEUE_ADAPTIVE_MAX;
+      note += F(" ms)");
+      addFormNote(note);
+      break;
+    }
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+    case ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH:
+    {
+      addFormCheckBox(displayName, internalName, ControllerSettings.spillToFlash());
+      String note = F("Store messages on the file system when the queue is full, max. ");
+      note += CONTROLLER_QUEUE_SPILL_MAX_SIZE / 1024;
+      note += F(" kB");
+      addFormNote(note);
+      break;
+    }
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       addFormCheckBox(displayName, internalName, ControllerSettings.useLocalSystemTime());
       break;      
@@ -231,6 +265,19 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_retainFlag());
       break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_PUBLISH:
+    {
+      addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_batchPublish());
+      String note = F("Publish up to ");
+      note += CONTROLLER_DELAY_QUEUE_BATCH_SIZE;
+      note += F(" queued messages per run of the queue");
+      addFormNote(note);
+      break;
+    }
+    case ControllerSettingsStruct::CONTROLLER_AGGREGATE_VALUES:
+      addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_aggregateValues());
+      addFormNote(F("Publish all values of a task as one JSON object, %valname% is removed from the topic"));
+      break;
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       addFormTextBox(displayName, internalName, ControllerSettings.Subscribe,            sizeof(ControllerSettings.Subscribe) - 1);
       break;
@@ -268,6 +315,41 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
     case ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR:
       addTaskSelectBox(displayName, internalName, ControllerSettings.SampleSetInitiator);
       break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_FRAMING:
+    {
+      const __FlashStringHelper * options[3] = {
+        F("Off"),
+        F("Lines"),
+        F("JSON Array")
+      };
+      const int optionValues[3] = {
+        static_cast<int>(ControllerSettingsStruct::BatchFraming_e::None),
+        static_cast<int>(ControllerSettingsStruct::BatchFraming_e::Lines),
+        static_cast<int>(ControllerSettingsStruct::BatchFraming_e::JSONArray)
+      };
+      addFormSelector(displayName, internalName, 3, options, optionValues, static_cast<int>(ControllerSettings.batchFraming()));
+      addFormNote(F("Combine queued messages with the same URI and header into a single request body"));
+      break;
+    }
+    case ControllerSettingsStruct::CONTROLLER_BATCH_MAX_SIZE:
+      addFormNumericBox(displayName, internalName, ControllerSettings.getBatchMaxSize(), 64, CONTROLLER_BATCH_MAX_SIZE_MAX);
+      addUnit(F("bytes"));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_MAX_AGE:
+      addFormNumericBox(displayName, internalName, ControllerSettings.getBatchMaxAge(), 10, CONTROLLER_BATCH_MAX_AGE_MAX);
+      addUnit(F("ms"));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_SIZE:
+      addFormNumericBox(displayName, internalName, ControllerSettings.getMaxQueueSize(), 0, CONTROLLER_DELAY_QUEUE_MAX_BYTES_MAX);
+      addUnit(F("bytes"));
+      addFormNote(F("Max. memory used by the queued messages, 0 = only limit the number of messages"));
+      break;
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+    case ControllerSettingsStruct::CONTROLLER_IGNORE_SEND_ON_CHANGE:
+      addFormCheckBox(displayName, internalName, ControllerSettings.ignoreSendOnChange());
+      addFormNote(F("Receive all task values, also when not changed more than the deadband set in the task"));
+      break;
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
     case ControllerSettingsStruct::CONTROLLER_ENABLED:
       addFormCheckBox(displayName, internalName, Settings.ControllerEnabled[controllerindex]);
       break;
@@ -341,6 +423,9 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_DEDUPLICATE:
       ControllerSettings.deduplicate(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL:
+      ControllerSettings.adaptiveSendInterval(isFormItemChecked(internalName));
+      break;
     case ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME:
       ControllerSettings.useLocalSystemTime(isFormItemChecked(internalName));
       break;
@@ -356,6 +441,17 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       ControllerSettings.mqtt_retainFlag(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_PUBLISH:
+      ControllerSettings.mqtt_batchPublish(isFormItemChecked(internalName));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_AGGREGATE_VALUES:
+      ControllerSettings.mqtt_aggregateValues(isFormItemChecked(internalName));
+      break;
+#if FEATURE_CONTROLLER_QUEUE_SPILL
+    case ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH:
+      ControllerSettings.spillToFlash(isFormItemChecked(internalName));
+      break;
+#endif // if FEATURE_CONTROLLER_QUEUE_SPILL
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       strncpy_webserver_arg(ControllerSettings.Subscribe,            internalName);
       break;
@@ -392,6 +488,24 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_SAMPLE_SET_INITIATOR:
       ControllerSettings.SampleSetInitiator = getFormItemInt(internalName, ControllerSettings.SampleSetInitiator);
       break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_FRAMING:
+      ControllerSettings.batchFraming(static_cast<ControllerSettingsStruct::BatchFraming_e>(
+                                        getFormItemInt(internalName, static_cast<int>(ControllerSettings.batchFraming()))));
+      break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_MAX_SIZE:
+      ControllerSettings.BatchMaxSize = getFormItemInt(internalName, ControllerSettings.BatchMaxSize);
+      break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_MAX_AGE:
+      ControllerSettings.BatchMaxAge = getFormItemInt(internalName, ControllerSettings.BatchMaxAge);
+      break;
+    case ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_SIZE:
+      ControllerSettings.MaxQueueSize = getFormItemInt(internalName, ControllerSettings.MaxQueueSize);
+      break;
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+    case ControllerSettingsStruct::CONTROLLER_IGNORE_SEND_ON_CHANGE:
+      ControllerSettings.ignoreSendOnChange(isFormItemChecked(internalName));
+      break;
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
     case ControllerSettingsStruct::CONTROLLER_ENABLED:
       Settings.ControllerEnabled[controllerindex] = isFormItemChecked(internalName);
       break;
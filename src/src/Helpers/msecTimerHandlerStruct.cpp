@@ -32,7 +32,7 @@
   unsigned long msecTimerHandlerStruct::getNextId(unsigned long& timer) {
     ++get_called;
 
-    if (_timer_ids.empty()) {
+    if (_timer_heap.empty()) {
       recordIdle();
 
       if (eco_mode) {
@@ -40,8 +40,8 @@
       }
       return 0;
     }
-    timer_id_couple item = _timer_ids.front();
-    const long passed    = timePassedSince(item._timer);
+    const timer_heap_element& item = _timer_heap.front();
+    const long passed              = timePassedSince(item._timer);
 
     if (passed < 0) {
       // No timeOutReached
@@ -61,24 +61,26 @@
       return 0;
     }
     recordRunning();
-    unsigned long size = _timer_ids.size();
+    unsigned long size = _timer_heap.size();
 
     if (size > max_queue_length) { max_queue_length = size; }
-    _timer_ids.pop_front();
+    const unsigned long id = item._index->first;
+
     timer = item._timer;
+    removeAt(0);
     ++get_called_ret_id;
-    return item._id;
+    return id;
   }
 
 
   bool msecTimerHandlerStruct::getTimerForId(unsigned long id, unsigned long& timer) const {
-    for (auto it = _timer_ids.begin(); it != _timer_ids.end(); ++it) {
-      if (it->_id == id) {
-        timer = it->_timer;
-        return true;
-      }
+    auto it = _timer_index.find(id);
+
+    if (it == _timer_index.end()) {
+      return false;
     }
-    return false;
+    timer = _timer_heap[it->second]._timer;
+    return true;
   }
 
   String msecTimerHandlerStruct::getQueueStats() {
@@ -110,38 +112,107 @@
     return idle_time_pct;
   }
 
-  struct match_id {
-    match_id(unsigned long id) : _id(id) {}
+  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+    if (item._id == 0) { return; }
 
-    bool operator()(const timer_id_couple& item) {
-      return _id == item._id;
+    // Make sure only one is present with the same id.
+    auto it = _timer_index.find(item._id);
+
+    if (it != _timer_index.end()) {
+      // Already present, update the timer and restore the heap order.
+      const size_t pos = it->second;
+      _timer_heap[pos]._timer    = item._timer;
+      _timer_heap[pos]._sequence = ++_sequence;
+      siftUp(pos);
+      siftDown(it->second);
+      return;
     }
 
-    unsigned long _id;
-  };
+    it = _timer_index.emplace(item._id, _timer_heap.size()).first;
+    _timer_heap.push_back({ item._timer, ++_sequence, it });
+    siftUp(_timer_heap.size() - 1);
+  }
 
-  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
     if (item._id == 0) { return; }
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
-    const bool mustSort = !_timer_ids.empty();
-    _timer_ids.push_front(item);
+    auto it = _timer_index.find(item._id);
 
-    if (mustSort) {
-      _timer_ids.sort(); // TD-er: Must check if this is an expensive operation.
+    if (it != _timer_index.end()) {
+      removeAt(it->second);
     }
+  }
+
+  bool msecTimerHandlerStruct::isEarlier(const timer_heap_element& a, const timer_heap_element& b) {
+    const int32_t diff = timeDiff(b._timer, a._timer);
 
-    // It should be a relative light operation, to insert into a sorted list.
-    // Perhaps it is better to use std::set ????
-    // Keep in mind: order is based on timer, uniqueness is based on id.
+    if (diff != 0) {
+      return diff < 0;
+    }
+
+    // Same timer, the last one set is handled first.
+    return timeDiff(b._sequence, a._sequence) > 0;
   }
 
-  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  void msecTimerHandlerStruct::removeAt(size_t pos) {
+    const size_t last = _timer_heap.size() - 1;
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
+    // Move the element to the back first, as swapping updates the index
+    // of both elements. Only erase its index entry once it is no longer used.
+    if (pos != last) {
+      swapElements(pos, last);
+    }
+    const TimerIndexMap::iterator index = _timer_heap.back()._index;
+
+    _timer_heap.pop_back();
+    _timer_index.erase(index);
+
+    if (pos < _timer_heap.size()) {
+      siftUp(pos);
+      siftDown(_timer_heap[pos]._index->second);
+    }
+  }
+
+  void msecTimerHandlerStruct::siftUp(size_t pos) {
+    while (pos > 0) {
+      const size_t parent = (pos - 1) / 2;
+
+      if (!isEarlier(_timer_heap[pos], _timer_heap[parent])) {
+        return;
+      }
+      swapElements(pos, parent);
+      pos = parent;
+    }
+  }
+
+  void msecTimerHandlerStruct::siftDown(size_t pos) {
+    const size_t size = _timer_heap.size();
+
+    while (true) {
+      const size_t left  = 2 * pos + 1;
+      const size_t right = left + 1;
+      size_t earliest    = pos;
+
+      if ((left < size) && isEarlier(_timer_heap[left], _timer_heap[earliest])) {
+        earliest = left;
+      }
+
+      if ((right < size) && isEarlier(_timer_heap[right], _timer_heap[earliest])) {
+        earliest = right;
+      }
+
+      if (earliest == pos) {
+        return;
+      }
+      swapElements(pos, earliest);
+      pos = earliest;
+    }
+  }
+
+  void msecTimerHandlerStruct::swapElements(size_t a, size_t b) {
+    std::swap(_timer_heap[a], _timer_heap[b]);
+    _timer_heap[a]._index->second = a;
+    _timer_heap[b]._index->second = b;
   }
 
   void msecTimerHandlerStruct::recordIdle() {
@@ -3,7 +3,8 @@
 
 
 #include "../../ESPEasy_common.h"
-#include <list>
+#include <map>
+#include <vector>
 
 #include "../DataStructs/timer_id_couple.h"
 
@@ -35,10 +36,34 @@ struct msecTimerHandlerStruct {
 
 private:
 
+  // Index of all set timers, to find the position in the heap for a given id.
+  typedef std::map<unsigned long, size_t> TimerIndexMap;
+
+  struct timer_heap_element {
+    unsigned long          _timer;
+
+    // Timers set at the same moment are handled in reverse order of insertion.
+    uint32_t               _sequence;
+    TimerIndexMap::iterator _index;
+  };
+
   void insert(const timer_id_couple& item);
 
   void remove(const timer_id_couple& item);
 
+  // Return true when a must be handled before b
+  static bool isEarlier(const timer_heap_element& a,
+                        const timer_heap_element& b);
+
+  void removeAt(size_t pos);
+
+  void siftUp(size_t pos);
+
+  void siftDown(size_t pos);
+
+  void swapElements(size_t a,
+                    size_t b);
+
   void recordIdle();
 
   void recordRunning();
@@ -56,8 +81,10 @@ private:
   bool          is_idle;
   bool          eco_mode;
 
-  // The list of set timers
-  std::list<timer_id_couple>_timer_ids;
+  // The set timers, as binary min-heap ordered on their timer.
+  std::vector<timer_heap_element>_timer_heap;
+  TimerIndexMap                  _timer_index;
+  uint32_t                       _sequence = 0;
 };
 
 #endif // HELPERS_MSECTIMERHANDLERSTRUCT_H
@@ -110,8 +110,8 @@ void P012_data_struct::lcdWrite(const String& text, uint8_t col, uint8_t row) {
 
 // Perform some specific changes for LCD display
 // https://www.letscontrolit.com/forum/viewtopic.php?t=2368
-String P012_data_struct::P012_parseTemplate(String& tmpString, uint8_t lineSize) {
-  String result            = parseTemplate_padded(tmpString, lineSize);
+String P012_data_struct::P012_parseTemplate(String& tmpString, uint8_t lineSize, taskIndex_t taskIndex) {
+  String result            = parseTemplate_compiled(taskIndex, tmpString, lineSize);
   const char degree[3]     = { 0xc2, 0xb0, 0 }; // Unicode degree symbol
   const char degree_lcd[2] = { 0xdf, 0 };       // P012_LCD degree symbol
 
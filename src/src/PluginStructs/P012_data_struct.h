@@ -25,8 +25,10 @@ struct P012_data_struct : public PluginTaskData_base {
                 uint8_t       col,
                 uint8_t       row);
 
-  String P012_parseTemplate(String& tmpString,
-                            uint8_t lineSize);
+  // When taskIndex is valid, a compiled version of the template is kept in the task cache.
+  String P012_parseTemplate(String    & tmpString,
+                            uint8_t     lineSize,
+                            taskIndex_t taskIndex = INVALID_TASK_INDEX);
 
   void   createCustomChars();
 
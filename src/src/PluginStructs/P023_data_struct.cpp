@@ -232,8 +232,8 @@ void P023_data_struct::checkDisplayTimer() {
 }
 
 // Perform some specific changes for OLED display
-String P023_data_struct::parseTemplate(String& tmpString, uint8_t lineSize) {
-  String result             = parseTemplate_padded(tmpString, lineSize);
+String P023_data_struct::parseTemplate(String& tmpString, uint8_t lineSize, taskIndex_t taskIndex) {
+  String result             = parseTemplate_compiled(taskIndex, tmpString, lineSize);
   const char degree[3]      = { 0xc2, 0xb0, 0 }; // Unicode degree symbol
   const char degree_oled[2] = { 0x7F, 0 };       // P023_OLED degree symbol
 
@@ -262,7 +262,7 @@ void P023_data_struct::StartUp_OLED(struct EventStruct *event) {
 
 bool P023_data_struct::plugin_read(struct EventStruct *event) {
   for (uint8_t x = 0; x < 8; x++) {
-    String newString = parseTemplate(strings[x], 16);
+    String newString = parseTemplate(strings[x], 16, event->TaskIndex);
 
     if (strings[x].length()) {
       sendStrXY(newString.c_str(), x, 0);
@@ -34,8 +34,10 @@ struct P023_data_struct : public PluginTaskData_base {
   void   setDisplayTimer(uint8_t _displayTimer);
   void   checkDisplayTimer();
 
-  String parseTemplate(String& tmpString,
-                       uint8_t lineSize);
+  // When taskIndex is valid, a compiled version of the template is kept in the task cache.
+  String parseTemplate(String    & tmpString,
+                       uint8_t     lineSize,
+                       taskIndex_t taskIndex = INVALID_TASK_INDEX);
 
   void   resetDisplay();
 
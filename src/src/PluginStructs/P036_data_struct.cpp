@@ -184,6 +184,7 @@ bool P036_data_struct::init(taskIndex_t      taskIndex,
                             uint8_t          NrLines) {
   reset();
 
+  displayTaskIndex    = taskIndex;
   lastWiFiState       = P36_WIFI_STATE_UNSET;
   disp_resolution     = Disp_resolution;
   bAlternativHeader   = false; // start with first header content
@@ -1758,7 +1759,7 @@ String P036_data_struct::P36_parseTemplate(String& tmpString, uint8_t lineIdx) {
   if (tmpString.length() == 0) {
     return EMPTY_STRING;
   }
-  String result = parseTemplate_padded(tmpString, 20);
+  String result = parseTemplate_compiled(displayTaskIndex, tmpString, 20);
 
   result.trim();
 
@@ -466,6 +466,9 @@ struct P036_data_struct : public PluginTaskData_base {
   // CustomTaskSettings
   P036_LineContent *LineContent = nullptr;
 
+  // Task of this display, to keep compiled versions of the display lines in its task cache
+  taskIndex_t displayTaskIndex = INVALID_TASK_INDEX;
+
   int8_t lastWiFiState   = 0;
   bool   bDisplayingLogo = false;
 
@@ -15,16 +15,7 @@
 P037_data_struct::P037_data_struct(taskIndex_t taskIndex) : _taskIndex(taskIndex)
 {}
 
-P037_data_struct::~P037_data_struct() {
-  # if P037_JSON_SUPPORT
-
-  if (nullptr != root) {
-    root->clear();
-    delete root;
-    root = nullptr;
-  }
-  # endif // if P037_JSON_SUPPORT
-}
+P037_data_struct::~P037_data_struct() {}
 
 /**
  * Load the settings from file
@@ -936,51 +927,53 @@ bool P037_data_struct::checkFilters(const String& key, const String& value, int8
 # ifdef P037_JSON_SUPPORT
 
 /**
- * Allocate a DynamicJsonDocument and parse the message.
- * Returns true if the operation succeeded, and doc and iter can be used, when n ot successful the state of those variables is undefined.
+ * Start reading the message and extract the values of the configured JSON attributes.
+ * Returns true if the message is a JSON object.
+ * No document is allocated, the attributes are read directly from the message.
  */
 bool P037_data_struct::parseJSONMessage(const String& message) {
-  bool result = false;
-
-  if ((nullptr != root) &&
-      (message.length() * 1.5 > lastJsonMessageLength)) {
-    cleanupJSON();
+  if (!_jsonReader.begin(message)) {
+    return false;
   }
+  String keys[VARS_PER_TASK];
 
-  if (message.length() * 1.5 > lastJsonMessageLength) {
-    lastJsonMessageLength = message.length() * 1.5;
-    #  ifdef PLUGIN_037_DEBUG
-
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      addLogMove(LOG_LEVEL_INFO, concat(F("IMPT : JSON buffer increased to "), (int)lastJsonMessageLength));
+  for (uint8_t x = 0; x < VARS_PER_TASK; x++) {
+    if (!mqttTopics[x].isEmpty()) {
+      keys[x] = parseStringKeepCase(jsonAttributes[x], 1, ';');
+      keys[x].trim();
     }
-    #  endif // ifdef PLUGIN_037_DEBUG
   }
+  _jsonReader.extract(keys, _jsonValues, VARS_PER_TASK);
+  return true;
+}
 
-  if (nullptr == root) {
-    root = new (std::nothrow) DynamicJsonDocument(lastJsonMessageLength); // Dynamic allocation
-  }
+bool P037_data_struct::nextJSONAttribute(String& key, String& value) {
+  return _jsonReader.next(key, value);
+}
 
-  if (nullptr != root) {
-    deserializeJson(*root, message);
+bool P037_data_struct::jsonAtEnd() const {
+  return _jsonReader.atEnd();
+}
 
-    if (!root->isNull()) {
-      result = true;
-      doc    = root->as<JsonObject>();
-      iter   = doc.begin();
-    }
+void P037_data_struct::rewindJSON() {
+  _jsonReader.rewind();
+}
+
+const String& P037_data_struct::getJSONAttributeValue(uint8_t taskValueIndex) const {
+  if (taskValueIndex < VARS_PER_TASK) {
+    return _jsonValues[taskValueIndex];
   }
-  return result;
+  return EMPTY_STRING;
 }
 
 /**
- * Release the created DynamicJsonDocument (if it was allocated)
+ * Release the values extracted from the last message
  */
 void P037_data_struct::cleanupJSON() {
-  if (nullptr != root) {
-    root->clear();
-    delete root;
-    root = nullptr;
+  _jsonReader.end();
+
+  for (uint8_t x = 0; x < VARS_PER_TASK; x++) {
+    _jsonValues[x].clear();
   }
 }
 
@@ -7,12 +7,11 @@
 # include "../CustomBuild/StorageLayout.h"
 # include "../Globals/EventQueue.h"
 # include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/JSON_ObjectReader.h"
 # include "../Helpers/Misc.h"
 # include "../Helpers/StringParser.h"
 # include "../Globals/MQTT.h"
 
-# include <ArduinoJson.h>
-
 // # define PLUGIN_037_DEBUG     // Additional debugging information
 
 # if defined(PLUGIN_BUILD_CUSTOM) || defined(PLUGIN_BUILD_MAX_ESP32) \
@@ -159,10 +158,20 @@ struct P037_data_struct : public PluginTaskData_base
 
 
   # if P037_JSON_SUPPORT
-  bool parseJSONMessage(const String& message);
-  void cleanupJSON();
-  JsonObject           doc;
-  JsonObject::iterator iter;
+
+  // Start reading the JSON message, which must be kept unchanged until cleanupJSON() is called.
+  // The values of the configured JSON attributes are extracted in a single pass over the message.
+  bool          parseJSONMessage(const String& message);
+  void          cleanupJSON();
+
+  // Iterate over all attributes of the JSON message.
+  bool          nextJSONAttribute(String& key,
+                                  String& value);
+  bool          jsonAtEnd() const;
+  void          rewindJSON();
+
+  // Value of the JSON attribute configured for the task value, "null" when not present in the message.
+  const String& getJSONAttributeValue(uint8_t taskValueIndex) const;
   # endif // if P037_JSON_SUPPORT
 
   // The settings structures
@@ -195,8 +204,8 @@ private:
   String _filterListItem;
   # endif // if P037_FILTER_SUPPORT
   # if P037_JSON_SUPPORT
-  DynamicJsonDocument *root                  = nullptr;
-  uint16_t             lastJsonMessageLength = 512;
+  JSON_ObjectReader _jsonReader;
+  String            _jsonValues[VARS_PER_TASK];
   # endif // if P037_JSON_SUPPORT
 };
 
@@ -354,7 +354,12 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
           if (proto.usesQueue) {
             addTableSeparator(F("Controller Queue"), 2, 3);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MIN_SEND_INTERVAL);
+
+            if (!proto.usesMQTT) {
+              addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ADAPTIVE_SEND_INTERVAL);
+            }
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_DEPTH);
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_QUEUE_SIZE);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MAX_RETRIES);
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION);
 
@@ -362,6 +367,12 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
               addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_ALLOW_EXPIRE);
             }
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_DEDUPLICATE);
+      # if FEATURE_CONTROLLER_QUEUE_SPILL
+
+            if (proto.allowsSpillToFlash) {
+              addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_SPILL_TO_FLASH);
+            }
+      # endif // if FEATURE_CONTROLLER_QUEUE_SPILL
           }
 
           if (proto.usesCheckReply) {
@@ -378,6 +389,9 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
           if (proto.allowLocalSystemTime) {
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_USE_LOCAL_SYSTEM_TIME);
           }
+      # if FEATURE_TASKVALUE_SEND_ON_CHANGE
+          addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_IGNORE_SEND_ON_CHANGE);
+      # endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
 
 
           if (proto.useCredentials()) {
@@ -407,6 +421,11 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
             addHtml(getMQTTclientID(*ControllerSettings));
             addFormNote(F("Updated on load of this page"));
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_RETAINFLAG);
+            addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_BATCH_PUBLISH);
+
+            if (proto.allowsAggregateValues) {
+              addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_AGGREGATE_VALUES);
+            }
           }
           # endif // if FEATURE_MQTT
 
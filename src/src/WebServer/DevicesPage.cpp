@@ -15,6 +15,7 @@
 # include "../Globals/ExtraTaskSettings.h"
 # include "../Globals/Nodes.h"
 # include "../Globals/Plugins.h"
+# include "../Globals/SendDataFilter.h"
 
 # include "../Static/WebStaticData.h"
 
@@ -384,7 +385,20 @@ void handle_devices_CopySubmittedSettings(taskIndex_t taskIndex, pluginID_t task
 #if FEATURE_PLUGIN_STATS
     ExtraTaskSettings.enablePluginStats(varNr, isFormItemChecked(getPluginCustomArgName(F("TDS"), varNr)));
 #endif
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+    if (device.SendDataOption) {
+      ExtraTaskSettings.sendOnChange(varNr, isFormItemChecked(getPluginCustomArgName(F("TDSOC"), varNr)));
+      ExtraTaskSettings.TaskDeviceDeadband[varNr] = getFormItemFloat(getPluginCustomArgName(F("TDDB"), varNr));
+    }
+#endif
+  }
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+  if (device.SendDataOption) {
+    ExtraTaskSettings.SendOnChangeMaxInterval = getFormItemInt(F("TDSOCMI"), ExtraTaskSettings.SendOnChangeMaxInterval);
   }
+  // Send the next values, using the new settings.
+  SendDataFilter.clear(taskIndex);
+#endif
   ExtraTaskSettings.clearUnusedValueNames(valueCount);
 
   // ExtraTaskSettings has changed.
@@ -1306,6 +1320,23 @@ void devicePage_show_controller_config(taskIndex_t taskIndex, deviceIndex_t Devi
       F("Unchecked: Send event per value. Checked: Send single event (%s#All) containing all values"),
       getTaskDeviceName(taskIndex).c_str()));
 
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+    addFormNumericBox(F("Send On Change Max Interval"), F("TDSOCMI"), // ="taskdevicesendonchangemaxinterval"
+                      Cache.getTaskSendOnChangeMaxInterval(taskIndex), 0, 65535);
+    addUnit(F("sec"));
+    {
+      String note = F("Max. time between sends when values with 'Send On Change' did not change more than their deadband (0 = no limit)");
+
+      const uint32_t suppressed = SendDataFilter.getSuppressedCountTask(taskIndex);
+
+      if (suppressed != 0) {
+        note += F(", suppressed sends: ");
+        note += suppressed;
+      }
+      addFormNote(note);
+    }
+#endif
+
     bool separatorAdded = false;
     for (controllerIndex_t controllerNr = 0; controllerNr < CONTROLLER_MAX; controllerNr++)
     {
@@ -1402,6 +1433,15 @@ void devicePage_show_task_values(taskIndex_t taskIndex, deviceIndex_t DeviceInde
       ++colCount;
     }
 
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+    if (device.SendDataOption)
+    {
+      html_table_header(F("Send On Change"), 30);
+      html_table_header(F("Deadband"), 100);
+      colCount += 2;
+    }
+#endif
+
     //placeholder header
     html_table_header(F(""));
     ++colCount;
@@ -1439,6 +1479,19 @@ void devicePage_show_task_values(taskIndex_t taskIndex, deviceIndex_t DeviceInde
         const String id = getPluginCustomArgName(F("TDVD"), varNr); // ="taskdevicevaluedecimals"
         addNumericBox(id, Cache.getTaskDeviceValueDecimals(taskIndex, varNr), 0, 6);
       }
+
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+      if (device.SendDataOption)
+      {
+        html_TD();
+        addCheckBox(getPluginCustomArgName(F("TDSOC"), varNr), // ="taskdevicesendonchange"
+                    bitRead(Cache.getTaskSendOnChange(taskIndex), varNr));
+        html_TD();
+        addFloatNumberBox(getPluginCustomArgName(F("TDDB"), varNr), // ="taskdevicedeadband"
+                          Cache.getTaskDeviceDeadband(taskIndex, varNr), 0.0f, 1000000.0f,
+                          Cache.getTaskDeviceValueDecimals(taskIndex, varNr));
+      }
+#endif
     }
     addFormSeparator(colCount);
   }
@@ -2,6 +2,7 @@
 
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../WebServer/JSON.h"
+#include "../WebServer/LoadFromFS.h"
 #include "../WebServer/Markup_Forms.h"
 
 #include "../CustomBuild/CompiletimeDefines.h"
@@ -13,8 +14,10 @@
 #include "../Globals/Device.h"
 #include "../Globals/Plugins.h"
 #include "../Globals/NPlugins.h"
+#include "../Globals/RuntimeData.h"
 
 #include "../Helpers/_Plugin_init.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Hardware.h"
@@ -103,6 +106,54 @@ void handle_csvval()
   TXBuffer.endStream();
 }
 
+// ********************************************************************************
+// ETag for JSON replies only containing task values and task settings.
+// Task values are not set via a single function, so use a checksum of the values themselves.
+// Plugins formatting their own values may use other state, so use the formatted values for those.
+// ********************************************************************************
+String json_taskValues_ETag(taskIndex_t firstTaskIndex, taskIndex_t lastTaskIndex)
+{
+  // Settings version starts at 0 after a reboot, so add some random value per boot.
+  static const uint32_t bootId = HwRandom();
+  uint32_t crc = 0xffffffff;
+
+  for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastTaskIndex && validTaskIndex(TaskIndex); ++TaskIndex) {
+    const TaskValues_Data_t *data = UserVar.getTaskValues_Data(TaskIndex);
+
+    if (data != nullptr) {
+      crc = calc_CRC32(data->binary, sizeof(data->binary), crc);
+    }
+
+    const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(TaskIndex);
+
+    if (validDeviceIndex(DeviceIndex) && Device[DeviceIndex].FormatUserVar) {
+      const uint8_t valueCount = getValueCountForTask(TaskIndex);
+
+      for (uint8_t x = 0; x < valueCount; ++x) {
+        const String value = formatUserVarNoCheck(TaskIndex, x);
+        // Include the terminating zero, to separate the values.
+        crc = calc_CRC32(reinterpret_cast<const uint8_t *>(value.c_str()), value.length() + 1, crc);
+      }
+    }
+
+    // Can be changed without saving the settings, e.g. via the TaskEnable command.
+    const uint8_t enabled = Settings.TaskDeviceEnabled[TaskIndex] ? 1 : 0;
+    crc = calc_CRC32(&enabled, sizeof(enabled), crc);
+    crc = calc_CRC32(reinterpret_cast<const uint8_t *>(&Settings.TaskDeviceTimer[TaskIndex]), sizeof(Settings.TaskDeviceTimer[TaskIndex]), crc);
+  }
+
+  String etag;
+
+  etag += '"';
+  etag += String(bootId, HEX);
+  etag += '-';
+  etag += Cache.settingsVersion;
+  etag += '-';
+  etag += String(crc, HEX);
+  etag += '"';
+  return etag;
+}
+
 // ********************************************************************************
 // Web Interface JSON page (no password!)
 // ********************************************************************************
@@ -111,6 +162,9 @@ void handle_json()
   START_TIMER
   const taskIndex_t taskNr    = getFormItemInt(F("tasknr"), INVALID_TASK_INDEX);
   const bool showSpecificTask = validTaskIndex(taskNr);
+
+  // Only replies without system information can be answered with "304 Not Modified"
+  bool onlyTaskInfo           = showSpecificTask;
   bool showSystem             = true;
   bool showWifi               = true;
 
@@ -125,6 +179,20 @@ void handle_json()
   {
     const String view = webArg(F("view"));
 
+    #if FEATURE_TIMING_STATS
+
+    if (equals(view, F("timingstats"))) {
+      TXBuffer.startJsonStream();
+      json_init();
+      json_open();
+      jsonStatistics(false);
+      json_close();
+      TXBuffer.endStream();
+      STOP_TIMER(HANDLE_SERVING_WEBPAGE_JSON);
+      return;
+    }
+    #endif // if FEATURE_TIMING_STATS
+
     if (equals(view, F("sensorupdate"))) {
       showSystem = false;
       showWifi   = false;
@@ -136,6 +204,22 @@ void handle_json()
       #if FEATURE_ESPEASY_P2P
       showNodes           = false;
       #endif
+      onlyTaskInfo        = true;
+    }
+  }
+
+  if (onlyTaskInfo) {
+    const String etag = showSpecificTask
+                        ? json_taskValues_ETag(taskNr - 1, taskNr - 1)
+                        : json_taskValues_ETag(0, TASKS_MAX - 1);
+    sendHeader(F("ETag"), etag);
+
+    if (clientHasETag(etag)) {
+      sendHeader(F("Cache-Control"),               F("no-cache"));
+      sendHeader(F("Access-Control-Allow-Origin"), F("*"));
+      web_server.send(304, F("application/json"), EMPTY_STRING);
+      STOP_TIMER(HANDLE_SERVING_WEBPAGE_JSON);
+      return;
     }
   }
 
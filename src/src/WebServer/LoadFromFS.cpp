@@ -5,6 +5,7 @@
 #include "../Globals/Cache.h"
 #include "../Globals/RamTracker.h"
 
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Network.h"
 #include "../Helpers/Numerical.h"
@@ -177,6 +178,61 @@ bool reply_304_not_modified(const String& path) {
   return res;
 }
 
+// ********************************************************************************
+// Check whether the client already has the content with this ETag
+// ********************************************************************************
+bool clientHasETag(const String& etag) {
+  if (etag.isEmpty()) {
+    return false;
+  }
+  const String ifNoneMatch = web_server.header(F("If-None-Match"));
+
+  // May be a list of ETags and may have a "W/" prefix
+  return ifNoneMatch.indexOf(etag) != -1;
+}
+
+// ********************************************************************************
+// ETag based on the content of a (non static) file.
+// The checksum of a file on the file system is computed once and kept in
+// Cache.fileContentChecksums until the file is opened for writing or file caches are cleared.
+// ********************************************************************************
+String getFileContentETag(const String& path, bool fileEmbedded) {
+  if (fileExists(path)) {
+    fs::File f = tryOpenFile(path, "r");
+
+    if (!f) {
+      return EMPTY_STRING;
+    }
+    const String key  = patch_fname(path);
+    const size_t size = f.size();
+    auto it           = Cache.fileContentChecksums.find(key);
+    uint32_t crc      = 0xffffffff;
+
+    if ((it != Cache.fileContentChecksums.end()) && (it->second.size == size)) {
+      crc = it->second.crc;
+    } else {
+      uint8_t buf[128];
+      size_t  bytesRead = 0;
+
+      while ((bytesRead = f.read(buf, sizeof(buf))) > 0) {
+        crc = calc_CRC32(buf, bytesRead, crc);
+        delay(0);
+      }
+      FileContentChecksum_t& checksum = Cache.fileContentChecksums[key];
+      checksum.size = size;
+      checksum.crc  = crc;
+    }
+    f.close();
+    return wrap_String(String(crc, HEX), '"');
+  }
+
+  if (fileEmbedded) {
+    // Embedded files can only change with a new build
+    return wrap_String(concat(F("b"), String(get_build_unixtime(), HEX)), '"');
+  }
+  return EMPTY_STRING;
+}
+
 // ********************************************************************************
 // Determine HTTP content type
 // ********************************************************************************
@@ -250,8 +306,8 @@ bool loadFromFS(String path) {
   bool mustCheckCredentials = false;
   const __FlashStringHelper* contentType  = get_ContentType(path, mustCheckCredentials);
 
-  const bool serve_304 = static_file && 
-                         reply_304_not_modified(path); // Reply with a 304 Not Modified
+  bool serve_304 = static_file && 
+                   reply_304_not_modified(path); // Reply with a 304 Not Modified
 
 #ifndef BUILD_NO_DEBUG
 
@@ -275,8 +331,15 @@ bool loadFromFS(String path) {
     sendHeader(F("ETag"),          wrap_String(String(Cache.fileCacheClearMoment) + F("-a"), '"')); // added "-a" to the ETag to
                                                                                                                // match the same encoding
   } else {
+    // Let the browser check whether its copy is still the same as the file content.
+    const String etag = getFileContentETag(path, fileEmbedded);
+
     sendHeader(F("Cache-Control"), F("no-cache"));
-    sendHeader(F("ETag"),          F("\"2.0.0\""));
+
+    if (!etag.isEmpty()) {
+      sendHeader(F("ETag"), etag);
+      serve_304 = clientHasETag(etag);
+    }
   }
   sendHeader(F("Vary"), "*");
 
@@ -6,6 +6,9 @@
 
 bool loadFromFS(String path);
 
+// Return true when the If-None-Match header of the request contains the given ETag.
+bool clientHasETag(const String& etag);
+
 void serve_CSS_inline();
 
 // Send the content of a file directly to the webserver, like addHtml()
@@ -6,6 +6,7 @@
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../../_Plugin_Helper.h"
 #include "../Helpers/ESPEasyStatistics.h"
+#include "../DataStructs/TimingStats.h"
 #include "../Static/WebStaticData.h"
 
 #ifdef WEBSERVER_METRICS
@@ -85,6 +86,12 @@ void handle_metrics() {
   // devices
   handle_metrics_devices();
 
+  # if FEATURE_TIMING_STATS
+
+  // controller queues, only collected when timing stats are enabled
+  handle_metrics_controllers();
+  # endif // if FEATURE_TIMING_STATS
+
   TXBuffer.endStream();
 }
 
@@ -135,4 +142,93 @@ void handle_metrics_devices() {
   }
 }
 
+# if FEATURE_TIMING_STATS
+
+// Stream a single metric line like: espeasy_controller_drops{controller="1",protocol="C001"} 0
+static void addMetricsControllerValue(const __FlashStringHelper *name, controllerIndex_t controllerIndex, const __FlashStringHelper *quantile, uint32_t value) {
+  addHtml(F("espeasy_controller_"));
+  addHtml(name);
+  addHtml(F("{controller=\""));
+  addHtmlInt(controllerIndex + 1);
+  addHtml(F("\",protocol=\""));
+  addHtml(get_formatted_Controller_number(Settings.Protocol[controllerIndex]));
+
+  if (quantile != nullptr) {
+    addHtml(F("\",quantile=\""));
+    addHtml(quantile);
+  }
+  addHtml(F("\"} "));
+  addHtmlInt(value);
+  addHtml('\n');
+}
+
+static void addMetricsHeader(const __FlashStringHelper *name, const __FlashStringHelper *help, const __FlashStringHelper *type) {
+  addHtml(F("# HELP espeasy_controller_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(help);
+  addHtml(F("\n# TYPE espeasy_controller_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(type);
+  addHtml('\n');
+}
+
+static void addMetricsLatencyHistogram(const __FlashStringHelper *name, controllerIndex_t controllerIndex, const LatencyHistogram& histogram) {
+  addMetricsControllerValue(name, controllerIndex, F("0.5"),  histogram.getPercentile(50));
+  addMetricsControllerValue(name, controllerIndex, F("0.95"), histogram.getPercentile(95));
+  addMetricsControllerValue(name, controllerIndex, F("0.99"), histogram.getPercentile(99));
+  addMetricsControllerValue(name, controllerIndex, F("1"),    histogram.getMax());
+}
+
+void handle_metrics_controllers() {
+  if (controllerSendStats.empty()) {
+    return;
+  }
+
+  addMetricsHeader(F("rtt_ms"), F("Duration of connecting to the MQTT broker or sending a message by a controller in milliseconds"), F("summary"));
+
+  for (auto& x: controllerSendStats) {
+    addMetricsLatencyHistogram(F("rtt_ms"), x.first, x.second.rtt);
+  }
+
+  addMetricsHeader(F("queue_wait_ms"), F("Time messages spent in the controller queue before being sent in milliseconds"), F("summary"));
+
+  for (auto& x: controllerSendStats) {
+    addMetricsLatencyHistogram(F("queue_wait_ms"), x.first, x.second.queueWait);
+  }
+
+  addMetricsHeader(F("sent"), F("Number of messages sent by a controller"), F("counter"));
+
+  for (auto& x: controllerSendStats) {
+    addMetricsControllerValue(F("sent"), x.first, nullptr, x.second.queueWait.getCount());
+  }
+
+  addMetricsHeader(F("failures"), F("Number of failed connection attempts or sends of a controller"), F("counter"));
+
+  for (auto& x: controllerSendStats) {
+    addMetricsControllerValue(F("failures"), x.first, nullptr, x.second.failures);
+  }
+
+  addMetricsHeader(F("retries"), F("Number of messages which will be sent again by a controller"), F("counter"));
+
+  for (auto& x: controllerSendStats) {
+    addMetricsControllerValue(F("retries"), x.first, nullptr, x.second.retries);
+  }
+
+  addMetricsHeader(F("drops"), F("Number of messages removed from a controller queue without being sent"), F("counter"));
+
+  for (auto& x: controllerSendStats) {
+    addMetricsControllerValue(F("drops"), x.first, nullptr, x.second.drops);
+  }
+
+  addMetricsHeader(F("interval_ms"), F("Time between messages of a controller in milliseconds"), F("gauge"));
+
+  for (auto& x: controllerSendStats) {
+    addMetricsControllerValue(F("interval_ms"), x.first, nullptr, x.second.interval);
+  }
+}
+
+# endif // if FEATURE_TIMING_STATS
+
 #endif // WEBSERVER_METRICS
@@ -13,8 +13,12 @@
 #include "../Globals/RamTracker.h"
 
 #include "../Globals/Device.h"
+#include "../Globals/EventQueue.h"
+#include "../Globals/SendDataFilter.h"
+#include "../Globals/Settings.h"
 
 #include "../Helpers/_Plugin_init.h"
+#include "../Helpers/StringConverter.h"
 
 
 #define TIMING_STATS_THRESHOLD 100000
@@ -40,6 +44,44 @@ void handle_timingstats() {
   const long timeSinceLastReset = stream_timing_statistics(true);
   html_end_table();
 
+  if (!schedulerStats.empty()) {
+    html_table_class_multirow();
+    html_TR();
+    html_table_header(F("Scheduler"));
+    html_table_header(F("#calls"));
+    html_table_header(F("late p50 (ms)"));
+    html_table_header(F("late p95 (ms)"));
+    html_table_header(F("late p99 (ms)"));
+    html_table_header(F("late max (ms)"));
+    html_table_header(F("run p50 (ms)"));
+    html_table_header(F("run p95 (ms)"));
+    html_table_header(F("run p99 (ms)"));
+    html_table_header(F("run max (ms)"));
+    stream_scheduler_timing_statistics(true);
+    html_end_table();
+  }
+
+  if (!controllerSendStats.empty()) {
+    html_table_class_multirow();
+    html_TR();
+    html_table_header(F("Controller"));
+    html_table_header(F("#sent"));
+    html_table_header(F("RTT p50 (ms)"));
+    html_table_header(F("RTT p95 (ms)"));
+    html_table_header(F("RTT p99 (ms)"));
+    html_table_header(F("RTT max (ms)"));
+    html_table_header(F("wait p50 (ms)"));
+    html_table_header(F("wait p95 (ms)"));
+    html_table_header(F("wait p99 (ms)"));
+    html_table_header(F("wait max (ms)"));
+    html_table_header(F("failures"));
+    html_table_header(F("retries"));
+    html_table_header(F("drops"));
+    html_table_header(F("interval (ms)"));
+    stream_controller_send_statistics(true);
+    html_end_table();
+  }
+
   html_table_class_normal();
   const float timespan = timeSinceLastReset / 1000.0f;
   addFormHeader(F("Statistics"));
@@ -50,6 +92,21 @@ void handle_timingstats() {
   addRowLabel(F("Time span"));
   addHtmlFloat(timespan);
   addHtml(F(" sec"));
+  addRowLabel(F("Events dropped"));
+  addHtmlInt(eventQueue.getNrDropped());
+  addRowLabel(F("Events coalesced"));
+  addHtmlInt(eventQueue.getNrCoalesced());
+  eventQueue.resetStats();
+#if FEATURE_TASKVALUE_SEND_ON_CHANGE
+
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    if (Settings.Protocol[x] != 0) {
+      addRowLabel(concat(F("Sends suppressed "), getControllerSymbol(x)));
+      addHtmlInt(SendDataFilter.getSuppressedCount(x));
+    }
+  }
+  SendDataFilter.resetStats();
+#endif // if FEATURE_TASKVALUE_SEND_ON_CHANGE
   addRowLabel(F("*"));
   addHtml(F("Duty cycle based on average < 1 msec is highly unreliable"));
   html_end_table();
@@ -105,6 +162,80 @@ void stream_html_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   format_using_threshhold(maxVal);
 }
 
+void stream_html_latency_histogram(const LatencyHistogram& histogram, bool usec) {
+  const uint8_t percentiles[] = { 50, 95, 99 };
+
+  for (uint8_t i = 0; i < NR_ELEMENTS(percentiles); ++i) {
+    html_TD();
+
+    if (usec) {
+      format_using_threshhold(histogram.getPercentile(percentiles[i]));
+    } else {
+      addHtmlInt(histogram.getPercentile(percentiles[i]));
+    }
+  }
+  html_TD();
+
+  if (usec) {
+    format_using_threshhold(histogram.getMax());
+  } else {
+    addHtmlInt(histogram.getMax());
+  }
+}
+
+void stream_scheduler_timing_statistics(bool clearStats) {
+  for (auto& x: schedulerStats) {
+    if (!x.second.duration.isEmpty()) {
+      if (x.second.duration.getMax() > TIMING_STATS_THRESHOLD) {
+        html_TR_TD_highlight();
+      } else {
+        html_TR_TD();
+      }
+      addHtml(toString(x.first));
+      html_TD();
+      addHtmlInt(x.second.duration.getCount());
+      stream_html_latency_histogram(x.second.lateness, false);
+      stream_html_latency_histogram(x.second.duration, true);
+    }
+  }
+
+  if (clearStats) {
+    schedulerStats.clear();
+  }
+}
+
+void stream_controller_send_statistics(bool clearStats) {
+  for (auto& x: controllerSendStats) {
+    if ((x.second.failures != 0) || (x.second.drops != 0) ||
+        !x.second.rtt.isEmpty() || !x.second.queueWait.isEmpty()) {
+      if ((x.second.drops != 0) || (x.second.failures != 0)) {
+        html_TR_TD_highlight();
+      } else {
+        html_TR_TD();
+      }
+      addHtmlInt(x.first + 1);
+      addHtml(F(" - "));
+      addHtml(get_formatted_Controller_number(Settings.Protocol[x.first]));
+      html_TD();
+      addHtmlInt(x.second.queueWait.getCount());
+      stream_html_latency_histogram(x.second.rtt, false);
+      stream_html_latency_histogram(x.second.queueWait, false);
+      html_TD();
+      addHtmlInt(x.second.failures);
+      html_TD();
+      addHtmlInt(x.second.retries);
+      html_TD();
+      addHtmlInt(x.second.drops);
+      html_TD();
+      addHtmlInt(x.second.interval);
+    }
+  }
+
+  if (clearStats) {
+    controllerSendStats.clear();
+  }
+}
+
 long stream_timing_statistics(bool clearStats) {
   const long timeSinceLastReset = timePassedSince(timingstats_last_reset);
 
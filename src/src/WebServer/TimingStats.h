@@ -16,6 +16,13 @@ void format_using_threshhold(unsigned long value);
 
 void stream_html_timing_stats(const TimingStats& stats, long timeSinceLastReset);
 
+// Lateness in msec, duration in usec.
+void stream_html_latency_histogram(const LatencyHistogram& histogram, bool usec);
+
+void stream_scheduler_timing_statistics(bool clearStats);
+
+void stream_controller_send_statistics(bool clearStats);
+
 long stream_timing_statistics(bool clearStats);
 
 #endif 
@@ -0,0 +1,73 @@
+#!/bin/bash
+#
+# Build the host-native rules engine benchmark.
+#
+# The rules engine sources are copied from src/src into a build tree and compiled as-is,
+# next to replacements of the rest of the firmware they depend on (see shim/).
+#
+# Usage: ./build.sh [build dir]
+# Then:  <build dir>/rules_benchmark ../rules1.txt ../rules2.txt --events events.txt
+
+set -e
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR="${SCRIPT_DIR}/../../../src/src"
+BUILD_DIR=${1:-"${SCRIPT_DIR}/build"}
+CXX=${CXX:-g++}
+
+# Firmware sources compiled as-is.
+FIRMWARE_SOURCES="
+  DataStructs/RulesBlockCache
+  DataStructs/RulesCompiledImage
+  DataStructs/RulesEventCache
+  DataStructs/EventQueue
+  DataTypes/PluginID
+  ESPEasyCore/ESPEasyRules
+  Globals/EventQueue
+  Globals/RulesCalculate
+  Helpers/Convert
+  Helpers/Numerical
+  Helpers/RulesHelper
+  Helpers/RulesMatcher
+  Helpers/Rules_calculate
+  Helpers/StringConverter
+  Helpers/StringConverter_Numerical
+  Helpers/StringParser
+"
+
+# Firmware headers used as-is, without their source.
+# ESPEasy_math.cpp replaces the libm functions, so the host libm is used instead.
+FIRMWARE_HEADERS="
+  CustomBuild/ESPEasyLimits
+  DataTypes/EventValueSource
+  Helpers/ESPEasy_math
+"
+
+rm -rf "${BUILD_DIR}/src"
+mkdir -p "${BUILD_DIR}/src"
+cp -r "${SCRIPT_DIR}/shim/." "${BUILD_DIR}/"
+
+for f in ${FIRMWARE_HEADERS}; do
+  mkdir -p "$(dirname "${BUILD_DIR}/src/${f}")"
+  cp "${SRC_DIR}/${f}.h" "$(dirname "${BUILD_DIR}/src/${f}")/"
+done
+
+CPP_FILES=""
+
+for f in ${FIRMWARE_SOURCES}; do
+  mkdir -p "$(dirname "${BUILD_DIR}/src/${f}")"
+  cp "${SRC_DIR}/${f}.h" "${SRC_DIR}/${f}.cpp" "$(dirname "${BUILD_DIR}/src/${f}")/"
+  CPP_FILES="${CPP_FILES} ${BUILD_DIR}/src/${f}.cpp"
+done
+
+# -Wno-narrowing: StringConverter.cpp initializes char arrays with UTF-8 bytes above 127.
+${CXX} -std=gnu++17 -O2 -Wall -Wno-narrowing \
+  -I"${BUILD_DIR}" \
+  ${CXXFLAGS} \
+  "${SCRIPT_DIR}/rules_benchmark.cpp" \
+  "${BUILD_DIR}/shim.cpp" \
+  "${BUILD_DIR}/shim_firmware.cpp" \
+  ${CPP_FILES} \
+  -o "${BUILD_DIR}/rules_benchmark"
+
+echo "Built ${BUILD_DIR}/rules_benchmark"
@@ -0,0 +1,119 @@
+// Host test of the scheduler timer heap (msecTimerHandlerStruct).
+//
+// Registers, updates, removes and pops timers in random order and checks
+// the result against a simple reference model.
+// Build and run with run_tests.sh, which enables AddressSanitizer.
+
+#include "src/Helpers/msecTimerHandlerStruct.h"
+#include "src/Helpers/ESPEasy_time_calc.h"
+
+#include <cstdio>
+#include <map>
+#include <random>
+
+namespace {
+struct RefTimer {
+  unsigned long timer;
+  uint32_t      sequence;
+};
+
+// Same order as the scheduler: earliest timer first,
+// for equal timers the one set last is handled first.
+bool refIsEarlier(const RefTimer& a, const RefTimer& b) {
+  const int32_t diff = timeDiff(b.timer, a.timer);
+
+  if (diff != 0) {
+    return diff < 0;
+  }
+  return a.sequence > b.sequence;
+}
+
+int nrErrors = 0;
+
+void check(bool condition, const char *what, unsigned long id) {
+  if (!condition) {
+    ++nrErrors;
+    fprintf(stderr, "FAIL: %s (id %lu)\n", what, id);
+  }
+}
+
+// Pop the next timer which is due and compare with the reference.
+void popOne(msecTimerHandlerStruct& handler, std::map<unsigned long, RefTimer>& ref) {
+  unsigned long timer    = 0;
+  const unsigned long id = handler.getNextId(timer);
+
+  if (ref.empty()) {
+    check(id == 0, "empty heap", id);
+    return;
+  }
+  auto expected = ref.begin();
+
+  for (auto it = ref.begin(); it != ref.end(); ++it) {
+    if (refIsEarlier(it->second, expected->second)) {
+      expected = it;
+    }
+  }
+  check(id == expected->first,           "pop order",    id);
+  check(timer == expected->second.timer, "popped timer", id);
+  ref.erase(id);
+}
+
+void popAll(msecTimerHandlerStruct& handler, std::map<unsigned long, RefTimer>& ref) {
+  while (!ref.empty()) {
+    popOne(handler, ref);
+  }
+  popOne(handler, ref);
+}
+} // namespace
+
+int main() {
+  std::mt19937 rng(12345);
+  msecTimerHandlerStruct handler;
+
+  handler.setEcoMode(false);
+
+  // All timers are set in the past, so they are due immediately.
+  const unsigned long now = millis();
+  uint32_t sequence       = 0;
+
+  for (int round = 0; round < 200; ++round) {
+    std::map<unsigned long, RefTimer> ref;
+    const int nrOperations = 1 + rng() % 200;
+
+    for (int op = 0; op < nrOperations; ++op) {
+      const unsigned long id = 1 + rng() % 64;
+      const unsigned int action = rng() % 4;
+
+      if (action == 0) {
+        // Remove, also of ids which are not present.
+        handler.remove(id);
+        ref.erase(id);
+      } else {
+        // Register or update, with few distinct timers to have many equal ones.
+        const unsigned long timer = now - 1000 - (rng() % 8);
+        handler.registerAt(id, timer);
+        ref[id] = { timer, ++sequence };
+      }
+
+      unsigned long timer = 0;
+      check(handler.getTimerForId(id, timer) == (ref.find(id) != ref.end()), "getTimerForId", id);
+
+      if (ref.find(id) != ref.end()) {
+        check(timer == ref[id].timer, "registered timer", id);
+      }
+
+      if (rng() % 16 == 0) {
+        // Pop one in between.
+        popOne(handler, ref);
+      }
+    }
+    popAll(handler, ref);
+  }
+
+  if (nrErrors != 0) {
+    fprintf(stderr, "%d errors\n", nrErrors);
+    return 1;
+  }
+  printf("msecTimerHandlerStruct: OK\n");
+  return 0;
+}
@@ -0,0 +1,312 @@
+// Host-native benchmark of the rules engine.
+//
+// Replays a stream of events against rules files through the firmware rules engine
+// (ESPEasyRules.cpp, RulesHelper, StringParser, Calculate and the event queue), built by build.sh.
+// The rest of the firmware is replaced by the headers in shim/ and the functions below:
+// - The rules files are kept in memory as rules1.txt ... rules4.txt.
+// - No tasks or controllers are configured.
+// - Let, Event, TimerSet, GPIO, GPIOtoggle and Monitor are simulated, other commands (e.g. LogEntry) are only counted.
+// - Of the system variables only %sysheap% and %sysstack% are set.
+// - Rules timers run on a virtual clock, so a test lasting minutes on a node is replayed at once.
+//
+// Build with build.sh, then run:
+//   rules_benchmark [--repeat N] [--no-event-cache] --events events.txt rules1.txt [rules2.txt ...]
+//
+// Reports events/sec, heap allocations per event and peak heap usage.
+
+#include "_Plugin_Helper.h"
+
+#include "src/Commands/GPIO.h"
+#include "src/Commands/InternalCommands.h"
+#include "src/ESPEasyCore/ESPEasyRules.h"
+#include "src/Globals/Cache.h"
+#include "src/Globals/EventQueue.h"
+#include "src/Globals/RulesCalculate.h"
+#include "src/Globals/RuntimeData.h"
+#include "src/Helpers/SystemVariables.h"
+
+#include <chrono>
+#include <fstream>
+#include <malloc.h>
+#include <map>
+#include <new>
+#include <sstream>
+
+extern uint32_t nrLoggedErrors;
+
+/*********************************************************************************************\
+* Heap statistics
+\*********************************************************************************************/
+#if defined(__GNUC__) && !defined(__clang__)
+
+// The replaced operator new uses malloc, so free is the matching function.
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // if defined(__GNUC__) && !defined(__clang__)
+
+static uint64_t nrAllocations = 0;
+static int64_t  heapInUse     = 0;
+static int64_t  heapPeak      = 0;
+
+void* operator new(size_t size) {
+  void *ptr = malloc(size == 0 ? 1 : size);
+
+  if (ptr == nullptr) { throw std::bad_alloc(); }
+  ++nrAllocations;
+  heapInUse += malloc_usable_size(ptr);
+
+  if (heapInUse > heapPeak) { heapPeak = heapInUse; }
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return operator new(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return operator new(size, std::nothrow);
+}
+
+void operator delete(void *ptr) noexcept {
+  if (ptr == nullptr) { return; }
+  heapInUse -= malloc_usable_size(ptr);
+  free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  operator delete(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  operator delete(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+  operator delete(ptr);
+}
+
+/*********************************************************************************************\
+* Simulated node state
+\*********************************************************************************************/
+static std::map<uint32_t, ESPEASY_RULES_FLOAT_TYPE> customVariables;
+static std::map<int, unsigned long>                 rulesTimers; // timer nr -> virtual time in msec
+static std::map<int, int>                           gpioStates;
+static std::map<int, bool>                          gpioMonitored;
+static unsigned long                                virtualTime = 0;
+
+static uint64_t nrEvents   = 0;
+static uint64_t nrCommands = 0;
+
+ESPEASY_RULES_FLOAT_TYPE getCustomFloatVar(uint32_t index) {
+  auto it = customVariables.find(index);
+
+  return it == customVariables.end() ? 0 : it->second;
+}
+
+void setCustomFloatVar(uint32_t index, const ESPEASY_RULES_FLOAT_TYPE& value) {
+  customVariables[index] = value;
+}
+
+// Only [Plugin#GPIO#Pinstate#N]
+bool getGPIOPinStateValues(String& str) {
+  int pin = 0;
+
+  if (!parseString(str, 2).equals(F("pinstate")) ||
+      !validIntFromString(parseString(str, 3), pin)) {
+    return false;
+  }
+  str = String(gpioStates[pin]);
+  return true;
+}
+
+void SystemVariables::parseSystemVariables(String& s, bool useURLencode) {
+  if (s.indexOf('%') == -1) {
+    return;
+  }
+  s.replace(F("%sysheap%"), F("20000"));
+  s.replace(F("%sysstack%"), F("4000"));
+}
+
+/*********************************************************************************************\
+* Commands
+\*********************************************************************************************/
+static void setGPIO(int pin, int state)
+{
+  if (gpioStates[pin] != state) {
+    gpioStates[pin] = state;
+
+    if (gpioMonitored[pin]) {
+      eventQueue.add(concat(F("GPIO#"), pin) + '=' + String(state));
+    }
+  }
+}
+
+bool ExecuteCommand_all(EventValueSource::Enum source, const char *Line)
+{
+  ++nrCommands;
+  const String command = parseString(Line, 1);
+
+  if (command.equals(F("let"))) {
+    // Same as Command_Rules_Let()
+    String TmpStr1;
+    ESPEASY_RULES_FLOAT_TYPE result{};
+
+    if (GetArgv(Line, TmpStr1, 3) && !isError(Calculate(TmpStr1, result))) {
+      setCustomFloatVar(parseString(Line, 2).toInt(), result);
+    }
+  } else if (command.equals(F("event"))) {
+    // Same as Command_Rules_Events(), events from rules are processed right away.
+    String eventName = parseStringToEndKeepCase(Line, 2);
+
+    eventName.replace('$', '#');
+    ++nrEvents;
+    rulesProcessing(eventName);
+  } else if (command.equals(F("timerset"))) {
+    const int timer   = parseString(Line, 2).toInt();
+    const int seconds = parseString(Line, 3).toInt();
+
+    if (seconds > 0) {
+      rulesTimers[timer] = virtualTime + seconds * 1000ul;
+    } else {
+      rulesTimers.erase(timer);
+    }
+  } else if (command.equals(F("gpio"))) {
+    setGPIO(parseString(Line, 2).toInt(), parseString(Line, 3).toInt() ? 1 : 0);
+  } else if (command.equals(F("gpiotoggle"))) {
+    const int pin = parseString(Line, 2).toInt();
+    setGPIO(pin, gpioStates[pin] ? 0 : 1);
+  } else if (command.equals(F("monitor"))) {
+    gpioMonitored[parseString(Line, 3).toInt()] = true;
+  }
+  return true;
+}
+
+/*********************************************************************************************\
+* Event loop
+\*********************************************************************************************/
+
+// Process all events, including the events and timers triggered by them.
+static void runUntilIdle()
+{
+  while (true) {
+    while (processNextEvent()) {
+      ++nrEvents;
+    }
+
+    if (rulesTimers.empty()) {
+      return;
+    }
+
+    // Advance the virtual clock to the first timer
+    auto first = rulesTimers.begin();
+
+    for (auto it = rulesTimers.begin(); it != rulesTimers.end(); ++it) {
+      if (it->second < first->second) { first = it; }
+    }
+    virtualTime = first->second;
+    eventQueue.add(concat(F("Rules#Timer="), first->first));
+    rulesTimers.erase(first);
+  }
+}
+
+static void resetNodeState()
+{
+  customVariables.clear();
+  rulesTimers.clear();
+  gpioStates.clear();
+  gpioMonitored.clear();
+  eventQueue.clear();
+  virtualTime = 0;
+}
+
+static bool loadRulesFile(const String& filename, unsigned int filenr)
+{
+  std::ifstream file(filename.c_str());
+
+  if (!file || (filenr >= RULESETS_MAX)) {
+    fprintf(stderr, "Cannot use %s as rules set %u\n", filename.c_str(), filenr + 1);
+    return false;
+  }
+  std::ostringstream content;
+
+  content << file.rdbuf();
+  fs::addFile(getRulesFileName(filenr), content.str());
+  return true;
+}
+
+/*********************************************************************************************\
+* main
+\*********************************************************************************************/
+int main(int argc, char *argv[])
+{
+  std::vector<String> events;
+  unsigned int nrRulesFiles = 0;
+  int repeat                = 100;
+
+  for (int i = 1; i < argc; ++i) {
+    const String arg(argv[i]);
+
+    if (arg.equals(F("--repeat")) && (i + 1 < argc)) {
+      repeat = atoi(argv[++i]);
+    } else if (arg.equals(F("--no-event-cache"))) {
+      Settings._enableRulesCaching = false;
+    } else if (arg.equals(F("--events")) && (i + 1 < argc)) {
+      std::ifstream file(argv[++i]);
+      std::string   line;
+
+      while (std::getline(file, line)) {
+        String event(line);
+        event.trim();
+
+        if (!event.isEmpty() && !event.startsWith(F("//"))) {
+          events.push_back(event);
+        }
+      }
+    } else if (!loadRulesFile(arg, nrRulesFiles++)) {
+      return 1;
+    }
+  }
+
+  if ((nrRulesFiles == 0) || events.empty()) {
+    fprintf(stderr, "Usage: %s [--repeat N] [--no-event-cache] --events <file> <rules file> ...\n", argv[0]);
+    return 1;
+  }
+
+  // Read and compile the rules files, as done on the node at the first event.
+  Cache.rulesHelper.init();
+
+  const uint64_t allocationsBefore = nrAllocations;
+  const int64_t  heapBefore        = heapInUse;
+
+  heapPeak = heapInUse;
+  const auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < repeat; ++i) {
+    resetNodeState();
+
+    for (const String& event : events) {
+      eventQueue.add(event);
+      runUntilIdle();
+    }
+  }
+  const auto   end     = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(end - start).count();
+
+  printf("Rules files      : %u\n",    nrRulesFiles);
+  printf("Event cache      : %s\n",    Settings.EnableRulesCaching() ? "enabled" : "disabled");
+  printf("Events processed : %llu\n",  static_cast<unsigned long long>(nrEvents));
+  printf("Commands         : %llu\n",  static_cast<unsigned long long>(nrCommands));
+  printf("Errors logged    : %u\n",    nrLoggedErrors);
+  printf("Time             : %.3f s\n", seconds);
+  printf("Events/sec       : %.0f\n",  nrEvents / seconds);
+  printf("Allocs/event     : %.1f\n",  static_cast<double>(nrAllocations - allocationsBefore) / nrEvents);
+  printf("Peak heap        : %lld bytes above start\n", static_cast<long long>(heapPeak - heapBefore));
+  return 0;
+}
@@ -0,0 +1,49 @@
+#!/bin/bash
+#
+# Build and run the host-native unit tests with AddressSanitizer.
+#
+# The tested sources are copied from src/src into a build tree,
+# next to thin replacements of the firmware headers they include (see shim/).
+#
+# Usage: ./run_tests.sh [build dir]
+
+set -e
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR="${SCRIPT_DIR}/../../../src/src"
+BUILD_DIR=${1:-"${SCRIPT_DIR}/build_tests"}
+CXX=${CXX:-g++}
+
+TESTED_SOURCES="
+  Helpers/msecTimerHandlerStruct
+"
+TESTED_HEADERS="
+  DataStructs/timer_id_couple
+"
+
+rm -rf "${BUILD_DIR}/src"
+mkdir -p "${BUILD_DIR}/src"
+cp -r "${SCRIPT_DIR}/shim/." "${BUILD_DIR}/"
+
+CPP_FILES=""
+
+for f in ${TESTED_HEADERS} ${TESTED_SOURCES}; do
+  mkdir -p "$(dirname "${BUILD_DIR}/src/${f}")"
+  cp "${SRC_DIR}/${f}.h" "$(dirname "${BUILD_DIR}/src/${f}")/"
+done
+
+for f in ${TESTED_SOURCES}; do
+  cp "${SRC_DIR}/${f}.cpp" "$(dirname "${BUILD_DIR}/src/${f}")/"
+  CPP_FILES="${CPP_FILES} ${BUILD_DIR}/src/${f}.cpp"
+done
+
+${CXX} -std=gnu++17 -O1 -g -Wall \
+  -fsanitize=address,undefined -fno-omit-frame-pointer \
+  -I"${BUILD_DIR}" \
+  ${CXXFLAGS} \
+  "${SCRIPT_DIR}/msecTimerHandler_test.cpp" \
+  "${BUILD_DIR}/shim.cpp" \
+  ${CPP_FILES} \
+  -o "${BUILD_DIR}/msecTimerHandler_test"
+
+"${BUILD_DIR}/msecTimerHandler_test"
@@ -0,0 +1,179 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Minimal replacement of the Arduino core, enough to build the rules engine on a host.
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <math.h>
+#include <string>
+
+class __FlashStringHelper;
+
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define PSTR(s) (s)
+#define PGM_P const char *
+#define PROGMEM
+#define strlen_P strlen
+#define strncpy_P strncpy
+#define sprintf_P sprintf
+#define vsnprintf_P vsnprintf
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcasecmp_P strcasecmp
+#define strncasecmp_P strncasecmp
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg) ((deg) * M_PI / 180.0)
+#define degrees(rad) ((rad) * 180.0 / M_PI)
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+inline bool isDigit(int c) {
+  return isdigit(c) != 0;
+}
+
+inline bool isAlpha(int c) {
+  return isalpha(c) != 0;
+}
+
+inline bool isAlphaNumeric(int c) {
+  return isalnum(c) != 0;
+}
+
+inline bool isSpace(int c) {
+  return isspace(c) != 0;
+}
+
+char* dtostrf(double number, signed char width, unsigned char prec, char *s);
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+
+class String {
+public:
+
+  String() = default;
+  String(const char *cstr) : _s(cstr ? cstr : "") {}
+  String(const __FlashStringHelper *str) : _s(str ? reinterpret_cast<const char *>(str) : "") {}
+  String(const String& str) = default;
+  String(String&& str) = default;
+  explicit String(const std::string& str) : _s(str) {}
+  explicit String(char c) : _s(1, c) {}
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(long long value) : _s(std::to_string(value)) {}
+  explicit String(unsigned long long value) : _s(std::to_string(value)) {}
+  explicit String(float value, unsigned char decimalPlaces = 2);
+  explicit String(double value, unsigned char decimalPlaces = 2);
+
+  String& operator=(const String& rhs) = default;
+  String& operator=(String&& rhs)      = default;
+  String& operator=(const char *cstr) { _s = cstr ? cstr : ""; return *this; }
+  String& operator=(const __FlashStringHelper *str) { return *this = reinterpret_cast<const char *>(str); }
+  String& operator=(char c) { _s.assign(1, c); return *this; }
+
+  bool        reserve(unsigned int size) { _s.reserve(size); return true; }
+  unsigned int length() const { return _s.length(); }
+  bool        isEmpty() const { return _s.empty(); }
+  void        clear() { _s.clear(); }
+  const char* c_str() const { return _s.c_str(); }
+  char*       begin() { return &_s[0]; }
+  char*       end() { return begin() + _s.length(); }
+  const char* begin() const { return _s.c_str(); }
+  const char* end() const { return _s.c_str() + _s.length(); }
+
+  bool concat(const String& str) { _s += str._s; return true; }
+  bool concat(const char *cstr) { if (cstr) { _s += cstr; } return true; }
+  bool concat(const char *cstr, unsigned int length) { _s.append(cstr, length); return true; }
+  bool concat(char c) { _s += c; return true; }
+  bool concat(const __FlashStringHelper *str) { return concat(reinterpret_cast<const char *>(str)); }
+  bool concat(int num) { return concat(String(num)); }
+  bool concat(unsigned int num) { return concat(String(num)); }
+  bool concat(long num) { return concat(String(num)); }
+  bool concat(unsigned long num) { return concat(String(num)); }
+  bool concat(long long num) { return concat(String(num)); }
+  bool concat(unsigned long long num) { return concat(String(num)); }
+  bool concat(double num) { return concat(String(num)); }
+
+  template<typename T>
+  String& operator+=(const T& rhs) { concat(rhs); return *this; }
+  String& operator+=(int num) { return *this += String(num); }
+  String& operator+=(unsigned int num) { return *this += String(num); }
+  String& operator+=(long num) { return *this += String(num); }
+  String& operator+=(unsigned long num) { return *this += String(num); }
+  String& operator+=(float num) { return *this += String(num); }
+  String& operator+=(double num) { return *this += String(num); }
+  String& operator+=(const String& rhs) { concat(rhs); return *this; }
+
+  friend String operator+(const String& lhs, const String& rhs) { String res(lhs); res += rhs; return res; }
+  friend String operator+(const String& lhs, const char *rhs) { String res(lhs); res += rhs; return res; }
+  friend String operator+(const String& lhs, char rhs) { String res(lhs); res += rhs; return res; }
+  friend String operator+(const String& lhs, const __FlashStringHelper *rhs) { String res(lhs); res += rhs; return res; }
+  friend String operator+(char lhs, const String& rhs) { String res(lhs); res += rhs; return res; }
+  friend String operator+(const char *lhs, const String& rhs) { String res(lhs); res += rhs; return res; }
+  friend String operator+(const __FlashStringHelper *lhs, const String& rhs) { String res(lhs); res += rhs; return res; }
+
+  int  compareTo(const String& s) const { return _s.compare(s._s); }
+  bool equals(const String& s) const { return _s == s._s; }
+  bool equals(const char *cstr) const { return _s == (cstr ? cstr : ""); }
+  bool equalsIgnoreCase(const String& s) const;
+  bool operator==(const String& rhs) const { return equals(rhs); }
+  bool operator==(const char *cstr) const { return equals(cstr); }
+  bool operator!=(const String& rhs) const { return !equals(rhs); }
+  bool operator<(const String& rhs) const { return _s < rhs._s; }
+  bool startsWith(const String& prefix) const { return _s.compare(0, prefix._s.length(), prefix._s) == 0; }
+  bool startsWith(const String& prefix, unsigned int offset) const;
+  bool endsWith(const String& suffix) const;
+
+  char  charAt(unsigned int index) const { return operator[](index); }
+  void  setCharAt(unsigned int index, char c) { if (index < _s.length()) { _s[index] = c; } }
+  char  operator[](unsigned int index) const { return index < _s.length() ? _s[index] : 0; }
+  char& operator[](unsigned int index) { static char dummy; return index < _s.length() ? _s[index] : (dummy = 0); }
+
+  int    indexOf(char ch, unsigned int fromIndex = 0) const;
+  int    indexOf(const String& str, unsigned int fromIndex = 0) const;
+  int    lastIndexOf(char ch) const;
+  int    lastIndexOf(const String& str) const;
+  String substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+  String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+  void replace(char find, char replace);
+  void replace(const String& find, const String& replace);
+  void remove(unsigned int index) { remove(index, length()); }
+  void remove(unsigned int index, unsigned int count);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+
+  long   toInt() const { return atol(_s.c_str()); }
+  float  toFloat() const { return atof(_s.c_str()); }
+  double toDouble() const { return atof(_s.c_str()); }
+
+private:
+
+  std::string _s;
+};
+
+extern const String emptyString;
+
+#endif // ifndef ARDUINO_H
@@ -0,0 +1,44 @@
+#ifndef ESPEASY_COMMON_H
+#define ESPEASY_COMMON_H
+
+// Host replacement of ESPEasy_common.h for the rules benchmark.
+// Feature flags can be overruled via CXXFLAGS, e.g. CXXFLAGS="-DFEATURE_RULES_CALCULATE_CACHE=0"
+
+#include "Arduino.h"
+
+#include <vector>
+
+// Build as ESP32, which keeps the rules files in memory (CACHE_RULES_IN_MEMORY)
+#if !defined(ESP8266) && !defined(ESP32)
+# define ESP32
+#endif // if !defined(ESP8266) && !defined(ESP32)
+
+#define ESPEASY_RULES_FLOAT_TYPE double
+#define FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE 1
+#define FEATURE_TRIGONOMETRIC_FUNCTIONS_RULES 1
+
+#ifndef FEATURE_RULES_COMPILER
+# define FEATURE_RULES_COMPILER 1
+#endif // ifndef FEATURE_RULES_COMPILER
+
+#ifndef FEATURE_RULES_CALCULATE_CACHE
+# define FEATURE_RULES_CALCULATE_CACHE 1
+#endif // ifndef FEATURE_RULES_CALCULATE_CACHE
+
+#define FEATURE_COMPILED_TEMPLATES 0
+#define FEATURE_TIMING_STATS 0
+#define BUILD_NO_DEBUG
+#define BUILD_NO_RAM_TRACKER
+
+#define NR_ELEMENTS(ARR) (sizeof(ARR) / sizeof *(ARR))
+
+#define LOG_LEVEL_NONE       0
+#define LOG_LEVEL_ERROR      1
+#define LOG_LEVEL_INFO       2
+#define LOG_LEVEL_DEBUG      3
+#define LOG_LEVEL_DEBUG_MORE 4
+#define LOG_LEVEL_DEBUG_DEV  9
+
+extern const String EMPTY_STRING;
+
+#endif // ifndef ESPEASY_COMMON_H
@@ -0,0 +1,60 @@
+#ifndef FS_H
+#define FS_H
+
+// Host replacement of the file system, files are kept in memory.
+// See fs::addFile() to add the files.
+
+#include "Arduino.h"
+
+#include <memory>
+
+namespace fs {
+class File {
+public:
+
+  File() = default;
+  explicit File(std::shared_ptr<const std::string>data) : _data(data) {}
+
+  explicit operator bool() const {
+    return _data != nullptr;
+  }
+
+  void   close() {
+    _data.reset();
+  }
+
+  size_t position() const {
+    return _pos;
+  }
+
+  size_t size() const {
+    return _data ? _data->size() : 0;
+  }
+
+  bool   seek(size_t pos) {
+    if (pos > size()) { return false; }
+    _pos = pos;
+    return true;
+  }
+
+  int available() const {
+    return size() - _pos;
+  }
+
+  int read() {
+    return _pos < size() ? static_cast<uint8_t>((*_data)[_pos++]) : -1;
+  }
+
+  size_t read(uint8_t *buffer, size_t length);
+
+private:
+
+  std::shared_ptr<const std::string>_data;
+  size_t                            _pos = 0;
+};
+
+// Store a file, replacing any existing one with the same name.
+void addFile(const String& fname, std::string&& content);
+} // namespace fs
+
+#endif // ifndef FS_H
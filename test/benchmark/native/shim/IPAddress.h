@@ -0,0 +1,34 @@
+#ifndef IPADDRESS_H
+#define IPADDRESS_H
+
+// Minimal replacement of the Arduino IPAddress class.
+
+#include "Arduino.h"
+
+class IPAddress {
+public:
+
+  IPAddress() = default;
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address{ a, b, c, d } {}
+
+  bool    fromString(const char *address);
+  bool    fromString(const String& address) {
+    return fromString(address.c_str());
+  }
+
+  uint8_t operator[](int index) const {
+    return _address[index];
+  }
+
+  uint8_t& operator[](int index) {
+    return _address[index];
+  }
+
+  String toString() const;
+
+private:
+
+  uint8_t _address[4] = { 0 };
+};
+
+#endif // ifndef IPADDRESS_H
@@ -0,0 +1,23 @@
+#ifndef PLUGIN_HELPER_H
+#define PLUGIN_HELPER_H
+
+// Host replacement of _Plugin_Helper.h for the rules benchmark.
+
+#include "ESPEasy_common.h"
+
+#include "src/DataStructs/ESPEasy_EventStruct.h"
+#include "src/DataStructs/TimingStats.h"
+#include "src/ESPEasyCore/ESPEasy_Log.h"
+#include "src/Globals/ExtraTaskSettings.h"
+#include "src/Globals/RuntimeData.h"
+#include "src/Globals/Plugins.h"
+#include "src/Globals/Settings.h"
+#include "src/Helpers/ESPEasy_math.h"
+#include "src/Helpers/ESPEasy_Storage.h"
+#include "src/Helpers/Misc.h"
+#include "src/Helpers/Numerical.h"
+#include "src/Helpers/StringConverter.h"
+
+int getValueCountForTask(taskIndex_t taskIndex);
+
+#endif // ifndef PLUGIN_HELPER_H
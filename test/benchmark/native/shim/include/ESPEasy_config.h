@@ -0,0 +1,6 @@
+#ifndef ESPEASY_CONFIG_H
+#define ESPEASY_CONFIG_H
+
+// Host replacement, the build configuration is set in ESPEasy_common.h
+
+#endif // ifndef ESPEASY_CONFIG_H
@@ -0,0 +1,189 @@
+// Implementation of the host replacements of the Arduino core and logging.
+
+#include "ESPEasy_common.h"
+#include "IPAddress.h"
+
+#include "src/ESPEasyCore/ESPEasy_Log.h"
+#include "src/Helpers/ESPEasy_time_calc.h"
+
+#include <chrono>
+#include <strings.h>
+#include <thread>
+
+const String EMPTY_STRING;
+const String emptyString;
+
+/*********************************************************************************************\
+* Arduino core
+\*********************************************************************************************/
+static const auto startTime = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+char* dtostrf(double number, signed char width, unsigned char prec, char *s) {
+  sprintf(s, "%*.*f", width, prec, number);
+  return s;
+}
+
+static std::string toBase(unsigned long long value, unsigned char base, bool negative) {
+  if ((base < 2) || (base > 36)) { base = 10; }
+  std::string res;
+
+  do {
+    const int digit = value % base;
+    res.insert(res.begin(), static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10));
+    value /= base;
+  } while (value != 0);
+
+  if (negative) { res.insert(res.begin(), '-'); }
+  return res;
+}
+
+String::String(int value, unsigned char base) : String(static_cast<long>(value), base) {}
+
+String::String(unsigned int value, unsigned char base) : String(static_cast<unsigned long>(value), base) {}
+
+String::String(long value, unsigned char base)
+  : _s((base == 10 && value < 0)
+       ? toBase(-static_cast<unsigned long long>(value), base, true)
+       : toBase(static_cast<unsigned long>(value), base, false)) {}
+
+String::String(unsigned long value, unsigned char base) : _s(toBase(value, base, false)) {}
+
+String::String(float value, unsigned char decimalPlaces) : String(static_cast<double>(value), decimalPlaces) {}
+
+String::String(double value, unsigned char decimalPlaces) {
+  char buf[64];
+
+  snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+  _s = buf;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+  return _s.length() == s._s.length() && strcasecmp(_s.c_str(), s._s.c_str()) == 0;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+  return offset <= _s.length() && _s.compare(offset, prefix._s.length(), prefix._s) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+  return _s.length() >= suffix._s.length() &&
+         _s.compare(_s.length() - suffix._s.length(), suffix._s.length(), suffix._s) == 0;
+}
+
+static int toIndex(size_t pos) {
+  return pos == std::string::npos ? -1 : static_cast<int>(pos);
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+  return toIndex(_s.find(ch, fromIndex));
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+  return toIndex(_s.find(str._s, fromIndex));
+}
+
+int String::lastIndexOf(char ch) const {
+  return toIndex(_s.rfind(ch));
+}
+
+int String::lastIndexOf(const String& str) const {
+  return toIndex(_s.rfind(str._s));
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+  if (beginIndex > endIndex) { std::swap(beginIndex, endIndex); }
+
+  if (beginIndex >= _s.length()) { return String(); }
+
+  if (endIndex > _s.length()) { endIndex = _s.length(); }
+  return String(_s.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::replace(char find, char replace) {
+  std::replace(_s.begin(), _s.end(), find, replace);
+}
+
+void String::replace(const String& find, const String& replace) {
+  if (find._s.empty()) { return; }
+  size_t pos = 0;
+
+  while ((pos = _s.find(find._s, pos)) != std::string::npos) {
+    _s.replace(pos, find._s.length(), replace._s);
+    pos += replace._s.length();
+  }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index < _s.length()) { _s.erase(index, count); }
+}
+
+void String::toLowerCase() {
+  for (auto& c : _s) { c = tolower(c); }
+}
+
+void String::toUpperCase() {
+  for (auto& c : _s) { c = toupper(c); }
+}
+
+void String::trim() {
+  const size_t first = _s.find_first_not_of(" \t\r\n");
+
+  if (first == std::string::npos) {
+    _s.clear();
+    return;
+  }
+  _s = _s.substr(first, _s.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+bool IPAddress::fromString(const char *address) {
+  unsigned int parts[4];
+  char tail;
+
+  if ((sscanf(address, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &tail) != 4) ||
+      (parts[0] > 255) || (parts[1] > 255) || (parts[2] > 255) || (parts[3] > 255)) {
+    return false;
+  }
+
+  for (int i = 0; i < 4; ++i) { _address[i] = parts[i]; }
+  return true;
+}
+
+String IPAddress::toString() const {
+  char str[16];
+
+  snprintf(str, sizeof(str), "%u.%u.%u.%u", _address[0], _address[1], _address[2], _address[3]);
+  return String(str);
+}
+
+/*********************************************************************************************\
+* Firmware helpers
+\*********************************************************************************************/
+uint32_t nrLoggedErrors = 0;
+
+bool loglevelActiveFor(uint8_t logLevel) {
+  return logLevel <= LOG_LEVEL_ERROR;
+}
+
+void addLog(uint8_t logLevel, const __FlashStringHelper *str) {
+  if (logLevel == LOG_LEVEL_ERROR) { ++nrLoggedErrors; }
+}
+
+void addLog(uint8_t logLevel, const String& string) {
+  if (logLevel == LOG_LEVEL_ERROR) { ++nrLoggedErrors; }
+}
+
+void addToLogMove(uint8_t logLevel, String&& string) {
+  if (logLevel == LOG_LEVEL_ERROR) { ++nrLoggedErrors; }
+}
@@ -0,0 +1,161 @@
+// Host replacements of the firmware state used by the rules engine, see rules_benchmark.cpp.
+
+#include "_Plugin_Helper.h"
+
+#include "src/DataTypes/ESPEasyFileType.h"
+#include "src/Globals/Cache.h"
+#include "src/Globals/Device.h"
+#include "src/Globals/Plugins_other.h"
+#include "src/Helpers/_CPlugin_init.h"
+#include "src/Helpers/ESPEasy_math.h"
+
+#include <limits>
+#include <map>
+
+void (*parseTemplate_CallBack_ptr)(String& tmpString, bool useURLencode) = nullptr;
+void (*substitute_eventvalue_CallBack_ptr)(String& line, const String& event) = nullptr;
+
+/*********************************************************************************************\
+* Math, ESPEasy_math.cpp replaces the libm functions so only these are taken from it
+\*********************************************************************************************/
+int maxNrDecimals_fpType(const double& value)
+{
+  int res       = ESPEASY_DOUBLE_NR_DECIMALS;
+  double factor = 1;
+
+  while ((value / factor) > 10 && res > 2) {
+    factor *= 10.0;
+    --res;
+  }
+  return res;
+}
+
+static constexpr double ESPEASY_DOUBLE_EPSILON = ESPEASY_DOUBLE_EPSILON_FACTOR * std::numeric_limits<double>::epsilon();
+
+bool definitelyGreaterThan(const double& a, const double& b) {
+  return (a - b) > ((std::abs(a) < std::abs(b) ? std::abs(b) : std::abs(a)) * ESPEASY_DOUBLE_EPSILON);
+}
+
+bool definitelyLessThan(const double& a, const double& b) {
+  return (b - a) > ((std::abs(a) < std::abs(b) ? std::abs(b) : std::abs(a)) * ESPEASY_DOUBLE_EPSILON);
+}
+
+bool essentiallyEqual(const double& a, const double& b) {
+  return std::abs(a - b) <= ((std::abs(a) > std::abs(b) ? std::abs(b) : std::abs(a)) * ESPEASY_DOUBLE_EPSILON);
+}
+
+bool essentiallyZero(const double& a) {
+  return essentiallyEqual(a, 0.0);
+}
+
+// Clock events are not used in the benchmark, only compare them as-is.
+unsigned long string2TimeLong(const String& str) {
+  unsigned long hash = 0;
+
+  for (const char c : str) {
+    hash = hash * 31 + tolower(c);
+  }
+  return hash;
+}
+
+bool matchClockEvent(unsigned long clockEvent, unsigned long clockSet) {
+  return clockEvent == clockSet;
+}
+
+/*********************************************************************************************\
+* Settings, tasks and controllers
+* No tasks or controllers are configured, like on a new node with only rules.
+\*********************************************************************************************/
+const taskIndex_t INVALID_TASK_INDEX = TASKS_MAX;
+
+SettingsStruct Settings;
+ExtraTaskSettingsStruct ExtraTaskSettings;
+Caches Cache;
+DeviceStruct Device[1];
+UserVarStruct UserVar;
+
+String LoadTaskSettings(taskIndex_t TaskIndex) {
+  ExtraTaskSettings.TaskIndex = TaskIndex;
+  return EMPTY_STRING;
+}
+
+String getTaskDeviceName(taskIndex_t TaskIndex) {
+  return EMPTY_STRING;
+}
+
+String getTaskValueName(taskIndex_t TaskIndex, uint8_t TaskValueIndex) {
+  return EMPTY_STRING;
+}
+
+int getValueCountForTask(taskIndex_t taskIndex) {
+  return 0;
+}
+
+bool validDeviceIndex(deviceIndex_t index) {
+  return false;
+}
+
+deviceIndex_t getDeviceIndex_from_TaskIndex(taskIndex_t taskIndex) {
+  return 0xFF;
+}
+
+bool PluginCall(uint8_t Function, struct EventStruct *event, String& str) {
+  return false;
+}
+
+bool validProtocolIndex(protocolIndex_t index) {
+  return false;
+}
+
+protocolIndex_t getProtocolIndex_from_ControllerIndex(uint8_t index) {
+  return 0xFF;
+}
+
+ProtocolStruct& getProtocolStruct(protocolIndex_t protocolIndex) {
+  static ProtocolStruct protocol;
+
+  return protocol;
+}
+
+/*********************************************************************************************\
+* File system
+\*********************************************************************************************/
+String getRulesFileName(unsigned int filenr) {
+  String result;
+
+  if (filenr < RULESETS_MAX) {
+    result += F("rules");
+    result += filenr + 1;
+    result += F(".txt");
+  }
+  return result;
+}
+
+static std::map<String, std::shared_ptr<const std::string> > files;
+
+void fs::addFile(const String& fname, std::string&& content) {
+  files[fname] = std::make_shared<const std::string>(std::move(content));
+}
+
+size_t fs::File::read(uint8_t *buffer, size_t length) {
+  const size_t nrBytes = std::min(length, size() - _pos);
+
+  if (nrBytes > 0) {
+    memcpy(buffer, _data->data() + _pos, nrBytes);
+    _pos += nrBytes;
+  }
+  return nrBytes;
+}
+
+bool fileExists(const String& fname) {
+  return files.find(fname) != files.end();
+}
+
+fs::File tryOpenFile(const String& fname, const String& mode) {
+  auto it = files.find(fname);
+
+  if (it == files.end()) {
+    return fs::File();
+  }
+  return fs::File(it->second);
+}
@@ -0,0 +1,9 @@
+#ifndef COMMANDS_GPIO_H
+#define COMMANDS_GPIO_H
+
+#include "../../ESPEasy_common.h"
+
+// Implemented by the benchmark
+bool getGPIOPinStateValues(String& str);
+
+#endif // ifndef COMMANDS_GPIO_H
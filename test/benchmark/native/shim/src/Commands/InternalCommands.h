@@ -0,0 +1,12 @@
+#ifndef COMMANDS_INTERNALCOMMANDS_H
+#define COMMANDS_INTERNALCOMMANDS_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/EventValueSource.h"
+
+// Implemented by the benchmark, which simulates the commands used in the benchmark rules.
+bool ExecuteCommand_all(EventValueSource::Enum source,
+                        const char            *Line);
+
+#endif // ifndef COMMANDS_INTERNALCOMMANDS_H
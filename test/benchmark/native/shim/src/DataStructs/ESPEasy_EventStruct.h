@@ -0,0 +1,31 @@
+#ifndef DATASTRUCTS_ESPEASY_EVENTSTRUCT_H
+#define DATASTRUCTS_ESPEASY_EVENTSTRUCT_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/SensorVType.h"
+#include "../DataTypes/TaskIndex.h"
+
+struct EventStruct {
+  EventStruct() = default;
+  explicit EventStruct(taskIndex_t taskIndex) : TaskIndex(taskIndex) {}
+
+  Sensor_VType getSensorType() const {
+    return Sensor_VType::SENSOR_TYPE_SINGLE;
+  }
+
+  void deep_copy(const struct EventStruct *other) {
+    *this = *other;
+  }
+
+  String      String2;
+  taskIndex_t TaskIndex = INVALID_TASK_INDEX;
+  int         idx       = 0;
+  int         Par1      = 0;
+  int         Par2      = 0;
+  int         Par3      = 0;
+  int         Par4      = 0;
+  int         Par5      = 0;
+};
+
+#endif // ifndef DATASTRUCTS_ESPEASY_EVENTSTRUCT_H
@@ -0,0 +1,10 @@
+#ifndef DATASTRUCTS_TIMINGSTATS_H
+#define DATASTRUCTS_TIMINGSTATS_H
+
+#include "../ESPEasyCore/ESPEasy_Log.h"
+
+// Timing stats are measured by the benchmark itself.
+#define START_TIMER ;
+#define STOP_TIMER(L) ;
+
+#endif // ifndef DATASTRUCTS_TIMINGSTATS_H
@@ -0,0 +1,9 @@
+#ifndef DATATYPES_ESPEASYFILETYPE_H
+#define DATATYPES_ESPEASYFILETYPE_H
+
+#include "../../ESPEasy_common.h"
+
+// filenr = 0...3 for files rules1.txt ... rules4.txt
+String getRulesFileName(unsigned int filenr);
+
+#endif // ifndef DATATYPES_ESPEASYFILETYPE_H
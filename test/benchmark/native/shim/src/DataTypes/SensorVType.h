@@ -0,0 +1,13 @@
+#ifndef DATATYPES_SENSORVTYPE_H
+#define DATATYPES_SENSORVTYPE_H
+
+#include "../../ESPEasy_common.h"
+
+enum class Sensor_VType : uint8_t {
+  SENSOR_TYPE_NONE   = 0,
+  SENSOR_TYPE_SINGLE = 1,
+  SENSOR_TYPE_ULONG  = 20,
+  SENSOR_TYPE_STRING = 22
+};
+
+#endif // ifndef DATATYPES_SENSORVTYPE_H
@@ -0,0 +1,12 @@
+#ifndef DATATYPES_TASKINDEX_H
+#define DATATYPES_TASKINDEX_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../CustomBuild/ESPEasyLimits.h"
+
+typedef uint8_t taskIndex_t;
+
+extern const taskIndex_t INVALID_TASK_INDEX;
+
+#endif // ifndef DATATYPES_TASKINDEX_H
@@ -0,0 +1,17 @@
+#ifndef ESPEASYCORE_ESPEASY_LOG_H
+#define ESPEASYCORE_ESPEASY_LOG_H
+
+#include "../../ESPEasy_common.h"
+
+// Logging is disabled, only errors are counted.
+bool loglevelActiveFor(uint8_t logLevel);
+void addLog(uint8_t                    logLevel,
+            const __FlashStringHelper *str);
+void addLog(uint8_t       logLevel,
+            const String& string);
+void addToLogMove(uint8_t  logLevel,
+                  String&& string);
+
+#define addLogMove(L, S)  addToLogMove(L, std::move(S))
+
+#endif // ifndef ESPEASYCORE_ESPEASY_LOG_H
@@ -0,0 +1,8 @@
+#ifndef ESPEASYCORE_ESPEASY_BACKGROUNDTASKS_H
+#define ESPEASYCORE_ESPEASY_BACKGROUNDTASKS_H
+
+#include "../../ESPEasy_common.h"
+
+inline void backgroundtasks() {}
+
+#endif // ifndef ESPEASYCORE_ESPEASY_BACKGROUNDTASKS_H
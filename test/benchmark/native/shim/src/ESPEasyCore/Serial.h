@@ -0,0 +1,7 @@
+#ifndef ESPEASYCORE_SERIAL_H
+#define ESPEASYCORE_SERIAL_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef ESPEASYCORE_SERIAL_H
@@ -0,0 +1,12 @@
+#ifndef GLOBALS_CPLUGINS_H
+#define GLOBALS_CPLUGINS_H
+
+// Host replacement of CPlugins.h for the rules benchmark, no controllers are configured.
+
+#include "../../ESPEasy_common.h"
+
+typedef uint8_t cpluginID_t;
+
+#define validCPluginID(X) (((X) != 0) && ((X) != 255))
+
+#endif // ifndef GLOBALS_CPLUGINS_H
@@ -0,0 +1,7 @@
+#ifndef GLOBALS_CRCVALUES_H
+#define GLOBALS_CRCVALUES_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef GLOBALS_CRCVALUES_H
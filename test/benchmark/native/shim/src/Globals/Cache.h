@@ -0,0 +1,24 @@
+#ifndef GLOBALS_CACHE_H
+#define GLOBALS_CACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+#include "../Helpers/RulesHelper.h"
+
+#include <map>
+
+// Only the caches used by the rules engine.
+struct Caches {
+  std::map<String, taskIndex_t>taskIndexName;
+  std::map<String, uint8_t>    taskIndexValueName;
+  RulesHelperClass             rulesHelper;
+
+  uint8_t getTaskDeviceValueDecimals(taskIndex_t, uint8_t) const {
+    return 0;
+  }
+};
+
+extern Caches Cache;
+
+#endif // ifndef GLOBALS_CACHE_H
@@ -0,0 +1,16 @@
+#ifndef GLOBALS_DEVICE_H
+#define GLOBALS_DEVICE_H
+
+#include "../Globals/Plugins.h"
+
+// No devices are configured in the benchmark.
+struct DeviceStruct {
+  bool configurableDecimals() const {
+    return false;
+  }
+};
+
+extern DeviceStruct Device[1];
+
+
+#endif // ifndef GLOBALS_DEVICE_H
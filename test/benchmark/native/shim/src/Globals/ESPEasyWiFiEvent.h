@@ -0,0 +1,7 @@
+#ifndef GLOBALS_ESPEASYWIFIEVENT_H
+#define GLOBALS_ESPEASYWIFIEVENT_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef GLOBALS_ESPEASYWIFIEVENT_H
@@ -0,0 +1,7 @@
+#ifndef GLOBALS_ESPEASY_TIME_H
+#define GLOBALS_ESPEASY_TIME_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef GLOBALS_ESPEASY_TIME_H
@@ -0,0 +1,14 @@
+#ifndef GLOBALS_EXTRATASKSETTINGS_H
+#define GLOBALS_EXTRATASKSETTINGS_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+struct ExtraTaskSettingsStruct {
+  taskIndex_t TaskIndex = INVALID_TASK_INDEX;
+};
+
+extern ExtraTaskSettingsStruct ExtraTaskSettings;
+
+#endif // ifndef GLOBALS_EXTRATASKSETTINGS_H
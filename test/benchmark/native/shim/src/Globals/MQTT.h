@@ -0,0 +1,7 @@
+#ifndef GLOBALS_MQTT_H
+#define GLOBALS_MQTT_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef GLOBALS_MQTT_H
@@ -0,0 +1,24 @@
+#ifndef GLOBALS_PLUGINS_H
+#define GLOBALS_PLUGINS_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/PluginID.h"
+#include "../DataTypes/TaskIndex.h"
+
+// No tasks are configured in the benchmark.
+typedef uint8_t deviceIndex_t;
+
+#define validTaskIndex(X) ((X) < (TASKS_MAX))
+
+bool          validDeviceIndex(deviceIndex_t index);
+deviceIndex_t getDeviceIndex_from_TaskIndex(taskIndex_t taskIndex);
+
+#define PLUGIN_GET_CONFIG_VALUE 32
+#define PLUGIN_FORMAT_USERVAR   38
+
+bool PluginCall(uint8_t             Function,
+                struct EventStruct *event,
+                String            & str);
+
+#endif // ifndef GLOBALS_PLUGINS_H
@@ -0,0 +1,9 @@
+#ifndef GLOBALS_PLUGINS_OTHER_H
+#define GLOBALS_PLUGINS_OTHER_H
+
+#include "../../ESPEasy_common.h"
+
+extern void (*parseTemplate_CallBack_ptr)(String& tmpString, bool useURLencode);
+extern void (*substitute_eventvalue_CallBack_ptr)(String& line, const String& event);
+
+#endif // ifndef GLOBALS_PLUGINS_OTHER_H
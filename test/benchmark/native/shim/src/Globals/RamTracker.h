@@ -0,0 +1,6 @@
+#ifndef GLOBALS_RAMTRACKER_H
+#define GLOBALS_RAMTRACKER_H
+
+#include "../../ESPEasy_common.h"
+
+#endif // ifndef GLOBALS_RAMTRACKER_H
@@ -0,0 +1,27 @@
+#ifndef GLOBALS_RUNTIMEDATA_H
+#define GLOBALS_RUNTIMEDATA_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/SensorVType.h"
+#include "../DataTypes/TaskIndex.h"
+
+// No tasks are configured in the benchmark, so there are no task values.
+struct UserVarStruct {
+  String getAsString(taskIndex_t, uint8_t, Sensor_VType, uint8_t = 0) const {
+    return EMPTY_STRING;
+  }
+
+  bool isValid(taskIndex_t, uint8_t, Sensor_VType) const {
+    return false;
+  }
+};
+
+extern UserVarStruct UserVar;
+
+// Implemented by the benchmark
+ESPEASY_RULES_FLOAT_TYPE getCustomFloatVar(uint32_t index);
+void                     setCustomFloatVar(uint32_t                 index,
+                                           const ESPEASY_RULES_FLOAT_TYPE& value);
+
+#endif // ifndef GLOBALS_RUNTIMEDATA_H
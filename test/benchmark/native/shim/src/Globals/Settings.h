@@ -0,0 +1,46 @@
+#ifndef GLOBALS_SETTINGS_H
+#define GLOBALS_SETTINGS_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+// Only the settings used by the rules engine, set to the defaults of a new node with rules enabled.
+struct SettingsStruct {
+  bool OldRulesEngine() const {
+    return true;
+  }
+
+  bool EnableRulesCaching() const {
+    return _enableRulesCaching;
+  }
+
+  bool EnableRulesEventReorder() const {
+    return true;
+  }
+
+  bool CombineTaskValues_SingleEvent(taskIndex_t) const {
+    return false;
+  }
+
+  bool JSONBoolWithoutQuotes() const {
+    return false;
+  }
+
+  bool TolerantLastArgParse() const {
+    return false;
+  }
+
+  bool          UseRules                                = true;
+  bool          _enableRulesCaching                     = true;
+  uint8_t       Protocol[CONTROLLER_MAX]                = { 0 };
+  bool          ControllerEnabled[CONTROLLER_MAX]       = { 0 };
+  unsigned long TaskDeviceTimer[TASKS_MAX]              = { 0 };
+  bool          TaskDeviceEnabled[TASKS_MAX]            = { 0 };
+  unsigned int  TaskDeviceID[CONTROLLER_MAX][TASKS_MAX] = {};
+  bool          TaskDeviceSendData[CONTROLLER_MAX][TASKS_MAX] = {};
+};
+
+extern SettingsStruct Settings;
+
+#endif // ifndef GLOBALS_SETTINGS_H
@@ -0,0 +1,17 @@
+#ifndef HELPERS_ESPEASY_STORAGE_H
+#define HELPERS_ESPEASY_STORAGE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/ESPEasyFileType.h"
+#include "../DataTypes/TaskIndex.h"
+
+#include <FS.h>
+
+bool     fileExists(const String& fname);
+fs::File tryOpenFile(const String& fname,
+                     const String& mode);
+
+String   LoadTaskSettings(taskIndex_t TaskIndex);
+
+#endif // ifndef HELPERS_ESPEASY_STORAGE_H
@@ -0,0 +1,34 @@
+#ifndef HELPERS_ESPEASY_TIME_CALC_H
+#define HELPERS_ESPEASY_TIME_CALC_H
+
+#include "../../ESPEasy_common.h"
+
+inline uint64_t getMicros64() {
+  return micros();
+}
+
+inline int32_t timeDiff(const unsigned long prev, const unsigned long next) {
+  return ((int32_t)(next - prev));
+}
+
+inline int64_t timeDiff64(uint64_t prev, uint64_t next) {
+  return ((int64_t)(next - prev));
+}
+
+inline long timePassedSince(const uint32_t& timestamp) {
+  return timeDiff(timestamp, millis());
+}
+
+inline int64_t usecPassedSince(const uint64_t& timestamp) {
+  return timeDiff64(timestamp, getMicros64());
+}
+
+inline bool timeOutReached(unsigned long timer) {
+  return timePassedSince(timer) >= 0;
+}
+
+unsigned long string2TimeLong(const String& str);
+bool          matchClockEvent(unsigned long clockEvent,
+                              unsigned long clockSet);
+
+#endif // ifndef HELPERS_ESPEASY_TIME_CALC_H
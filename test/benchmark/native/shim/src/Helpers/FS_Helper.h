@@ -0,0 +1,7 @@
+#ifndef HELPERS_FS_HELPER_H
+#define HELPERS_FS_HELPER_H
+
+#include <FS.h>
+
+
+#endif // ifndef HELPERS_FS_HELPER_H
@@ -0,0 +1,7 @@
+#ifndef HELPERS_NETWORKING_H
+#define HELPERS_NETWORKING_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef HELPERS_NETWORKING_H
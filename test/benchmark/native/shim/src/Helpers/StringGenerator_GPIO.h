@@ -0,0 +1,7 @@
+#ifndef HELPERS_STRINGGENERATOR_GPIO_H
+#define HELPERS_STRINGGENERATOR_GPIO_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef HELPERS_STRINGGENERATOR_GPIO_H
@@ -0,0 +1,7 @@
+#ifndef HELPERS_STRINGPROVIDER_H
+#define HELPERS_STRINGPROVIDER_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef HELPERS_STRINGPROVIDER_H
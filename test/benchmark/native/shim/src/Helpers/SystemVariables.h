@@ -0,0 +1,14 @@
+#ifndef HELPERS_SYSTEMVARIABLES_H
+#define HELPERS_SYSTEMVARIABLES_H
+
+#include "../../ESPEasy_common.h"
+
+class SystemVariables {
+public:
+
+  // Implemented by the benchmark
+  static void parseSystemVariables(String& s,
+                                   bool    useURLencode);
+};
+
+#endif // ifndef HELPERS_SYSTEMVARIABLES_H
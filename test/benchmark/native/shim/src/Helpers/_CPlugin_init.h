@@ -0,0 +1,16 @@
+#ifndef HELPERS__CPLUGIN_INIT_H
+#define HELPERS__CPLUGIN_INIT_H
+
+#include "../../ESPEasy_common.h"
+
+typedef uint8_t protocolIndex_t;
+
+struct ProtocolStruct {
+  bool usesID = false;
+};
+
+bool            validProtocolIndex(protocolIndex_t index);
+protocolIndex_t getProtocolIndex_from_ControllerIndex(uint8_t index);
+ProtocolStruct& getProtocolStruct(protocolIndex_t protocolIndex);
+
+#endif // ifndef HELPERS__CPLUGIN_INIT_H
@@ -0,0 +1,7 @@
+#ifndef HELPERS__PLUGIN_SENSORTYPEHELPER_H
+#define HELPERS__PLUGIN_SENSORTYPEHELPER_H
+
+#include "../../ESPEasy_common.h"
+
+
+#endif // ifndef HELPERS__PLUGIN_SENSORTYPEHELPER_H